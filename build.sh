@@ -16,6 +16,8 @@
 # ./build.sh --gcc
 # For release build with gcc
 # ./build.sh --gcc --release
+# For build with the frame profiler compiled in
+# ./build.sh --profiler
 
 CMAKE_C_COMPILER=clang
 CMAKE_CXX_COMPILER=clang++
@@ -26,6 +28,7 @@ SAN_MEMUB=OFF
 SAN_THREAD=OFF
 BUILD_DIR=build
 USE_NINJA=OFF
+ENABLE_PROFILER=OFF
 
 for arg in "$@"; do
   case "$arg" in
@@ -51,6 +54,9 @@ for arg in "$@"; do
     --release)
       BUILD_TYPE=Release
       ;;
+    --profiler)
+      ENABLE_PROFILER=ON
+      ;;
     *)
       echo "Unknown option: $arg"
       exit 1
@@ -89,7 +95,8 @@ cmake -S . -B "$BUILD_DIR" \
   -DUSE_LIBCXX="$USE_LIBCXX" \
   -DENABLE_SANITIZERS_ADDUB="$SAN_ADDUB" \
   -DENABLE_SANITIZERS_MEMUB="$SAN_MEMUB" \
-  -DENABLE_SANITIZERS_THREAD="$SAN_THREAD"
+  -DENABLE_SANITIZERS_THREAD="$SAN_THREAD" \
+  -DRIPSAW_ENGINE_ENABLE_PROFILER="$ENABLE_PROFILER"
 
 if [[ "$USE_NINJA" == "ON" ]]; then
   ninja -C "$BUILD_DIR"
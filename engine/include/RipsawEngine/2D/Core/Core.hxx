@@ -2,7 +2,14 @@
 #define D2_CORE_CORE_HXX
 
 #include "Engine.hxx"
+#include "FrameArena.hxx"
 #include "Game.hxx"
+#include "HandleTable.hxx"
+#include "JobSystem.hxx"
+#include "PipelineThread.hxx"
+#include "Pool.hxx"
+#include "Profiler.hxx"
+#include "Simd.hxx"
 #include "Timer.hxx"
 
 #endif
@@ -1,7 +1,26 @@
 #ifndef D2_CORE_ENGINE_HXX
 #define D2_CORE_ENGINE_HXX
 
+#include "RipsawEngine/2D/Core/FrameArena.hxx"
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+#include "RipsawEngine/2D/Core/JobSystem.hxx"
+#include "RipsawEngine/2D/Core/PipelineThread.hxx"
+#include "RipsawEngine/2D/Core/Pool.hxx"
 #include "RipsawEngine/2D/Core/Timer.hxx"
+#include "RipsawEngine/2D/Render/SpriteBatch.hxx"
+#include "RipsawEngine/2D/Render/AssetLoader.hxx"
+#include "RipsawEngine/2D/Render/Camera.hxx"
+#include "RipsawEngine/2D/Render/RenderPacket.hxx"
+#include "RipsawEngine/2D/Render/RenderQueue.hxx"
+#include "RipsawEngine/2D/Render/TextureCache.hxx"
+#include "RipsawEngine/2D/Scene/ArchetypeStore.hxx"
+#include "RipsawEngine/2D/Scene/CommandBuffer.hxx"
+#include "RipsawEngine/2D/Systems/AnimationSystem.hxx"
+#include "RipsawEngine/2D/Systems/ParticleSystem.hxx"
+#include "RipsawEngine/2D/Systems/SpatialHash.hxx"
+#include "RipsawEngine/2D/Systems/SystemScheduler.hxx"
+#include "RipsawEngine/2D/Systems/TilemapSystem.hxx"
+#include "RipsawEngine/2D/Systems/TransformSystem.hxx"
 
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
@@ -9,6 +28,9 @@
 #include <glm/glm.hpp>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -18,6 +40,37 @@
 namespace RipsawEngine
 {
 
+/// Rendering counters of the last rendered frame.
+struct RenderStats
+{
+  /// Number of geometry submissions.
+  std::size_t drawCalls{};
+  /// Number of sprites drawn.
+  std::size_t sprites{};
+  /// Number of sprites skipped because they lie outside the view, summed over cameras.
+  std::size_t culled{};
+  /// Number of particles drawn.
+  std::size_t particles{};
+  /// Number of tiles drawn.
+  std::size_t tiles{};
+};
+
+/// Occupancy of the pools actors and built-in components are allocated from.
+struct PoolUsage
+{
+  /// Pool of @ref Actor.
+  PoolStats actors{};
+  /// Pool of @ref TransformComponent.
+  PoolStats transforms{};
+  /// Pool of @ref SpriteComponent.
+  PoolStats sprites{};
+  /// Pool of @ref SpritesheetComponent.
+  PoolStats spritesheets{};
+};
+
+/// Generational handle of an actor. Stays safe to use after the actor is destroyed.
+using ActorHandle = Handle;
+
 /// Variant type for all possible manager classes.
 using AnyManager = std::variant<
   class BGManager*
@@ -25,6 +78,10 @@ using AnyManager = std::variant<
 
 class Engine
 {
+public:
+  /// File profiler captures are written to. See @ref Profiler.
+  static constexpr const char* ProfilerTracePath{"ripsaw_trace.json"};
+
 public:
   /// @brief Constructs engine with Game* object, configurable window name and size.
   /// @param game Pointer to @ref Game instance
@@ -47,6 +104,8 @@ public:
   void run();
   /// @brief Frees resources and prepares for program shutdown.
   void shutdown();
+  /// Makes run() return after the current frame.
+  void quit();
   /// Pauses engine by pausing the timer.
   /// @details Every actor updates as a function of dt. When timer is paused, dt becomes 0 and all actor freeze.
   void pauseEngine();
@@ -64,17 +123,148 @@ public:
   /// @param vsync Boolean vsync value.
   void setVsync(bool vsync);
   /// Sets renderer backend mRendererBackend of engine. Defaults to opengl.
-  /// @details Current valid values are: opengl, vulkan, software.
+  /// @details Current valid values are: opengl, vulkan, software. Must be called before init(). If the requested backend can't be created, SDL's default renderer is used instead.
   /// @param backend Renderer backend.
   void setRendererBackend(const std::string& backend = "opengl");
+  /// Runs engine without a visible window, e.g. for benchmarks and CI.
+  /// @details Must be called before init(). Uses SDL's offscreen video driver, the software renderer, and a plain window of the size given to the constructor (1280 X 720 if none) instead of going fullscreen.
+  /// @param headless Boolean flag to run headless.
+  void setHeadless(bool headless);
+  /// Returns camera.
+  /// @details Engine starts with one camera, the main camera, covering the whole screen and centered on it by init(), so world coordinates equal screen pixels until it moves. Every camera draws every sprite into its own viewport; add cameras for split-screen. Out of range indices log an error and return the main camera.
+  /// @param index Index of camera, 0 for the main camera.
+  /// @warning References are invalidated by addCamera() and removeCamera().
+  Camera& getCamera(std::size_t index = 0);
+  /// Adds camera drawing into viewport, centered like the main camera.
+  /// @param viewport Viewport as fractions of screen size.
+  /// @return Index of the new camera.
+  std::size_t addCamera(const SDL_FRect& viewport);
+  /// Removes camera. The main camera can't be removed.
+  /// @param index Index of camera.
+  void removeCamera(std::size_t index);
+  /// Returns number of cameras.
+  std::size_t getCameraCount() const;
+  /// Enables or disables skipping sprites that lie outside the view. Enabled by default.
+  /// @details Culling only skips batching and drawing; spritesheet animations keep playing off screen unless AnimationSystem::setCulling() is enabled too. Bounds account for scale and rotation.
+  /// @param culling Boolean flag to cull sprites.
+  void setViewportCulling(bool culling);
+  /// Switches between variable and fixed timestep simulation.
+  /// @details With a variable timestep, the world is updated once per rendered frame with that frame's dt, clamped to 1/60 s. With a fixed timestep, frame time is accumulated and the world is updated in ticks of exactly 1/tickRate seconds, as many as fit, so simulation results don't depend on frame rate. At most maxSubsteps ticks run per frame; time beyond that is dropped and the game slows down instead of falling further and further behind. Sprites are drawn at positions interpolated between the last two ticks, so rendering faster than the tick rate still looks smooth.
+  /// @param enabled Boolean flag to run at a fixed timestep.
+  /// @param tickRate Ticks per second.
+  /// @param maxSubsteps Maximum number of ticks per rendered frame.
+  void setFixedTimestep(bool enabled, double tickRate = 60.0, int maxSubsteps = 5);
+  /// Returns True if simulation runs at a fixed timestep.
+  bool isFixedTimestep() const;
+  /// Enables or disables updating actors in parallel. Disabled by default.
+  /// @details When enabled, actors are split into chunks updated concurrently on the job system. Component::update() may then only change components of its own actor, and must record creating or destroying actors and adding components into getCommandBuffer(). destroyActor() does that by itself while actors are being updated; createActor() refuses and returns nullptr.
+  /// @param parallel Boolean flag to update actors in parallel.
+  void setParallelUpdate(bool parallel);
+  /// Returns True if actors are updated in parallel.
+  bool isParallelUpdate() const;
+  /// Enables or disables pipelining simulation and rendering. Disabled by default; can be switched while running.
+  /// @details When enabled, each simulation step runs on a simulation thread while the main thread draws the previous step, so a frame costs about the longer of the two instead of their sum, at one frame of extra latency. Rendering stays on the main thread as SDL requires. The whole step counts as updating in parallel: Game::updateGame(), actors, and systems must not call SDL renderer functions, and must record structural changes into getCommandBuffer() as with setParallelUpdate(). Commands and destroyed actors are applied on the main thread at the sync point between steps, before Game::renderGame().
+  /// @param pipelined Boolean flag to pipeline simulation and rendering.
+  void setPipelined(bool pipelined);
+  /// Returns True if simulation and rendering are pipelined.
+  bool isPipelined() const;
+  /// Returns how far the rendered frame is between the previous and the current tick, 1 with a variable timestep.
+  double getInterpolationAlpha() const;
+  /// Returns store grouping actors by their set of typed components.
+  ArchetypeStore& getArchetypes();
+  /// Calls fn(Actor&, Ts&...) for every actor holding components of every type Ts, e.g. `each<TransformComponent, SpriteComponent>(fn)`.
+  /// @details Only actors of matching archetypes are visited, chunk by chunk, so a query over a few actors costs nothing for the rest of the scene. See @ref ArchetypeStore, including what fn must not do.
+  /// @param fn Function called per actor.
+  template <TypedComponent... Ts, typename Fn>
+  void each(Fn&& fn)
+  {
+    mArchetypes.each<Ts...>(std::forward<Fn>(fn));
+  }
+  /// Returns system holding data of every @ref TransformComponent.
+  TransformSystem& getTransformSystem();
+  /// Returns system playing spritesheet animations.
+  /// @details Animation sets are registered here and played by @ref SpritesheetComponent. Every animator advances once per simulation step, right after Game::updateGame(), so triggers fired by actors and the game take effect in the same step.
+  AnimationSystem& getAnimationSystem();
+  /// Returns system simulating the particles of every @ref ParticleEmitterComponent.
+  /// @details Emitters advance once per simulation step, right after animations, so bursts fired by actors and the game show up in the same frame.
+  ParticleSystem& getParticleSystem();
+  /// Returns system holding the tiles of every @ref TilemapComponent.
+  /// @details Chunks changed during a simulation step are rebuilt when the step's frame is extracted, so edits show up in the same frame.
+  TilemapSystem& getTilemapSystem();
+  /// Returns scheduler of systems run every simulation step, after actors are updated and before Game::updateGame().
+  /// @details See @ref SystemScheduler. Systems sharing a phase run concurrently, with the same rules as parallel actor update, see setParallelUpdate().
+  SystemScheduler& getSystemScheduler();
+  /// Returns command buffer of the calling thread.
+  /// @details Every command buffer is applied at the sync point at the end of each simulation step, after Game::updateGame() and before destroyed actors are flushed. Commands of different threads are applied in thread order, so their relative order isn't tied to actor or system order.
+  /// @warning Must be called from the main thread, the simulation thread, or a job system thread.
+  CommandBuffer& getCommandBuffer();
+  /// Returns spatial index of every actor given bounds, see Actor::setBounds().
+  /// @details The index is brought up to date after transforms are integrated and again at the end of every simulation step, so queries from actors, the game, and rendering see current positions.
+  SpatialHash& getSpatialHash();
+  /// Returns rendering counters of the last rendered frame.
+  const RenderStats& getRenderStats() const;
+  /// Returns texture cache shared by all sprites.
+  TextureCache& getTextureCache();
+  /// Returns loader decoding images on worker threads.
+  AssetLoader& getAssetLoader();
+  /// Returns job system spreading work over every core, started by init().
+  /// @details Engine uses it for culling and sorting, and games can use it from Game::updateGame() for their own parallel loops.
+  JobSystem& getJobSystem();
+  /// Returns arena for data that lives no longer than the current frame. It is reset at the start of every frame.
+  /// @details Engine allocates from it while rendering, e.g. sprite visibility per camera. Games can use it as well.
+  /// @warning When pipelined, only the main thread may use it, e.g. from Game::renderGame(), since the simulation step runs concurrently with rendering.
+  FrameArena& getFrameArena();
+  /// Returns occupancy of the pools actors and built-in components are allocated from.
+  PoolUsage getPoolUsage() const;
 
 private:
   /// @brief Processes inputs.
   void processInput();
   /// @brief Updates the game world.
   void updateEngine();
+  /// Advances actors, game, and transforms by one step.
+  /// @param dt Delta-time of the step.
+  void simulate(double dt);
   /// @brief Renders game output on screen.
   void renderEngine();
+  /// Runs one frame with simulation and rendering in turn on the main thread.
+  void runFrame();
+  /// Runs one frame drawing the previous simulation step while the simulation thread computes the next one.
+  void runPipelinedFrame();
+  /// Waits for the step running on the simulation thread, applies its structural changes, and makes its packet the one to draw. Does nothing if no step is in flight.
+  void finishSimulation();
+  /// Uploads loaded textures and hands them to sprites. Must run on the main thread.
+  void prepareSprites();
+  /// Animates sprites and managers and copies everything to draw into packet.
+  /// @param packet Packet to fill.
+  void extractRenderPacket(RenderPacket& packet);
+  /// Draws packet and presents it.
+  /// @param packet Packet to draw.
+  /// @return Rendering counters of the drawn frame.
+  RenderStats drawRenderPacket(const RenderPacket& packet);
+  /// Draws particle batch through camera with a single geometry submission, unless it lies outside the view.
+  /// @param packet Packet holding the particles.
+  /// @param batch Particle batch.
+  /// @param camera Camera.
+  /// @return Number of particles drawn.
+  std::size_t drawParticleBatch(const RenderPacket& packet, const ParticleBatch& batch, const Camera& camera);
+  /// Draws tile batch through camera with a single geometry submission, unless it lies outside the view.
+  /// @param packet Packet holding the tile vertices.
+  /// @param batch Tile batch.
+  /// @param camera Camera.
+  /// @return Number of tiles drawn.
+  std::size_t drawTileBatch(const RenderPacket& packet, const TileBatch& batch, const Camera& camera);
+  /// Returns indices of quads laid out as four consecutive vertices each, growing them if needed.
+  /// @param quads Number of quads.
+  const int* getQuadIndices(std::size_t quads);
+  /// @brief Deletes all managers and actors.
+  void destroyScene();
+  /// Destroys every actor queued by destroyActor().
+  void flushDestroyedActors();
+  /// Drops slots of removed sprites from mSprites, keeping draw order of the rest.
+  void compactSprites();
+  /// Applies and clears every command buffer.
+  void applyCommands();
 
 private:
   /// Window name.
@@ -86,7 +276,7 @@ private:
   /// True if screen size has been manually configured.
   bool mIsDisplaySetManually{false};
   /// True if game loop is running.
-  bool mIsRunning{true};
+  std::atomic<bool> mIsRunning{true};
   /// Window pointer.
   SDL_Window* mWindow{nullptr};
   /// Renderer pointer.
@@ -104,27 +294,61 @@ private:
   /// Delta-time clamp value clamped to 60 FPS dt equivalent.
   const double mDtClamp{static_cast<double>(1) / 60};
   bool mVsyncEnabled{true};
+  /// True if engine runs without a visible window.
+  bool mIsHeadless{false};
+  /// True if sprites outside the view are skipped.
+  bool mIsViewportCulling{true};
+  /// True if simulation runs at a fixed timestep.
+  bool mIsFixedTimestep{false};
+  /// Duration of one fixed tick in seconds.
+  double mFixedDt{static_cast<double>(1) / 60};
+  /// Maximum number of fixed ticks per rendered frame.
+  int mMaxSubsteps{5};
+  /// Frame time not yet consumed by fixed ticks.
+  double mAccumulator{};
+  /// Interpolation factor between the previous and the current tick.
+  double mInterpolationAlpha{1};
+  /// True if actors are updated in parallel.
+  bool mIsParallelUpdate{false};
+  /// True while actors or systems run on several threads, or the simulation runs on the simulation thread.
+  bool mIsUpdatingInParallel{false};
+  /// True if simulation and rendering are pipelined.
+  std::atomic<bool> mIsPipelined{false};
+  /// True from kicking the simulation thread until finishSimulation().
+  bool mIsSimulationInFlight{false};
 
 public:
   /// Dynamically allocates actor.
-  /// @details This is a high level virtual member function to create actor. It returns pointer to the allocated actor for custom manipulation. The returned pointer should never be deleted manually as Engine handles the ownership. An actor should only be detroyed using destroyActor() when needed. After destroyActor() is called on an actor, trying to dereference that actor would result in crash as the actor would be nullified. So it's highly recommended to do any operation on the returned Actor pointer by checking if it's nullptr.
-  /// @return Returns pointer to the allocated actor.
+  /// @details This is a high level virtual member function to create actor. It returns pointer to the allocated actor for custom manipulation. The returned pointer should never be deleted manually as Engine handles the ownership. An actor should only be destroyed using destroyActor() when needed. Code that needs to refer to an actor across frames should keep its handle, getHandle(), rather than the pointer, and resolve it with getActor() which returns nullptr once the actor is gone. While actors or systems run in parallel, use CommandBuffer::createActor() instead.
+  /// @return Returns pointer to the allocated actor, nullptr if called while actors or systems run in parallel.
   virtual class Actor* createActor();
-  /// Destroys specified actor by deleting and removing it from mActors, nullifying at the end.
-  /// @details This method removes specified actor from mActors. But if removal occurs while actors are going through the update loop, this might crash the engine. To prevent that, a boolean signal mActorsBeingUpdated is introduced which is set before entering the update loop and unset after exiting the loop. The method first checks if the signal is set. If unset, it destroys the actor right away. But if set, it pushes the actor in another vector mActorsToBeKilled. Then, this method is called again on every actors of mActorsToBeKilled before entering the update loop.
+  /// Queues actor for destruction at the end of the current frame.
+  /// @details Destruction is deferred so that actors can be destroyed from anywhere, including from inside the update loop. Queued actors are destroyed after the game update and before rendering, so they are never drawn again. Destroying an actor twice, or through a stale handle, is harmless. Removal swaps the last actor into the freed place, so destroying N actors is O(N) but the update order of the remaining actors changes.
+  /// @param handle Handle of actor to be destroyed.
+  void destroyActor(ActorHandle handle);
+  /// Queues actor for destruction at the end of the current frame and nullifies the pointer.
   /// @param actor Adress of actor to be destroyed.
   void destroyActor(class Actor** actor);
-  /// Adds actor to @ref mActors.
+  /// Returns actor referred by handle, nullptr if it has been destroyed.
+  /// @param handle Handle of actor.
+  class Actor* getActor(ActorHandle handle) const;
+  /// Returns True if handle refers to a live actor.
+  /// @param handle Handle of actor.
+  bool isActorValid(ActorHandle handle) const;
+  /// Returns number of live actors.
+  std::size_t getActorCount() const;
+  /// Adds actor to @ref mActors and assigns its handle.
   /// @param actor Pointer to @ref Actor instance.
   void addActor(class Actor* actor);
-  /// Removes actor from @ref mActors.
+  /// Removes actor from @ref mActors and deletes it immediately.
+  /// @warning Must not be called while actors are being updated; use destroyActor() there.
   /// @param actor Pointer to @ref Actor instance.
   void removeActor(class Actor* actor);
   /// Adds @ref SpriteComponent to mSprites.
-  /// @details @ref renderEngine() calls draw() method of SpriteComponent which handles drawing on screen. SpriteComponent gets @ref TransformComponent from actor which ties the sprite with the actor. Successful construction of SpriteComponent automatically calls this method so explicit calling is not needed.
+  /// @details @ref renderEngine() queues every visible sprite by its sort key, see SpriteComponent::getSortKey(), and submits them in key order. SpriteComponent gets @ref TransformComponent from actor which ties the sprite with the actor. Successful construction of SpriteComponent automatically calls this method so explicit calling is not needed.
   /// @param sc Sprite component.
   void addSprite(class SpriteComponent* sc);
-  /// Removes @ref SpriteComponent from mSprites.
+  /// Removes @ref SpriteComponent from mSprites in O(1) by clearing its slot. Cleared slots are compacted once per frame.
   /// @param sc Sprite component.
   void removeSprite(class SpriteComponent* sc);
   /// Inserts Actor-SpriteComponent pair into mActorSpritePairs.
@@ -141,16 +365,17 @@ public:
 
 public:
   /// Boolean signal depicting if actors are going through update loop.
+  /// @details Destruction is always deferred now, so this is informational only.
   bool mActorsBeingUpdated{false};
 
 public:
-  /// Moves sprite component associated with first actor below the sprite component associated with second actor in mSprites.
-  /// @details This member function directly manipulates the order of sprite components in mSprites.
+  /// Moves sprite component associated with first actor below the sprite component associated with second actor in draw order.
+  /// @details Puts the first sprite into the layer of the second one, at the next lower depth. This is O(1); nothing is reordered until the render pass sorts. Y-sorted sprites recompute their depth every frame, so the effect doesn't last for them.
   /// @param a1 Actor to be moved.
   /// @param a2 Actor below which a1 would go to.
   void actorGoesBelow(class Actor* a1, class Actor* a2);
-  /// Moves sprite component associated with first actor above the sprite component associated with second actor in mSprites.
-  /// @details This member function directly manipulates the order of sprite components in mSprites.
+  /// Moves sprite component associated with first actor above the sprite component associated with second actor in draw order.
+  /// @details Puts the first sprite into the layer of the second one, at the next higher depth. This is O(1); nothing is reordered until the render pass sorts. Y-sorted sprites recompute their depth every frame, so the effect doesn't last for them.
   /// @param a1 Actor to be moved.
   /// @param a2 Actor above which a1 would go to.
   void actorGoesAbove(class Actor* a1, class Actor* a2);
@@ -158,18 +383,68 @@ public:
 private:
   /// Extendible Game class.
   class Game* mGame{nullptr};
-  /// List of all actors.
+  /// List of all actors, packed in the dense order of mActorHandles.
   std::vector<class Actor*> mActors{};
-  /// List of actors that are to be killed before next actor update begins.
-  std::vector<class Actor**> mActorsToBeKilled{};
-  /// List of all sprites to be drawn.
+  /// Handles of all actors.
+  HandleTable mActorHandles{};
+  /// Actors to be destroyed at the end of the current frame.
+  std::vector<ActorHandle> mActorsToBeDestroyed{};
+  /// Actors grouped by their set of typed components.
+  ArchetypeStore mArchetypes{};
+  /// List of all sprites, in creation order. Removed sprites leave nullptr until compaction.
   std::vector<class SpriteComponent*> mSprites{};
+  /// True if mSprites has slots of removed sprites.
+  bool mHasSpriteHoles{false};
+  /// Number of sprites in mSprites, not counting removed ones.
+  std::size_t mSpriteCount{};
   /// Total size of all registered actors.
   size_t mTotalActorsSize{};
   /// List of Actor-SpriteComponent pairs associated with each other.
   std::unordered_map<class Actor*, class Component*> mActorSpritePairs{};
   /// List of all managers.
   std::vector<AnyManager> mManagers{};
+  /// Spatial index of actors with bounds. Declared before mTransformSystem, which refers to it.
+  SpatialHash mSpatialHash{};
+  /// Packed data of all transform components.
+  TransformSystem mTransformSystem{};
+  /// Animators of all spritesheet components.
+  AnimationSystem mAnimationSystem{};
+  /// Emitters and particles of all particle emitter components.
+  ParticleSystem mParticleSystem{};
+  /// Tiles and cached chunk geometry of all tilemap components.
+  TilemapSystem mTilemapSystem{};
+  /// Texture cache shared by all sprites.
+  TextureCache mTextureCache{};
+  /// Loader decoding images on worker threads. Declared after mTextureCache so it stops before the cache goes away.
+  AssetLoader mAssetLoader{};
+  /// Worker threads for parallel engine and game work.
+  JobSystem mJobSystem{};
+  /// Command buffer of every job system thread.
+  std::vector<CommandBuffer> mCommandBuffers{1};
+  /// Systems run every simulation step.
+  SystemScheduler mSystemScheduler{};
+  /// Visible sprites of the current camera pass, sorted by key.
+  RenderQueue mRenderQueue{};
+  /// Batches sprite quads into as few draw calls as possible.
+  SpriteBatch mSpriteBatch{};
+  /// Rendering counters of the last rendered frame.
+  RenderStats mRenderStats{};
+  /// Rendering counters of the frame drawn during the step in flight, published by finishSimulation().
+  RenderStats mPendingStats{};
+  /// Packets filled by simulation and drawn by rendering; pipelining draws one while filling the other.
+  std::array<RenderPacket, 2> mRenderPackets{};
+  /// Index of the packet drawn next.
+  std::size_t mFrontPacket{};
+  /// Vertices of the particle or tile batch being drawn, in screen pixels.
+  std::vector<SDL_Vertex> mBatchVertices{};
+  /// Indices of quads, grown to the largest batch drawn and never rewritten.
+  std::vector<int> mQuadIndices{};
+  /// Cameras in drawing order, the main camera first.
+  std::vector<Camera> mCameras{1};
+  /// Linear allocator for transient per-frame data.
+  FrameArena mFrameArena{};
+  /// Thread running simulation steps when pipelined. Declared last so it stops before anything it uses goes away.
+  PipelineThread mSimulationThread{};
 };
 
 }
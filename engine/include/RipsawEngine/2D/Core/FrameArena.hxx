@@ -0,0 +1,71 @@
+#ifndef D2_CORE_FRAMEARENA_HXX
+#define D2_CORE_FRAMEARENA_HXX
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Counters exposed by @ref FrameArena.
+struct FrameArenaStats
+{
+  /// Bytes handed out since the last reset.
+  std::size_t used{};
+  /// Highest number of bytes handed out within one frame.
+  std::size_t peak{};
+  /// Size of the main block in bytes.
+  std::size_t capacity{};
+  /// Allocations since the last reset that didn't fit into the main block.
+  std::size_t overflows{};
+};
+
+class FrameArena
+{
+public:
+  /// Default size of the main block in bytes.
+  static constexpr std::size_t DefaultCapacity{256 * 1024};
+
+public:
+  /// Constructs arena with specified main block size.
+  /// @details Frame arena is a linear allocator for transient data living no longer than one frame. Allocation only bumps an offset, and everything is released at once by reset(), which engine calls at the start of every frame. Nothing allocated here is ever destructed, so only trivially destructible data may live in it. Requests that don't fit are served from separate overflow blocks, and the next reset() grows the main block to the peak usage so overflow stops after a frame or two.
+  /// @param capacity Size of the main block in bytes.
+  explicit FrameArena(std::size_t capacity = DefaultCapacity);
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+  FrameArena(FrameArena&&) = delete;
+  FrameArena& operator=(FrameArena&&) = delete;
+  /// Returns uninitialized storage valid until the next reset().
+  /// @param size Size in bytes.
+  /// @param alignment Alignment in bytes, a power of two.
+  void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+  /// Returns uninitialized array of count objects valid until the next reset().
+  /// @param count Number of objects.
+  template<typename T>
+  T* allocateArray(std::size_t count)
+  {
+    static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+    return static_cast<T*>(this->allocate(sizeof(T) * count, alignof(T)));
+  }
+  /// Releases everything allocated since the last reset.
+  /// @warning Every pointer obtained from the arena becomes dangling.
+  void reset();
+  /// Returns usage counters.
+  const FrameArenaStats& getStats() const;
+
+private:
+  /// Main block.
+  std::unique_ptr<std::byte[]> mBlock{};
+  /// Offset of the next free byte in mBlock.
+  std::size_t mOffset{};
+  /// Blocks allocated for requests that didn't fit into mBlock.
+  std::vector<std::unique_ptr<std::byte[]>> mOverflow{};
+  /// Usage counters.
+  FrameArenaStats mStats{};
+};
+
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef D2_CORE_HANDLETABLE_HXX
+#define D2_CORE_HANDLETABLE_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Generational handle referring to a slot of a @ref HandleTable.
+/// @details A handle stays valid until the object it refers to is released. Releasing bumps the generation of the slot, so a stale handle never resolves to whatever reuses the slot later.
+struct Handle
+{
+  /// Index value of a handle that refers to nothing.
+  static constexpr std::uint32_t InvalidIndex{0xFFFFFFFF};
+  /// Slot index.
+  std::uint32_t index{InvalidIndex};
+  /// Generation of the slot at the time the handle was issued.
+  std::uint32_t generation{};
+  /// Returns True if the handle was never issued.
+  bool isNull() const;
+  bool operator==(const Handle&) const = default;
+};
+
+class HandleTable
+{
+public:
+  /// Result of @ref release() telling the owner of the dense data how to swap-and-pop.
+  struct Removal
+  {
+    /// Dense index that was freed.
+    std::size_t index{};
+    /// Dense index of the element that has to be moved into @ref index. Equal to @ref index if nothing moves.
+    std::size_t last{};
+  };
+
+public:
+  /// Constructs empty handle table.
+  /// @details The handle table is the bookkeeping half of a packed container. It maps stable generational handles to indices of a dense array owned by someone else, and keeps a free list of slots so allocation and release are both O(1). The dense array is always kept packed by swap-and-pop: whenever an element is released, the last element is moved into its place.
+  HandleTable() = default;
+  /// Allocates new slot mapped to dense index @ref size().
+  /// @details Caller must append its element to the dense array right after this call.
+  /// @return Handle to the new slot.
+  Handle allocate();
+  /// Releases slot referred by handle.
+  /// @details Caller must move the element at Removal::last into Removal::index and pop the back of its dense array.
+  /// @param handle Handle to be released.
+  /// @return Swap-and-pop instruction for the dense array.
+  Removal release(Handle handle);
+  /// Returns True if handle refers to a live slot.
+  /// @param handle Handle to be checked.
+  bool isValid(Handle handle) const;
+  /// Returns dense index of live handle.
+  /// @param handle Live handle.
+  std::size_t indexOf(Handle handle) const;
+  /// Returns handle of element at dense index.
+  /// @param index Dense index.
+  Handle handleAt(std::size_t index) const;
+  /// Returns number of live handles.
+  std::size_t size() const;
+  /// Reserves memory for specified number of handles.
+  /// @param capacity Number of handles.
+  void reserve(std::size_t capacity);
+  /// Releases every handle at once.
+  void clear();
+
+private:
+  /// Sparse slot entry.
+  struct Slot
+  {
+    /// Dense index of the element if the slot is live, next free slot otherwise.
+    std::uint32_t dense{Handle::InvalidIndex};
+    /// Current generation of slot.
+    std::uint32_t generation{};
+  };
+
+private:
+  /// Sparse slots addressed by Handle::index.
+  std::vector<Slot> mSlots{};
+  /// Slot index of each dense element.
+  std::vector<std::uint32_t> mDenseToSlot{};
+  /// Head of the intrusive free list threaded through Slot::dense.
+  std::uint32_t mFreeHead{Handle::InvalidIndex};
+};
+
+}
+
+#endif
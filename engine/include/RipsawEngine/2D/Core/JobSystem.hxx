@@ -0,0 +1,147 @@
+#ifndef D2_CORE_JOBSYSTEM_HXX
+#define D2_CORE_JOBSYSTEM_HXX
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Number of unfinished jobs of a group, waited on with JobSystem::wait().
+struct JobCounter
+{
+  /// Jobs queued or running.
+  std::atomic<std::size_t> pending{};
+  /// Returns True once every job of the group has finished.
+  bool isDone() const;
+};
+
+class JobSystem
+{
+public:
+  /// Constructs job system without worker threads. Until start() is called, every job runs on the calling thread.
+  /// @details Job system runs short jobs on a fixed set of worker threads. Every thread taking part, the workers and the thread that called start(), owns a deque of jobs: it pushes and pops its own jobs at the back, so recent and cache-warm work runs first, and when it runs dry it steals the oldest job from the front of another thread's deque. Each deque has its own small lock, so threads only contend while stealing. Threads other than the workers, the one that called start() and those joined with attach(), only steal from workers: a thread waiting for its own jobs never picks up another outside thread's, so e.g. the render thread isn't held up by simulation work. A thread waiting on a @ref JobCounter doesn't block; it keeps running queued jobs until the counter drops to zero, which makes nested jobs and waits inside jobs safe. Idle workers sleep until jobs are queued.
+  JobSystem() = default;
+  /// Destructs job system, stopping worker threads.
+  ~JobSystem();
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+  JobSystem(JobSystem&&) = delete;
+  JobSystem& operator=(JobSystem&&) = delete;
+  /// Starts worker threads. The calling thread joins the job system as well whenever it waits.
+  /// @param workers Number of worker threads, 0 to use every core but the calling thread's.
+  /// @param outside Number of slots for other long-lived threads to join with attach().
+  void start(std::size_t workers = 0, std::size_t outside = 0);
+  /// Joins the calling thread to the job system with a queue and thread index of its own. Threads already taking part are left as they are.
+  /// @return False if every slot reserved by start() is taken.
+  bool attach();
+  /// Finishes queued jobs and stops worker threads.
+  void stop();
+  /// Returns number of threads running jobs: workers, the thread that called start(), and the slots for attached threads.
+  std::size_t getThreadCount() const;
+  /// Returns index of the calling thread in [0, getThreadCount()), 0 for the thread that called start() and for threads neither working nor attached.
+  /// @details Lets jobs pick per-thread data, e.g. a scratch buffer, without locking.
+  std::size_t getThreadIndex() const;
+  /// Queues job.
+  /// @param job Job to be run.
+  /// @param counter Counter of the group the job belongs to.
+  void run(std::function<void()> job, JobCounter& counter);
+  /// Runs queued jobs until every job counted by counter has finished.
+  /// @param counter Counter of the group to wait for.
+  void wait(JobCounter& counter);
+  /// Calls fn(begin, end) on chunks of [0, count) spread over every thread and returns once all chunks are done.
+  /// @details Chunks are queued as jobs without allocating; fn must be safe to call concurrently on disjoint ranges. Ranges of at most one grain run inline.
+  /// @param count Number of indices.
+  /// @param fn Callable taking begin and end index.
+  /// @param grain Minimum number of indices per chunk, 0 to pick one from count and thread count.
+  template<typename Fn>
+  void parallelFor(std::size_t count, Fn&& fn, std::size_t grain = 0)
+  {
+    using Callable = std::remove_reference_t<Fn>;
+    RangeFunction invoke{[](const void* context, std::size_t begin, std::size_t end) {
+        (*static_cast<const Callable*>(context))(begin, end);
+    }};
+    this->dispatchRange(count, grain, invoke, &fn);
+  }
+
+private:
+  /// Calls a range job's callable.
+  using RangeFunction = void (*)(const void* context, std::size_t begin, std::size_t end);
+  /// Queued job: either a task or a range of a parallel loop.
+  struct Job
+  {
+    /// Task, empty for range jobs.
+    std::function<void()> task{};
+    /// Range function, nullptr for tasks.
+    RangeFunction range{nullptr};
+    /// Callable of range job.
+    const void* context{nullptr};
+    /// First index of range.
+    std::size_t begin{};
+    /// One past the last index of range.
+    std::size_t end{};
+    /// Counter of the group the job belongs to.
+    JobCounter* counter{nullptr};
+  };
+  /// Jobs owned by one thread, on its own cache line.
+  struct alignas(64) WorkerQueue
+  {
+    /// Guards jobs.
+    std::mutex mutex{};
+    /// Jobs, newest at the back.
+    std::deque<Job> jobs{};
+  };
+
+private:
+  /// Splits range into chunk jobs, queues them, and waits for them.
+  /// @param count Number of indices.
+  /// @param grain Minimum number of indices per chunk.
+  /// @param invoke Range function.
+  /// @param context Callable of range.
+  void dispatchRange(std::size_t count, std::size_t grain, RangeFunction invoke, const void* context);
+  /// Pops own job or steals one and runs it.
+  /// @return True if a job was run.
+  bool runOne();
+  /// Runs job and counts it as finished.
+  /// @param job Job to be run.
+  void execute(Job& job);
+  /// Wakes sleeping workers after jobs were queued.
+  /// @param jobs Number of jobs queued.
+  void notify(std::size_t jobs);
+  /// Returns True if queue index belongs to a worker thread.
+  /// @param index Queue index.
+  bool isWorker(std::size_t index) const;
+  /// Runs jobs until stopped.
+  /// @param index Queue index of worker.
+  void workerLoop(std::size_t index);
+
+private:
+  /// Queue of every thread, index 0 belonging to the thread that called start().
+  std::vector<std::unique_ptr<WorkerQueue>> mQueues{};
+  /// Worker threads.
+  std::vector<std::thread> mWorkers{};
+  /// Number of worker threads, queues 1 to mWorkerCount.
+  std::size_t mWorkerCount{};
+  /// Queue index handed to the next attached thread.
+  std::atomic<std::size_t> mNextOutside{};
+  /// Jobs queued and not yet taken.
+  std::atomic<std::size_t> mQueued{};
+  /// Guards sleeping and mIsStopping.
+  std::mutex mSleepMutex{};
+  /// Wakes idle workers.
+  std::condition_variable mSleepCondition{};
+  /// True while workers are asked to exit.
+  bool mIsStopping{false};
+};
+
+}
+
+#endif
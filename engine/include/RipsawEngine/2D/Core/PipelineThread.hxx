@@ -0,0 +1,61 @@
+#ifndef D2_CORE_PIPELINETHREAD_HXX
+#define D2_CORE_PIPELINETHREAD_HXX
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace RipsawEngine
+{
+
+class PipelineThread
+{
+public:
+  /// Constructs pipeline thread without a running thread.
+  /// @details Pipeline thread runs one task per frame on its own thread, handed over by the main thread: kick() starts a run and wait() blocks until it has finished. In between, the main thread is free to work on something else, e.g. draw the previous frame while this thread simulates the next one. Handing over through kick() and wait() also orders memory, so data written on either side before the handover is visible on the other side after it.
+  PipelineThread() = default;
+  /// Destructs pipeline thread, waiting for a run in progress and stopping the thread.
+  ~PipelineThread();
+  PipelineThread(const PipelineThread&) = delete;
+  PipelineThread& operator=(const PipelineThread&) = delete;
+  PipelineThread(PipelineThread&&) = delete;
+  PipelineThread& operator=(PipelineThread&&) = delete;
+  /// Starts thread. Does nothing if already running.
+  /// @param name Thread name in profiler traces.
+  /// @param task Task run once per kick().
+  void start(const std::string& name, std::function<void()> task);
+  /// Waits for a run in progress and stops the thread.
+  void stop();
+  /// Returns True while the thread is running.
+  bool isRunning() const;
+  /// Starts one run of the task.
+  /// @warning Must not be called while a run is in progress; wait() first.
+  void kick();
+  /// Blocks until the run started by kick() has finished. Returns immediately if none is in progress.
+  void wait();
+
+private:
+  /// Runs the task whenever kicked, until stopped.
+  /// @param name Thread name in profiler traces.
+  void loop(std::string name);
+
+private:
+  /// Thread running the task.
+  std::thread mThread{};
+  /// Task run once per kick().
+  std::function<void()> mTask{};
+  /// Guards mIsKicked and mIsStopping.
+  std::mutex mMutex{};
+  /// Signals kicks, finished runs, and stopping.
+  std::condition_variable mCondition{};
+  /// True from kick() until the run has finished.
+  bool mIsKicked{false};
+  /// True while the thread is asked to exit.
+  bool mIsStopping{false};
+};
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef D2_CORE_POOL_HXX
+#define D2_CORE_POOL_HXX
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Occupancy counters exposed by @ref Pool.
+struct PoolStats
+{
+  /// Objects currently allocated from the pool.
+  std::size_t live{};
+  /// Highest number of live objects seen.
+  std::size_t peak{};
+  /// Number of objects the allocated slabs can hold.
+  std::size_t capacity{};
+  /// Number of slabs allocated.
+  std::size_t slabs{};
+  /// Allocations of a different size that were forwarded to the global allocator.
+  std::size_t fallbacks{};
+};
+
+template<typename T, std::size_t SlabSize = 256>
+class Pool
+{
+public:
+  static_assert(SlabSize > 0, "Pool slab must hold at least one object");
+
+public:
+  /// Constructs empty pool.
+  /// @details This is a fixed-size object pool. Memory is taken from the system in slabs of SlabSize objects which are never returned until the pool goes away, and freed objects are threaded onto an intrusive free list, so allocation and deallocation are both O(1) and never touch malloc once the pool has warmed up. Objects of one type end up next to each other instead of being scattered over the heap. Requests of any size other than sizeof(T), e.g. from derived classes inheriting a class-specific operator new, are forwarded to the global allocator.
+  Pool() = default;
+  Pool(const Pool&) = delete;
+  Pool& operator=(const Pool&) = delete;
+  Pool(Pool&&) = delete;
+  Pool& operator=(Pool&&) = delete;
+  /// Returns storage for an object of specified size.
+  /// @param size Size of object in bytes.
+  void* allocate(std::size_t size = sizeof(T))
+  {
+    if (size != sizeof(T))
+    {
+      ++mStats.fallbacks;
+      return ::operator new(size);
+    }
+
+    if (mFreeHead == nullptr)
+      this->grow();
+
+    Slot* slot{mFreeHead};
+    mFreeHead = slot->next;
+    if (++mStats.live > mStats.peak)
+      mStats.peak = mStats.live;
+    return slot->storage;
+  }
+  /// Returns storage obtained from allocate() to the pool.
+  /// @param ptr Storage to be returned. nullptr is ignored.
+  /// @param size Size passed to allocate().
+  void deallocate(void* ptr, std::size_t size = sizeof(T))
+  {
+    if (ptr == nullptr)
+      return;
+
+    if (size != sizeof(T))
+    {
+      ::operator delete(ptr);
+      return;
+    }
+
+    Slot* slot{static_cast<Slot*>(ptr)};
+    slot->next = mFreeHead;
+    mFreeHead = slot;
+    --mStats.live;
+  }
+  /// Constructs new object in pooled storage.
+  /// @param args Arguments forwarded to constructor of T.
+  template<typename... Args>
+  T* create(Args&&... args)
+  {
+    void* storage{this->allocate()};
+    try
+    {
+      return ::new (storage) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      this->deallocate(storage);
+      throw;
+    }
+  }
+  /// Destroys object made by create() and returns its storage.
+  /// @param object Object to be destroyed. nullptr is ignored.
+  void destroy(T* object)
+  {
+    if (object == nullptr)
+      return;
+    object->~T();
+    this->deallocate(object);
+  }
+  /// Allocates slabs until specified number of objects fit without further allocation.
+  /// @param capacity Number of objects.
+  void reserve(std::size_t capacity)
+  {
+    while (mStats.capacity - mStats.live < capacity)
+      this->grow();
+  }
+  /// Returns occupancy counters.
+  const PoolStats& getStats() const
+  {
+    return mStats;
+  }
+
+private:
+  /// Storage of one object, or link to the next free slot while unused.
+  union Slot
+  {
+    Slot* next;
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+private:
+  /// Allocates one slab and pushes its slots onto the free list, lowest address first.
+  void grow()
+  {
+    mSlabs.emplace_back(std::make_unique_for_overwrite<Slot[]>(SlabSize));
+    Slot* slab{mSlabs.back().get()};
+    for (std::size_t i{SlabSize}; i > 0; --i)
+    {
+      slab[i - 1].next = mFreeHead;
+      mFreeHead = &slab[i - 1];
+    }
+    mStats.capacity += SlabSize;
+    ++mStats.slabs;
+  }
+
+private:
+  /// All slabs ever allocated.
+  std::vector<std::unique_ptr<Slot[]>> mSlabs{};
+  /// Head of free slot list.
+  Slot* mFreeHead{nullptr};
+  /// Occupancy counters.
+  PoolStats mStats{};
+};
+
+}
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef D2_CORE_PROFILER_HXX
+#define D2_CORE_PROFILER_HXX
+
+#if defined(RIPSAW_ENGINE_PROFILER)
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// One timed zone.
+struct ProfileEvent
+{
+  /// Zone name. Must outlive the profiler, i.e. be a string literal.
+  const char* name{nullptr};
+  /// Start time in nanoseconds since SDL initialization.
+  Uint64 start{};
+  /// End time in nanoseconds since SDL initialization.
+  Uint64 end{};
+};
+
+/// Frame time distribution over the recent frames.
+struct FrameTimeStats
+{
+  /// Number of frames the distribution covers.
+  std::size_t frames{};
+  /// Median frame time in milliseconds.
+  double p50{};
+  /// 95th percentile frame time in milliseconds.
+  double p95{};
+  /// 99th percentile frame time in milliseconds.
+  double p99{};
+  /// Longest frame time in milliseconds.
+  double max{};
+};
+
+class ProfileRing
+{
+public:
+  /// Number of events the ring holds.
+  static constexpr std::size_t Capacity{1 << 14};
+
+public:
+  /// Constructs empty ring.
+  /// @details Single-producer single-consumer ring buffer of events. The owning thread pushes, the main thread drains once per frame, and neither takes a lock. Events pushed while the ring is full are dropped and counted.
+  ProfileRing() = default;
+  /// Appends event. Called only by the owning thread.
+  /// @param event Event to be appended.
+  void push(const ProfileEvent& event);
+  /// Moves every queued event into out. Called only by the draining thread.
+  /// @param out Destination, nullptr to discard events.
+  void drain(std::vector<ProfileEvent>* out);
+  /// Returns number of events dropped because the ring was full.
+  std::size_t getDropped() const;
+
+private:
+  /// Event storage.
+  std::array<ProfileEvent, Capacity> mEvents{};
+  /// Number of events ever pushed.
+  std::atomic<std::size_t> mHead{};
+  /// Number of events ever drained.
+  std::atomic<std::size_t> mTail{};
+  /// Number of events dropped.
+  std::atomic<std::size_t> mDropped{};
+};
+
+class Profiler
+{
+public:
+  /// Number of recent frames frame time percentiles are computed over.
+  static constexpr std::size_t FrameWindow{1024};
+  /// Maximum number of events kept by one capture.
+  static constexpr std::size_t MaxCapturedEvents{1 << 20};
+
+public:
+  /// Returns process-wide profiler.
+  /// @details The profiler collects scoped zones, see @ref RIPSAW_PROFILE_ZONE, into one lock-free ring per thread. Engine calls endFrame() once per frame, which records the frame time and drains every ring; drained events are kept only while a capture is running and can be written as Chrome trace JSON, viewable in chrome://tracing or Perfetto. The whole profiler only exists when the engine is built with RIPSAW_ENGINE_ENABLE_PROFILER; otherwise the macros expand to nothing.
+  static Profiler& get();
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+  Profiler(Profiler&&) = delete;
+  Profiler& operator=(Profiler&&) = delete;
+  /// Records zone of the calling thread.
+  /// @param name Zone name, a string literal.
+  /// @param start Start time in nanoseconds.
+  /// @param end End time in nanoseconds.
+  void record(const char* name, Uint64 start, Uint64 end);
+  /// Names calling thread in traces.
+  /// @param name Thread name.
+  void setThreadName(const std::string& name);
+  /// Marks the end of a frame, recording its duration and draining every thread's ring.
+  /// @warning Must be called from the main thread only.
+  void endFrame();
+  /// Starts keeping events, discarding those of the previous capture.
+  void startCapture();
+  /// Stops keeping events.
+  void stopCapture();
+  /// Returns True while a capture is running.
+  bool isCapturing() const;
+  /// Writes events of the last capture as Chrome trace JSON.
+  /// @param path Path to output file.
+  /// @return True if successful, False otherwise.
+  bool writeChromeTrace(const std::string& path) const;
+  /// Returns frame time distribution over the recent frames.
+  FrameTimeStats getFrameTimeStats() const;
+  /// Returns number of events dropped because a ring or the capture was full.
+  std::size_t getDroppedEvents() const;
+
+private:
+  /// Constructs idle profiler.
+  Profiler() = default;
+  /// Ring of one thread.
+  struct ThreadRing
+  {
+    /// Events of the thread.
+    ProfileRing ring{};
+    /// Thread id in traces.
+    std::uint32_t id{};
+    /// Thread name in traces.
+    std::string name{};
+  };
+  /// Captured event with the thread it came from.
+  struct CapturedEvent
+  {
+    /// Event.
+    ProfileEvent event{};
+    /// Thread id in traces.
+    std::uint32_t thread{};
+  };
+  /// Returns ring of the calling thread, registering it on first use.
+  ThreadRing& threadRing();
+
+private:
+  /// Guards mRings and thread names.
+  mutable std::mutex mRingsMutex{};
+  /// Rings of every thread that ever recorded a zone.
+  std::vector<std::unique_ptr<ThreadRing>> mRings{};
+  /// Scratch buffer rings are drained into.
+  std::vector<ProfileEvent> mDrained{};
+  /// Events of the current or last capture.
+  std::vector<CapturedEvent> mCaptured{};
+  /// True while a capture is running.
+  bool mIsCapturing{false};
+  /// Events dropped because the capture was full.
+  std::size_t mCaptureDropped{};
+  /// End time of the previous frame in nanoseconds.
+  Uint64 mLastFrameEnd{};
+  /// Durations of the recent frames in nanoseconds, used as a ring.
+  std::vector<Uint64> mFrameTimes{};
+  /// Next slot of mFrameTimes to be overwritten once the window is full.
+  std::size_t mFrameCursor{};
+};
+
+class ProfileScope
+{
+public:
+  /// Starts zone timing the enclosing scope.
+  /// @param name Zone name, a string literal.
+  explicit ProfileScope(const char* name)
+    : mName{name},
+      mStart{SDL_GetTicksNS()}
+  {}
+  /// Ends zone and records it.
+  ~ProfileScope()
+  {
+    Profiler::get().record(mName, mStart, SDL_GetTicksNS());
+  }
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+  ProfileScope(ProfileScope&&) = delete;
+  ProfileScope& operator=(ProfileScope&&) = delete;
+
+private:
+  /// Zone name.
+  const char* mName{nullptr};
+  /// Start time in nanoseconds.
+  Uint64 mStart{};
+};
+
+}
+
+#define RIPSAW_PROFILE_CONCAT_IMPL(a, b) a##b
+#define RIPSAW_PROFILE_CONCAT(a, b) RIPSAW_PROFILE_CONCAT_IMPL(a, b)
+/// Times the enclosing scope as a zone named name.
+#define RIPSAW_PROFILE_ZONE(name) ::RipsawEngine::ProfileScope RIPSAW_PROFILE_CONCAT(ripsawProfileZone, __LINE__){name}
+/// Names the calling thread in traces.
+#define RIPSAW_PROFILE_THREAD(name) ::RipsawEngine::Profiler::get().setThreadName(name)
+/// Marks the end of a frame.
+#define RIPSAW_PROFILE_FRAME() ::RipsawEngine::Profiler::get().endFrame()
+
+#else
+
+#define RIPSAW_PROFILE_ZONE(name) static_cast<void>(0)
+#define RIPSAW_PROFILE_THREAD(name) static_cast<void>(0)
+#define RIPSAW_PROFILE_FRAME() static_cast<void>(0)
+
+#endif
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef D2_CORE_SIMD_HXX
+#define D2_CORE_SIMD_HXX
+
+#include <cstddef>
+
+namespace RipsawEngine::Simd
+{
+
+/// Returns name of the instruction set the kernels were compiled for.
+/// @details Kernels are selected at compile time: AVX2 (+FMA) if the engine is built with RIPSAW_ENGINE_ENABLE_AVX2, SSE2 on every other x86-64 build, NEON on ARM targets, and plain scalar code otherwise.
+const char* getInstructionSet();
+/// Computes dst[i] += src[i] * scale over n floats.
+/// @param dst Destination array.
+/// @param src Source array.
+/// @param scale Scale factor applied to src.
+/// @param n Number of elements.
+void mulAdd(float* dst, const float* src, float scale, std::size_t n);
+/// Scalar reference implementation of @ref mulAdd().
+/// @param dst Destination array.
+/// @param src Source array.
+/// @param scale Scale factor applied to src.
+/// @param n Number of elements.
+void mulAddScalar(float* dst, const float* src, float scale, std::size_t n);
+/// Computes dst[i] += value over n floats.
+/// @param dst Destination array.
+/// @param value Value added to every element.
+/// @param n Number of elements.
+void add(float* dst, float value, std::size_t n);
+/// Scalar reference implementation of @ref add().
+/// @param dst Destination array.
+/// @param value Value added to every element.
+/// @param n Number of elements.
+void addScalar(float* dst, float value, std::size_t n);
+
+}
+
+#endif
@@ -1,8 +1,12 @@
 #ifndef D2_MANAGERS_BGMANAGER_HXX
 #define D2_MANAGERS_BGMANAGER_HXX
 
+#include "RipsawEngine/2D/Render/TextureAtlas.hxx"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
 #include <string>
-#include <tuple>
 #include <vector>
 
 namespace RipsawEngine
@@ -12,15 +16,22 @@ class BGManager
 {
 public:
   /// Constructs BGManager with Engine*, background image layers, and the speed of each layer.
-  /// @details This is a manager class. The purpose of manager classes are to create and manage already-programmed entities to complete a certain task. This background manager class implements parallax scrolling background with layers of provided images and their speeds. The philosophy is, any both-way scrolling 2D infinite background can be implemented with at least three actors. So, there would be a triplet of actors per layer which would be placed side by side to each other. The middle actor would be placed at the center of the screen, right one to its right, and left one to its left. Each actor would receive the same layer sprite. When the middle actor would go out of screen bound, its left or right actor would be repositioned to the right or left depending on scroll direction creating the illusion of infinite scrolling. The procedure is applied to all layers. And each layer would move at the speed of their respective speed.
+  /// @details This is a manager class. The purpose of manager classes are to create and manage already-programmed entities to complete a certain task. This background manager class implements parallax scrolling background with layers of provided images and their speeds. Each layer is scaled to cover the screen and repeats endlessly in both directions. Instead of moving actors around, a layer only keeps a scroll phase within one tile of its image; the engine advances it every frame and draws the layer as the at most four tiles intersecting the viewport, two for purely horizontal scrolling. A layer therefore costs the same no matter how far it has scrolled, and its texture is acquired from the texture cache exactly once. Layers scroll at their own speed and, through their camera factor, with the camera: 0 keeps a layer fixed on screen, 1 moves it with the world, values in between give depth. Layers are drawn in screen space behind every sprite.
   /// @warning Throws runtime error if number of layers and number of speeds doesn't equate.
   /// @param engine Pointer to Engine instance.
   /// @param layers Layers of background images.
-  /// @param layerSpeeds Vector of layer speed.
+  /// @param layerSpeeds Vector of horizontal layer speed in screen pixels per second.
   BGManager(class Engine* engine, const std::vector<std::string>& layers, const std::vector<float>& layerSpeeds);
+  /// Destructs BGManager, releasing layer textures.
+  ~BGManager();
+  BGManager(const BGManager&) = delete;
+  BGManager& operator=(const BGManager&) = delete;
+  BGManager(BGManager&&) = delete;
+  BGManager& operator=(BGManager&&) = delete;
   /// Implements custom update logic for manager.
+  /// @details Scrolling advances in the render pass, so there is nothing left to do here. Kept so that games calling it keep working.
   void update();
-  /// Sets scrolling speed of layers.
+  /// Sets horizontal scrolling speed of layers.
   /// @warning Throws runtime error if number of layers and number of speeds doesn't equate.
   /// @param speeds Vector of speed values of layers.
   void setSpeeds(const std::vector<float>& speeds);
@@ -28,19 +39,43 @@ public:
   /// @param dx Speed to change in X-axis.
   /// @param dy Speed to change in Y-axis.
   void changeSpeedBy(float dx, float dy = 0);
+  /// Sets how much each layer follows the camera, per axis.
+  /// @warning Throws runtime error if number of layers and number of factors doesn't equate.
+  /// @param factors Camera factor of each layer, 0 for none.
+  void setCameraFactors(const std::vector<glm::vec2>& factors);
+  /// Advances scroll phase of every layer. Called by engine once per rendered frame.
+  /// @param dt Delta-time.
+  void animate(double dt);
+  /// Adds tiles of every layer visible through a camera of the render packet to it.
+  /// @param packet Render packet of current frame.
+  /// @param cameraIndex Index of camera in the packet.
+  void submit(struct RenderPacket& packet, std::size_t cameraIndex) const;
+
+private:
+  /// One background layer.
+  struct Layer
+  {
+    /// Image file path.
+    std::string image{};
+    /// Texture region of image.
+    TextureRegion region{};
+    /// Scrolling speed in screen pixels per second.
+    glm::vec2 velocity{};
+    /// How much the layer follows the camera.
+    glm::vec2 cameraFactor{};
+    /// Scroll position in tiles, kept in [0, 1).
+    glm::vec2 phase{};
+    /// Size of one tile when the layer covers the whole screen.
+    glm::vec2 screenTileSize{};
+  };
 
 private:
   /// Pointer to Engine instance.
   class Engine* mEngine{nullptr};
-  /// Layers of background images.
-  std::vector<std::string> mLayers{};
-  /// Speed of background layers.
-  std::vector<float> mLayerSpeeds{};
-  /// Vector of Actor triplet.
-  std::vector<std::tuple<class Actor*, class Actor*, class Actor*>> mActorTriplets{};
+  /// Background layers, drawn first to last.
+  std::vector<Layer> mLayers{};
 };
 
 }
 
 #endif
-
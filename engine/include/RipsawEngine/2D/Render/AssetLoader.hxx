@@ -0,0 +1,121 @@
+#ifndef D2_RENDER_ASSETLOADER_HXX
+#define D2_RENDER_ASSETLOADER_HXX
+
+#include <SDL3/SDL.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+class AssetLoader
+{
+public:
+  /// Default time spent uploading decoded images per frame in nanoseconds.
+  static constexpr Uint64 DefaultUploadBudgetNS{2'000'000};
+
+public:
+  /// Constructs idle asset loader.
+  /// @details Asset loader moves image decoding off the game loop. Worker threads decode image files with IMG_Load() and queue the resulting surfaces; the main thread turns them into textures in @ref pumpUploads(), spending at most the upload budget per frame, because textures can only be created on the thread owning the renderer. Requests for a path already queued share one future.
+  AssetLoader() = default;
+  /// Destructs asset loader, stopping worker threads.
+  ~AssetLoader();
+  AssetLoader(const AssetLoader&) = delete;
+  AssetLoader& operator=(const AssetLoader&) = delete;
+  AssetLoader(AssetLoader&&) = delete;
+  AssetLoader& operator=(AssetLoader&&) = delete;
+  /// Starts worker threads.
+  /// @param cache Texture cache decoded images are uploaded to.
+  /// @param workers Number of worker threads, 0 to pick one from hardware concurrency.
+  void start(class TextureCache* cache, std::size_t workers = 0);
+  /// Stops worker threads. Requests not uploaded yet complete with False.
+  void stop();
+  /// Queues image file for decoding.
+  /// @details Every call makes a claim on the image, which keeps it pinned in the texture cache once uploaded, so it isn't evicted before the caller acquires it. The claim must be dropped with releaseTexture(), after acquiring the texture or when giving up on it.
+  /// @param path Path to image file.
+  /// @return Future that becomes True once the image is resident in the texture cache, False if it couldn't be loaded.
+  /// @warning Must be called from the main thread.
+  std::shared_future<bool> loadTexture(const std::string& path);
+  /// Drops a claim made by loadTexture().
+  /// @details If the image is still being loaded and no claim is left, it is uploaded unpinned, as an unused texture the cache may evict.
+  /// @param path Path to image file.
+  /// @warning Must be called from the main thread.
+  void releaseTexture(const std::string& path);
+  /// Uploads decoded images to the texture cache until the upload budget is spent. At least one image is uploaded if any is ready.
+  /// @return Number of images uploaded.
+  /// @warning Must be called from the thread owning the renderer.
+  std::size_t pumpUploads();
+  /// Sets time spent uploading decoded images per frame.
+  /// @param ns Budget in nanoseconds.
+  void setUploadBudget(Uint64 ns);
+  /// Returns time spent uploading decoded images per frame in nanoseconds.
+  Uint64 getUploadBudget() const;
+  /// Returns number of requests not uploaded yet.
+  std::size_t getPending() const;
+
+private:
+  /// Decodes queued image files until stopped.
+  void workerLoop();
+
+private:
+  /// Image file waiting to be decoded.
+  struct DecodeJob
+  {
+    /// Path to image file.
+    std::string path{};
+    /// Promise completed after upload.
+    std::promise<bool> promise{};
+  };
+  /// Decoded image waiting to be uploaded.
+  struct UploadJob
+  {
+    /// Path to image file.
+    std::string path{};
+    /// Decoded image, nullptr if decoding failed.
+    SDL_Surface* surface{nullptr};
+    /// Promise completed after upload.
+    std::promise<bool> promise{};
+  };
+  /// Request not uploaded yet.
+  struct InFlight
+  {
+    /// Future shared by every claim.
+    std::shared_future<bool> future{};
+    /// Number of claims not released yet.
+    std::size_t claims{};
+  };
+
+private:
+  /// Texture cache decoded images are uploaded to.
+  class TextureCache* mCache{nullptr};
+  /// Worker threads.
+  std::vector<std::thread> mWorkers{};
+  /// Guards mDecodeJobs and mIsStopping.
+  std::mutex mDecodeMutex{};
+  /// Wakes workers when jobs are queued or loader stops.
+  std::condition_variable mDecodeCondition{};
+  /// Image files waiting to be decoded.
+  std::deque<DecodeJob> mDecodeJobs{};
+  /// True while workers are asked to exit.
+  bool mIsStopping{false};
+  /// Guards mUploadJobs.
+  std::mutex mUploadMutex{};
+  /// Decoded images waiting to be uploaded.
+  std::deque<UploadJob> mUploadJobs{};
+  /// Requests not uploaded yet keyed by path. Touched only by the main thread.
+  std::unordered_map<std::string, InFlight> mInFlight{};
+  /// Time spent uploading decoded images per frame in nanoseconds.
+  Uint64 mUploadBudget{DefaultUploadBudgetNS};
+};
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef D2_RENDER_CAMERA_HXX
+#define D2_RENDER_CAMERA_HXX
+
+#include "RipsawEngine/2D/Systems/SpatialHash.hxx"
+
+#include <SDL3/SDL.h>
+#include <glm/glm.hpp>
+
+namespace RipsawEngine
+{
+
+class Camera
+{
+public:
+  /// Constructs camera covering the whole screen.
+  /// @details Camera maps world coordinates, the positions held by @ref TransformComponent, to screen pixels inside its viewport. Its position is the world point shown at the center of the viewport; zoom scales the world around that point and rotation turns the view clockwise. The transform is applied once per sprite while the render pass submits it, so scrolling a large world only moves the camera rather than every actor.
+  Camera() = default;
+  /// Constructs camera drawing into part of the screen.
+  /// @param viewport Viewport as fractions of screen size, e.g. {0, 0, 0.5, 1} for the left half.
+  explicit Camera(const SDL_FRect& viewport);
+  /// Returns world point shown at the center of the viewport.
+  const glm::vec2& getPosition() const;
+  /// Sets world point shown at the center of the viewport.
+  /// @param pos Position in world coordinates.
+  void setPosition(const glm::vec2& pos);
+  /// Moves camera by offset.
+  /// @param offset Offset in world units.
+  void move(const glm::vec2& offset);
+  /// Returns zoom factor.
+  float getZoom() const;
+  /// Sets zoom factor, 2 draws everything twice as big.
+  /// @param zoom Positive zoom factor.
+  void setZoom(float zoom);
+  /// Returns rotation in degrees.
+  double getRotation() const;
+  /// Sets clockwise rotation of the view in degrees.
+  /// @param degrees Rotation in degrees.
+  void setRotation(double degrees);
+  /// Returns viewport as fractions of screen size.
+  const SDL_FRect& getViewport() const;
+  /// Sets viewport as fractions of screen size.
+  /// @param viewport Viewport, each value in [0, 1].
+  void setViewport(const SDL_FRect& viewport);
+  /// Returns viewport in screen pixels.
+  SDL_FRect getViewportRect() const;
+  /// Sets size of screen the viewport is relative to. Maintained by engine.
+  /// @param size Screen size in pixels.
+  void setScreenSize(const glm::vec2& size);
+  /// Converts world point to screen pixels.
+  /// @param point Point in world coordinates.
+  glm::vec2 worldToScreen(const glm::vec2& point) const;
+  /// Converts screen pixels to world point, e.g. to find what the mouse points at.
+  /// @param point Point in screen pixels.
+  glm::vec2 screenToWorld(const glm::vec2& point) const;
+  /// Returns world box containing everything visible through the viewport.
+  Aabb getViewBounds() const;
+  /// Converts rectangle of a sprite to screen pixels.
+  /// @details Only the center goes through the camera transform; size scales with zoom and the camera rotation adds to the sprite's own.
+  /// @param rect Rectangle before rotation, in world coordinates or, if screenSpace is set, in viewport pixels.
+  /// @param screenSpace Boolean flag telling that rect ignores the camera.
+  /// @param angle Rotation of the sprite in degrees, turned into its rotation on screen.
+  SDL_FRect projectRect(const SDL_FRect& rect, bool screenSpace, double& angle) const;
+
+private:
+  /// World point at the center of the viewport.
+  glm::vec2 mPosition{};
+  /// Zoom factor.
+  float mZoom{1.f};
+  /// Rotation in degrees.
+  double mRotation{};
+  /// Cosine of rotation.
+  float mCos{1.f};
+  /// Sine of rotation.
+  float mSin{0.f};
+  /// Viewport as fractions of screen size.
+  SDL_FRect mViewport{0.f, 0.f, 1.f, 1.f};
+  /// Screen size in pixels.
+  glm::vec2 mScreenSize{};
+};
+
+}
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef D2_RENDER_RENDER_HXX
+#define D2_RENDER_RENDER_HXX
+
+#include "AssetLoader.hxx"
+#include "Camera.hxx"
+#include "RenderPacket.hxx"
+#include "RenderQueue.hxx"
+#include "SpriteBatch.hxx"
+#include "TextureAtlas.hxx"
+#include "TextureCache.hxx"
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef D2_RENDER_RENDERPACKET_HXX
+#define D2_RENDER_RENDERPACKET_HXX
+
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+#include "RipsawEngine/2D/Render/Camera.hxx"
+#include "RipsawEngine/2D/Systems/SpatialHash.hxx"
+
+#include <SDL3/SDL.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Sprite as it is to be drawn, copied out of @ref SpriteComponent.
+struct SpriteSnapshot
+{
+  /// Texture, nullptr while the sprite's texture is loading.
+  SDL_Texture* texture{nullptr};
+  /// Actor owning the sprite.
+  Handle actor{};
+  /// Source rectangle in texture pixels.
+  SDL_FRect src{};
+  /// Destination rectangle before rotation, in world coordinates or in viewport pixels for screen-space sprites.
+  SDL_FRect dst{};
+  /// Box covered including rotation, in the same space as dst.
+  Aabb bounds{};
+  /// Sort key, see SpriteComponent::getSortKey().
+  std::uint64_t key{};
+  /// Rotation in degrees.
+  double rotation{};
+  /// Flip state.
+  SDL_FlipMode flip{SDL_FLIP_NONE};
+  /// True if dst is in viewport pixels.
+  bool isScreenSpace{false};
+};
+
+/// Quad already placed in screen pixels for one camera, e.g. a background tile.
+struct PacketQuad
+{
+  /// Index of the camera in RenderPacket::cameras.
+  std::size_t camera{};
+  /// Texture.
+  SDL_Texture* texture{nullptr};
+  /// Source rectangle in texture pixels.
+  SDL_FRect src{};
+  /// Destination rectangle in screen pixels.
+  SDL_FRect dst{};
+};
+
+/// Particle as it is to be drawn, copied out of @ref ParticleSystem.
+struct PacketParticle
+{
+  /// Center in world coordinates.
+  float x{};
+  /// Center in world coordinates.
+  float y{};
+  /// Width and height in world units.
+  float size{};
+  /// Color, multiplied with the texture.
+  SDL_FColor color{};
+};
+
+/// Particles of one emitter, drawn with a single geometry submission.
+struct ParticleBatch
+{
+  /// Texture, nullptr to draw plain colored squares.
+  SDL_Texture* texture{nullptr};
+  /// Actor owning the emitter.
+  Handle actor{};
+  /// Source rectangle in texture pixels.
+  SDL_FRect src{};
+  /// Box covering every particle of the batch, in world coordinates.
+  Aabb bounds{};
+  /// Sort key, ordered against sprite keys.
+  std::uint64_t key{};
+  /// Index of the first particle in RenderPacket::particles.
+  std::size_t first{};
+  /// Number of particles.
+  std::size_t count{};
+};
+
+/// Cached tiles of one tilemap chunk, drawn with a single geometry submission.
+struct TileBatch
+{
+  /// Tileset texture, nullptr to draw plain white squares.
+  SDL_Texture* texture{nullptr};
+  /// Actor owning the tilemap.
+  Handle actor{};
+  /// Box covered by the chunk, in world coordinates.
+  Aabb bounds{};
+  /// Origin of the tilemap in world coordinates, which vertex positions are relative to.
+  glm::vec2 origin{};
+  /// Sort key, ordered against sprite keys.
+  std::uint64_t key{};
+  /// Index of the first vertex in RenderPacket::tileVertices.
+  std::size_t first{};
+  /// Number of tiles, four vertices each.
+  std::size_t count{};
+};
+
+/// Everything one frame draws, extracted from the scene so it can be drawn while the scene moves on.
+/// @details Engine fills a packet at the end of simulating a frame and draws from it afterwards, never from the scene itself. With a pipelined engine there are two packets: one is drawn on the main thread while the simulation thread fills the other. Buffers are kept between frames so steady-state frames don't allocate.
+struct RenderPacket
+{
+  /// Cameras as they were when the packet was filled.
+  std::vector<Camera> cameras{};
+  /// Sprites in creation order.
+  std::vector<SpriteSnapshot> sprites{};
+  /// Quads drawn behind the sprites of their camera, in drawing order.
+  std::vector<PacketQuad> quads{};
+  /// Particles of every batch.
+  std::vector<PacketParticle> particles{};
+  /// Particle batches by ascending key.
+  std::vector<ParticleBatch> particleBatches{};
+  /// Vertices of every tile batch, relative to the origin of their tilemap.
+  std::vector<SDL_Vertex> tileVertices{};
+  /// Tile batches by ascending key.
+  std::vector<TileBatch> tileBatches{};
+  /// True if sprites outside the view are skipped.
+  bool isCulling{true};
+  /// Removes everything, keeping buffers.
+  void clear();
+};
+
+}
+
+#endif
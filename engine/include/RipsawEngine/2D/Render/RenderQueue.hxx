@@ -0,0 +1,51 @@
+#ifndef D2_RENDER_RENDERQUEUE_HXX
+#define D2_RENDER_RENDERQUEUE_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Returns sort key of layer and depth: layer in the top byte, depth in the next 32 bits, the low 24 bits left for a texture key.
+/// @param layer Draw layer.
+/// @param depth Depth within layer.
+std::uint64_t makeSortKey(std::uint8_t layer, float depth);
+
+/// Entry of @ref RenderQueue.
+struct RenderItem
+{
+  /// Sort key, drawn in ascending order.
+  std::uint64_t key{};
+  /// Sprite to be drawn.
+  const struct SpriteSnapshot* sprite{nullptr};
+};
+
+class RenderQueue
+{
+public:
+  /// Constructs empty render queue.
+  /// @details Render queue collects the sprites visible in one camera pass together with their 64-bit sort keys and sorts them with an LSD radix sort, one pass per key byte. Passes over bytes that are the same in every key are skipped, so keys that only differ in a few fields sort in a few linear passes. The sort is stable: sprites with equal keys keep the order they were pushed in. Buffers are kept between frames so steady-state frames don't allocate.
+  RenderQueue() = default;
+  /// Removes every item, keeping buffers.
+  void clear();
+  /// Appends item.
+  /// @param key Sort key.
+  /// @param sprite Sprite to be drawn.
+  void push(std::uint64_t key, const struct SpriteSnapshot* sprite);
+  /// Sorts items by ascending key.
+  void sort();
+  /// Returns items, sorted after sort().
+  const std::vector<RenderItem>& getItems() const;
+
+private:
+  /// Items.
+  std::vector<RenderItem> mItems{};
+  /// Scratch buffer of the radix sort.
+  std::vector<RenderItem> mScratch{};
+};
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef D2_RENDER_SPRITEBATCH_HXX
+#define D2_RENDER_SPRITEBATCH_HXX
+
+#include <SDL3/SDL.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+class SpriteBatch
+{
+public:
+  /// Constructs empty sprite batch.
+  /// @details Sprite batch collects textured quads in submission order and sends every consecutive run of quads sharing the same texture (and therefore the same blend mode) to the renderer with a single SDL_RenderGeometry() call. Layering order is preserved because runs are never reordered, only merged while the texture stays the same.
+  SpriteBatch() = default;
+  /// Starts new frame of batching on specified renderer and resets per-frame counters.
+  /// @param renderer Renderer.
+  void begin(SDL_Renderer* renderer);
+  /// Queues textured quad.
+  /// @param texture Texture.
+  /// @param src Source rectangle in texture pixels.
+  /// @param dst Destination rectangle in screen pixels before rotation.
+  /// @param angle Clockwise rotation in degrees around center of dst.
+  /// @param flip Flip state.
+  void draw(SDL_Texture* texture, const SDL_FRect& src, const SDL_FRect& dst, double angle = 0, SDL_FlipMode flip = SDL_FLIP_NONE);
+  /// Submits prebuilt geometry with one SDL_RenderGeometry() call, after the queued quads so layering is kept.
+  /// @param texture Texture, nullptr for untextured geometry.
+  /// @param vertices Vertices.
+  /// @param vertexCount Number of vertices.
+  /// @param indices Indices into vertices.
+  /// @param indexCount Number of indices.
+  void drawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount);
+  /// Submits queued quads of current run to renderer.
+  void flush();
+  /// Flushes remaining quads and finishes frame.
+  void end();
+  /// Returns number of geometry submissions issued since begin().
+  std::size_t getDrawCalls() const;
+  /// Returns number of quads queued since begin().
+  std::size_t getQuads() const;
+
+private:
+  /// Renderer of current frame.
+  SDL_Renderer* mRenderer{nullptr};
+  /// Texture of current run.
+  SDL_Texture* mTexture{nullptr};
+  /// Size of texture of current run.
+  glm::vec2 mTexSize{};
+  /// Vertices of current run.
+  std::vector<SDL_Vertex> mVertices{};
+  /// Indices of current run.
+  std::vector<int> mIndices{};
+  /// Geometry submissions since begin().
+  std::size_t mDrawCalls{};
+  /// Quads queued since begin().
+  std::size_t mQuads{};
+};
+
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef D2_RENDER_TEXTUREATLAS_HXX
+#define D2_RENDER_TEXTUREATLAS_HXX
+
+#include <SDL3/SDL.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Part of a texture occupied by one image.
+struct TextureRegion
+{
+  /// Texture holding the image.
+  SDL_Texture* texture{nullptr};
+  /// Rectangle of the image inside texture in texture pixels.
+  SDL_FRect rect{};
+};
+
+class SkylinePacker
+{
+public:
+  /// Constructs skyline packer for a bin of specified size.
+  /// @details Skyline packer keeps the upper contour of everything placed so far as a list of horizontal segments and places each new rectangle at the bottom-left-most position where it fits on top of that contour. It never moves rectangles it has already placed, which makes it suitable for incremental insertion.
+  /// @param width Width of bin.
+  /// @param height Height of bin.
+  SkylinePacker(int width = 0, int height = 0);
+  /// Finds place for rectangle of specified size.
+  /// @param w Width of rectangle.
+  /// @param h Height of rectangle.
+  /// @param out Position of rectangle if placed.
+  /// @return True if rectangle was placed, False if bin is full.
+  bool insert(int w, int h, SDL_Rect& out);
+
+private:
+  /// Returns Y at which rectangle fits if its left edge is at segment index, -1 if it doesn't.
+  int fit(std::size_t index, int w, int h) const;
+
+private:
+  /// Horizontal segment of skyline.
+  struct Segment
+  {
+    int x{};
+    int y{};
+    int w{};
+  };
+
+private:
+  /// Width of bin.
+  int mWidth{};
+  /// Height of bin.
+  int mHeight{};
+  /// Skyline segments sorted by X.
+  std::vector<Segment> mSkyline{};
+};
+
+class TextureAtlas
+{
+public:
+  /// Default size of atlas pages.
+  static constexpr int DefaultPageSize{2048};
+  /// Transparent gap kept around each packed image to avoid bleeding of neighbours under filtering.
+  static constexpr int Padding{1};
+
+public:
+  /// Constructs empty texture atlas.
+  /// @details Texture atlas packs many small images into a few large page textures so that sprites using different images still share one texture and therefore one batch. Images are packed on demand with @ref SkylinePacker when they are first loaded; new pages are opened when existing ones are full. Alternatively, atlases can be baked offline with @ref bake() and loaded with @ref load(), so startup needs neither decoding of individual images nor packing.
+  TextureAtlas() = default;
+  /// Destructs atlas, destroying page textures.
+  ~TextureAtlas();
+  TextureAtlas(const TextureAtlas&) = delete;
+  TextureAtlas& operator=(const TextureAtlas&) = delete;
+  TextureAtlas(TextureAtlas&&) = delete;
+  TextureAtlas& operator=(TextureAtlas&&) = delete;
+  /// Sets renderer used to create page textures and clamps page size to its limit.
+  /// @param renderer Renderer.
+  void setRenderer(SDL_Renderer* renderer);
+  /// Sets size of pages opened from now on.
+  /// @param size Page width and height in pixels.
+  void setPageSize(int size);
+  /// Returns True if an image of specified size is small enough to be packed.
+  /// @param w Width of image.
+  /// @param h Height of image.
+  bool accepts(int w, int h) const;
+  /// Packs image into atlas and uploads it.
+  /// @param key Key of image, usually its path.
+  /// @param surface Decoded image.
+  /// @param out Region the image landed in.
+  /// @return True if image was packed.
+  bool insert(const std::string& key, SDL_Surface* surface, TextureRegion& out);
+  /// Looks up region of previously packed or baked image.
+  /// @param key Key of image.
+  /// @param out Region of image.
+  /// @return True if image is in atlas.
+  bool find(const std::string& key, TextureRegion& out) const;
+  /// Loads atlas baked by @ref bake().
+  /// @details Pages loaded from disk are considered full; images packed later go to new pages. The index is checked before anything is added, so a missing page or a truncated or corrupt index leaves the atlas as it was.
+  /// @param dir Directory holding baked pages and index.
+  /// @return True if successful.
+  bool load(const std::string& dir);
+  /// Returns number of pages.
+  std::size_t getPageCount() const;
+  /// Returns size of a page in pixels.
+  int getPageSize() const;
+  /// Destroys every page.
+  void clear();
+  /// Packs image files into atlas pages and writes them to disk along with a binary index.
+  /// @details This is the offline mode of the atlas. It does not need a renderer. The index file atlas.idx starts with the magic "RSAT" and a format version, followed by page count, entry count, and for each entry its page, rectangle and key. All integers are 32-bit little-endian. Pages are written as atlas_<page>.png next to it.
+  /// @param paths Image files to bake.
+  /// @param dir Output directory.
+  /// @param pageSize Page width and height in pixels.
+  /// @return True if successful.
+  static bool bake(const std::vector<std::string>& paths, const std::string& dir, int pageSize = DefaultPageSize);
+
+private:
+  /// Opens new empty page.
+  /// @return True if successful.
+  bool addPage();
+
+private:
+  /// Atlas page.
+  struct Page
+  {
+    /// Page texture.
+    SDL_Texture* texture{nullptr};
+    /// Packer of page.
+    SkylinePacker packer{};
+    /// True if page accepts no more images.
+    bool isFull{false};
+  };
+  /// Packed image.
+  struct Entry
+  {
+    /// Page index.
+    std::size_t page{};
+    /// Rectangle in page.
+    SDL_Rect rect{};
+  };
+
+private:
+  /// Renderer.
+  SDL_Renderer* mRenderer{nullptr};
+  /// Page size.
+  int mPageSize{DefaultPageSize};
+  /// Pages.
+  std::vector<Page> mPages{};
+  /// Packed images keyed by their key.
+  std::unordered_map<std::string, Entry> mEntries{};
+};
+
+}
+
+#endif
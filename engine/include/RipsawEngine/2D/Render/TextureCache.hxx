@@ -0,0 +1,137 @@
+#ifndef D2_RENDER_TEXTURECACHE_HXX
+#define D2_RENDER_TEXTURECACHE_HXX
+
+#include "RipsawEngine/2D/Render/TextureAtlas.hxx"
+
+#include <SDL3/SDL.h>
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace RipsawEngine
+{
+
+/// Counters exposed by @ref TextureCache.
+struct TextureCacheStats
+{
+  /// Acquisitions served from cache.
+  std::size_t hits{};
+  /// Acquisitions that had to decode the image file.
+  std::size_t misses{};
+  /// First acquisitions of images baked into the loaded atlas, which decode nothing.
+  std::size_t atlasHits{};
+  /// Textures destroyed to stay within budget.
+  std::size_t evictions{};
+  /// Number of textures currently resident.
+  std::size_t textures{};
+  /// Estimated video memory used by resident textures.
+  std::size_t bytes{};
+  /// Budget for resident textures in bytes.
+  std::size_t budget{};
+  /// Number of atlas pages.
+  std::size_t atlasPages{};
+};
+
+class TextureCache
+{
+public:
+  /// Default budget for resident textures in bytes.
+  static constexpr std::size_t DefaultBudget{256 * 1024 * 1024};
+
+public:
+  /// Constructs empty texture cache.
+  /// @details Texture cache decodes every image file once and hands out the same texture to everyone asking for that path, counting references. A texture nobody references anymore is not destroyed right away; it stays resident in least-recently-released order so that respawning the same sprite is free, and is evicted only when resident textures exceed the byte budget. Referenced textures are never evicted, so the budget can be exceeded while they are in use. Small images are packed into a @ref TextureAtlas unless the atlas is disabled; atlas pages stay resident until the cache is cleared and are not counted against the budget.
+  TextureCache() = default;
+  /// Destructs texture cache, destroying every resident texture.
+  ~TextureCache();
+  TextureCache(const TextureCache&) = delete;
+  TextureCache& operator=(const TextureCache&) = delete;
+  TextureCache(TextureCache&&) = delete;
+  TextureCache& operator=(TextureCache&&) = delete;
+  /// Sets renderer used to create textures.
+  /// @param renderer Renderer.
+  void setRenderer(SDL_Renderer* renderer);
+  /// Returns texture region of image file, loading it on first use, and adds a reference to it.
+  /// @param path Path to image file.
+  /// @return Texture region; its texture is nullptr if the image couldn't be loaded.
+  TextureRegion acquire(const std::string& path);
+  /// Makes image decoded elsewhere resident without referencing it, so the next acquire() of its path is a hit.
+  /// @details Used by @ref AssetLoader to upload images decoded on worker threads. The image is pinned once per claim still waiting for it, see pin(), so it can't be evicted between being reported loaded and being acquired, even if referenced textures alone exceed the budget. Without claims it goes straight to the unused textures. Images already resident are left untouched apart from being pinned.
+  /// @param path Path to image file.
+  /// @param surface Decoded image, still owned by caller.
+  /// @param pins Number of claims waiting for the image.
+  /// @return True if image is resident afterwards.
+  bool insert(const std::string& path, SDL_Surface* surface, std::size_t pins);
+  /// Keeps resident image from being evicted until unpin(), whether referenced or not. Paths not resident are ignored.
+  /// @param path Path to image file.
+  void pin(const std::string& path);
+  /// Drops a pin made by pin() or insert(); an unreferenced image without pins becomes evictable. Paths not pinned are ignored.
+  /// @param path Path to image file.
+  void unpin(const std::string& path);
+  /// Returns True if image is resident or baked into the loaded atlas, so acquiring it won't decode anything.
+  /// @param path Path to image file.
+  bool contains(const std::string& path) const;
+  /// Drops a reference to image previously acquired. Unknown paths are ignored.
+  /// @param path Path to image file.
+  void release(const std::string& path);
+  /// Enables/disables packing of newly loaded images into the atlas. Enabled by default.
+  /// @param enabled Boolean atlas state.
+  void setAtlasEnabled(bool enabled);
+  /// Loads atlas baked offline with TextureAtlas::bake(), so images in it are never decoded individually.
+  /// @param dir Directory holding baked atlas.
+  /// @return True if successful.
+  bool loadAtlas(const std::string& dir);
+  /// Returns texture atlas.
+  TextureAtlas& getAtlas();
+  /// Sets budget for resident textures, evicting unreferenced textures if it is exceeded.
+  /// @param bytes Budget in bytes.
+  void setBudget(std::size_t bytes);
+  /// Returns cache counters.
+  const TextureCacheStats& getStats() const;
+  /// Destroys every resident texture, referenced or not.
+  /// @details Must be called before the renderer is destroyed.
+  void clear();
+
+private:
+  /// Uploads decoded image to atlas or to standalone texture and records it with specified reference and pin count.
+  /// @return Texture region; its texture is nullptr if upload failed.
+  TextureRegion upload(const std::string& path, SDL_Surface* surface, std::size_t refs, std::size_t pins);
+  /// Evicts least recently released textures until resident bytes fit in budget.
+  void trim();
+
+private:
+  /// Resident texture entry.
+  struct Entry
+  {
+    /// Texture region.
+    TextureRegion region{};
+    /// Estimated size of texture in bytes, 0 for images living in the atlas.
+    std::size_t bytes{};
+    /// Number of references handed out.
+    std::size_t refs{};
+    /// Number of pins, see pin().
+    std::size_t pins{};
+    /// Position in mUnused while refs and pins are 0.
+    std::list<std::string>::iterator unusedIt{};
+  };
+
+private:
+  /// Renderer.
+  SDL_Renderer* mRenderer{nullptr};
+  /// Resident textures keyed by image path.
+  std::unordered_map<std::string, Entry> mEntries{};
+  /// Paths of unreferenced textures, least recently released at front.
+  std::list<std::string> mUnused{};
+  /// Atlas small images are packed into.
+  TextureAtlas mAtlas{};
+  /// True if newly loaded images are packed into atlas.
+  bool mIsAtlasEnabled{true};
+  /// Cache counters.
+  TextureCacheStats mStats{0, 0, 0, 0, 0, 0, DefaultBudget, 0};
+};
+
+}
+
+#endif
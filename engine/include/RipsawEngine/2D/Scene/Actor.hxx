@@ -1,12 +1,21 @@
 #ifndef D2_SCENE_ACTOR_HXX
 #define D2_SCENE_ACTOR_HXX
 
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+#include "RipsawEngine/2D/Core/Pool.hxx"
+#include "RipsawEngine/2D/Scene/ArchetypeStore.hxx"
+#include "RipsawEngine/2D/Scene/Component.hxx"
+
 #include <SDL3/SDL_log.h>
 #include <glm/glm.hpp>
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace RipsawEngine
@@ -14,6 +23,10 @@ namespace RipsawEngine
 
 class Actor
 {
+public:
+  /// Most components with a type id one actor holds.
+  static constexpr std::size_t MaxTypedComponents{8};
+
 public:
   /// Constructs actor with pointer to @ref Engine instance.
   /// @param engine Pointer to @ref Engine instance.
@@ -24,6 +37,15 @@ public:
   Actor& operator=(Actor&&) = delete;
   /// Destructs actor.
   virtual ~Actor();
+  /// Allocates actor storage from the actor pool.
+  /// @param size Size of object in bytes.
+  static void* operator new(std::size_t size);
+  /// Returns actor storage to the actor pool.
+  /// @param ptr Object storage.
+  /// @param size Size of object in bytes.
+  static void operator delete(void* ptr, std::size_t size);
+  /// Returns occupancy of the actor pool.
+  static const PoolStats& getPoolStats();
   /// Updates actor.
   /// @param dt Delta-time.
   void update(double dt);
@@ -54,26 +76,89 @@ public:
   /// Sets position of actor.
   /// @param pos Position of actor.
   void setPosition(const glm::vec2& pos);
+  /// Sets position of actor without interpolating from the old one when the engine runs at a fixed timestep.
+  /// @param pos Position of actor.
+  void teleport(const glm::vec2& pos);
   /// Sets velocity of actor.
   glm::vec2 getVelocity() const;
   /// Sets velocity of actor.
   /// @param vel Velocity of actor.
   void setVelocity(const glm::vec2& vel);
+  /// Gives actor a bounding box for spatial queries and collision pairs.
+  /// @param size Width and height of bounding box.
+  void setBounds(const glm::vec2& size);
   /// Returns mEngine so that other componets can use it if needed.
   class Engine* getEngine() const;
-  /// Returns True if the specified component exists in mComponentMap.
-  /// @param compname Component name.
-  bool hasComponent(const std::string& compname) const;
-  /// Registers specified component in mComponentMap.
-  /// @param compname Component name.
-  void registerComponent(const std::string& compname);
-  /// Deregisters component from mComponentMap.
-  /// @param compname Component name.
-  void deregisterComponent(const std::string& compname);
-  /// Helper method to ease out component registration avoiding code duplication.
-  /// @warn Throws runtime error if specified component has already been injected in actor.
-  /// @param compname Component name.
-  void helperRegisterComponent(const std::string& compname);
+  /// Returns handle engine refers to the actor by.
+  Handle getHandle() const;
+  /// Sets handle of actor. Called by engine when the actor is added.
+  /// @param handle Handle of actor.
+  void setHandle(Handle handle);
+  /// Constructs component of type T owned by the actor.
+  /// @details Component constructors take the owning actor first; args are forwarded after it. The component registers itself under its type id, see @ref registerComponent().
+  /// @details If the constructor throws, the component is dropped from @ref mComponents again, so the actor never deletes it.
+  /// @warning Throws runtime error if the actor already holds a component of type T or @ref MaxTypedComponents typed components, or if another component type declares the id of T, see componentTypeId().
+  /// @param args Constructor arguments following the actor.
+  /// @return Pointer to the component, owned by the actor.
+  template <TypedComponent T, typename... Args>
+  T* addComponent(Args&&... args)
+  {
+    if (this->hasComponent<T>())
+    {
+      throw std::runtime_error{"[ABORT] Actor already owns component type " + std::to_string(T::TypeId)};
+    }
+    if (static_cast<std::size_t>(std::popcount(mComponentMask)) >= MaxTypedComponents)
+    {
+      throw std::runtime_error{"[ABORT] Actor can't hold more than " + std::to_string(MaxTypedComponents) + " typed components"};
+    }
+
+    std::size_t count{mComponents.size()};
+    try
+    {
+      return new T{this, std::forward<Args>(args)...};
+    }
+    catch (...)
+    {
+      mComponents.resize(count);
+      throw;
+    }
+  }
+  /// Returns component of type T, nullptr if the actor holds none.
+  /// @warning Throws runtime error if another component type declares the id of T, see componentTypeId().
+  template <TypedComponent T>
+  T* getComponent() const
+  {
+    return static_cast<T*>(this->getComponent(componentTypeId<T>()));
+  }
+  /// Returns True if the actor holds a component of type T.
+  /// @warning Throws runtime error if another component type declares the id of T, see componentTypeId().
+  template <TypedComponent T>
+  bool hasComponent() const
+  {
+    return this->hasComponent(componentTypeId<T>());
+  }
+  /// Returns component registered under type id, nullptr if none.
+  /// @param id Component type id.
+  Component* getComponent(ComponentTypeId id) const;
+  /// Returns True if a component is registered under type id.
+  /// @param id Component type id.
+  bool hasComponent(ComponentTypeId id) const;
+  /// Returns type ids of every registered component, one bit each.
+  ComponentMask getComponentMask() const;
+  /// Registers component under type id. Called by the constructors of typed components.
+  /// @details The actor moves to the archetype of its new component set, see Engine::each().
+  /// @warning Throws runtime error if the id is taken, or if the actor already holds @ref MaxTypedComponents typed components. Component constructors throwing this way are rolled back by addComponent().
+  /// @param id Component type id.
+  /// @param component Component.
+  void registerComponent(ComponentTypeId id, Component* component);
+  /// Deregisters component of type id. Called by the destructors of typed components.
+  /// @param id Component type id.
+  void deregisterComponent(ComponentTypeId id);
+  /// Returns place of actor in the archetype store of the engine.
+  ArchetypeLocation getArchetypeLocation() const;
+  /// Sets place of actor in the archetype store. Called by @ref ArchetypeStore.
+  /// @param location Archetype and row.
+  void setArchetypeLocation(ArchetypeLocation location);
 
 public:
   /// Dynamically allocates TransformComponent.
@@ -82,7 +167,8 @@ public:
   void createTransformComponent(const glm::vec2& pos, const glm::vec2& vel);
   /// Dynamically allocates SpriteComponent.
   /// @param imgfile Image file for sprite.
-  void createSpriteComponent(const std::string& imgfile);
+  /// @param loadAsync Boolean flag to decode image in background instead of blocking.
+  void createSpriteComponent(const std::string& imgfile, bool loadAsync = false);
   /// Dynamically allocates SpriteComponent.
   /// @param size Size of sprite.
   /// @param color Color of sprite.
@@ -93,24 +179,38 @@ public:
   /// @param defaultCoord Default coordinate of spritesheet for rendering.
   /// @param doAnimate Animation state.
   /// @param animFPS Animation FPS.
-  void createSpritesheetComponent(const std::string& imgfile, const glm::vec2& dims, const glm::vec2& defaultCoord = {1, 1}, bool doAnimate = false, float animFPS = 24.f);
+  /// @param loadAsync Boolean flag to decode image in background instead of blocking.
+  void createSpritesheetComponent(const std::string& imgfile, const glm::vec2& dims, const glm::vec2& defaultCoord = {1, 1}, bool doAnimate = false, float animFPS = 24.f, bool loadAsync = false);
+  /// Dynamically allocates ParticleEmitterComponent.
+  /// @param config Emitter parameters.
+  void createParticleEmitterComponent(const struct ParticleEmitterConfig& config);
+  /// Dynamically allocates TilemapComponent.
+  /// @param config Tilemap parameters.
+  void createTilemapComponent(const struct TilemapConfig& config);
+
+private:
+  /// Returns index of the component of type id in mTypedComponents, whether registered or not.
+  /// @param id Component type id.
+  std::size_t rankOf(ComponentTypeId id) const;
 
 private:
   /// Main engine instance.
   class Engine* mEngine{nullptr};
+  /// Handle engine refers to the actor by.
+  Handle mHandle{};
   /// Vector of all components tied to the actor.
   std::vector<class Component*> mComponents{};
   /// @ref TransformComponent tied to the actor (if any).
   class TransformComponent* mTransformComponent{nullptr};
   /// @ref SpriteComponent tied to the actor (if any).
   class SpriteComponent* mSpriteComponent{nullptr};
-  /// Map of all possible components that actor can hold and their inclusion status in the actor.
-  /// @details Components are capabilities of an actor. The philosophy as of now is, no actor should be able to hold the same type of component more than once. To ensure that, there should be a way in actor to verify in runtime if the same type of component is being injected more than once in the same actor. This map holds a list of {key, value} pairs where the keys are possible components and the values default to false which means that the associated component has not yet been injected in the actor.
-  std::unordered_map<std::string, bool> mComponentMap
-  {
-    {"TransformComponent", false},
-    {"SpriteComponent", false},
-  };
+  /// Type ids of the components registered with the actor.
+  /// @details Components are capabilities of an actor, and no actor holds the same type of component more than once, which lets one bit per type stand in for a lookup by name.
+  ComponentMask mComponentMask{};
+  /// Registered components ordered by type id, so the one of an id sits at the number of lower bits set in mComponentMask.
+  std::array<class Component*, MaxTypedComponents> mTypedComponents{};
+  /// Place of actor in the archetype store of the engine.
+  ArchetypeLocation mArchetypeLocation{};
 };
 
 }
@@ -0,0 +1,144 @@
+#ifndef D2_SCENE_ARCHETYPESTORE_HXX
+#define D2_SCENE_ARCHETYPESTORE_HXX
+
+#include "RipsawEngine/2D/Scene/Component.hxx"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Place of an actor in @ref ArchetypeStore.
+struct ArchetypeLocation
+{
+  /// Index of archetype, ArchetypeStore::NoArchetype if the actor isn't stored.
+  std::uint32_t archetype{UINT32_MAX};
+  /// Row of the actor in the archetype.
+  std::uint32_t row{};
+};
+
+class ArchetypeStore
+{
+public:
+  /// Number of rows of one chunk.
+  static constexpr std::size_t ChunkCapacity{256};
+  /// Archetype index of actors not in the store.
+  static constexpr std::uint32_t NoArchetype{UINT32_MAX};
+
+public:
+  /// Constructs empty store.
+  /// @details Archetype store groups actors by their exact set of typed components, Actor::getComponentMask(), each set being an archetype. An archetype keeps its actors in fixed-size chunks laid out as structure-of-arrays: one column of actor pointers, and one column of component pointers per type of the set, ordered by type id. A query names the component types it needs; the archetypes holding all of them are looked up once and cached by mask, so each() walks only the chunks of matching archetypes, linearly, and never sees any other actor. Adding or removing a typed component is a structural change: the actor moves to the archetype of its new set, and the last row of the old archetype is swapped into its place. Creating an archetype invalidates every cached query. Archetypes are never destroyed; an empty one just has no rows.
+  ArchetypeStore() = default;
+  ArchetypeStore(const ArchetypeStore&) = delete;
+  ArchetypeStore& operator=(const ArchetypeStore&) = delete;
+  ArchetypeStore(ArchetypeStore&&) = delete;
+  ArchetypeStore& operator=(ArchetypeStore&&) = delete;
+  /// Stores actor in the archetype of its component set.
+  /// @param actor Actor not yet stored.
+  void add(class Actor* actor);
+  /// Removes actor from the store. Later changes of its components are ignored.
+  /// @param actor Actor.
+  void remove(class Actor* actor);
+  /// Moves actor to the archetype of its component set after a component was registered or deregistered. Actors not stored are ignored.
+  /// @param actor Actor.
+  void update(class Actor* actor);
+  /// Calls fn(Actor&, Ts&...) for every stored actor holding components of every type Ts.
+  /// @details Actors of one archetype are visited in row order, chunk by chunk; archetypes in the order they were created.
+  /// @warning Throws runtime error if another component type declares the id of one of Ts, see componentTypeId(). fn must not add or remove typed components, or create actors, since that moves rows under the iteration. Record such changes into Engine::getCommandBuffer(), or collect the actors and change them afterwards. Destroying actors through Engine::destroyActor() is safe, as it is deferred.
+  /// @param fn Function called per actor.
+  template <TypedComponent... Ts, typename Fn>
+  void each(Fn&& fn)
+  {
+    constexpr ComponentMask mask{(ComponentMask{} | ... | ComponentBit<Ts>)};
+    (componentTypeId<Ts>(), ...);
+    for (std::uint32_t index : this->match(mask))
+    {
+      const Archetype& archetype{mArchetypes[index]};
+      std::array<std::size_t, sizeof...(Ts)> columns{columnOf(archetype.mask, Ts::TypeId)...};
+      for (const auto& chunk : archetype.chunks)
+      {
+        Actor* const* actors{chunk.actors.get()};
+        Component* const* components{chunk.components.get()};
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            for (std::size_t row{}; row < chunk.count; ++row)
+            {
+              fn(*actors[row], *static_cast<Ts*>(components[columns[Is] * ChunkCapacity + row])...);
+            }
+        }(std::index_sequence_for<Ts...>{});
+      }
+    }
+  }
+  /// Returns number of stored actors holding components of every type in mask.
+  /// @param mask Component types.
+  std::size_t count(ComponentMask mask);
+  /// Returns number of archetypes created so far.
+  std::size_t getArchetypeCount() const;
+  /// Removes every actor and archetype.
+  void clear();
+
+private:
+  /// Fixed-size block of rows of one archetype.
+  struct Chunk
+  {
+    /// Number of rows in use.
+    std::size_t count{};
+    /// Actor of each row.
+    std::unique_ptr<class Actor*[]> actors{};
+    /// Component columns, column c of row r at c * ChunkCapacity + r.
+    std::unique_ptr<Component*[]> components{};
+  };
+
+  /// Actors holding one exact set of component types.
+  struct Archetype
+  {
+    /// Component types of the set.
+    ComponentMask mask{};
+    /// Number of component columns.
+    std::size_t columns{};
+    /// Number of rows over all chunks. Every chunk is full except the last in use.
+    std::size_t size{};
+    /// Chunks, kept allocated once emptied.
+    std::vector<Chunk> chunks{};
+  };
+
+private:
+  /// Returns column of type id in archetype of mask. Columns are ordered by type id.
+  /// @param mask Component types of the archetype.
+  /// @param id Component type id, part of mask.
+  static std::size_t columnOf(ComponentMask mask, ComponentTypeId id)
+  {
+    return static_cast<std::size_t>(std::popcount(mask & ((1ull << id) - 1)));
+  }
+  /// Returns indices of archetypes holding every type in mask, cached until the next archetype is created.
+  /// @param mask Component types.
+  const std::vector<std::uint32_t>& match(ComponentMask mask);
+  /// Returns index of archetype of mask, creating it if needed.
+  /// @param mask Component types.
+  std::uint32_t archetypeOf(ComponentMask mask);
+  /// Appends actor as the last row of archetype.
+  /// @param actor Actor.
+  /// @param archetype Index of archetype.
+  void insert(class Actor* actor, std::uint32_t archetype);
+  /// Removes row, moving the last row of its archetype into it.
+  /// @param location Archetype and row.
+  void erase(ArchetypeLocation location);
+
+private:
+  /// Every archetype in creation order.
+  std::vector<Archetype> mArchetypes{};
+  /// Index of archetype of each component set.
+  std::unordered_map<ComponentMask, std::uint32_t> mIndex{};
+  /// Cached query results by query mask.
+  std::unordered_map<ComponentMask, std::vector<std::uint32_t>> mQueries{};
+};
+
+}
+
+#endif
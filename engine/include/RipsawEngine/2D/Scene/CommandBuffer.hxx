@@ -0,0 +1,70 @@
+#ifndef D2_SCENE_COMMANDBUFFER_HXX
+#define D2_SCENE_COMMANDBUFFER_HXX
+
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+class CommandBuffer
+{
+public:
+  /// Callable receiving the actor a command applies to.
+  using ActorFunction = std::function<void(class Actor*)>;
+
+public:
+  /// Constructs empty command buffer.
+  /// @details Command buffer records structural changes to the scene, i.e. creating and destroying actors and adding components, so that code running on worker threads never changes shared engine containers. Engine keeps one buffer per job system thread and applies all of them on the main thread at the sync point of every simulation step, in thread order and, within one buffer, in recording order. Record through Engine::getCommandBuffer(), which hands out the buffer of the calling thread.
+  CommandBuffer() = default;
+  /// Records creation of an actor.
+  /// @param setup Called with the new actor once it exists, e.g. to create its components. May be empty.
+  void createActor(ActorFunction setup = {});
+  /// Records destruction of an actor. Stale and repeated handles are harmless.
+  /// @param actor Handle of actor.
+  void destroyActor(Handle actor);
+  /// Records a change to an actor, e.g. adding a component. Skipped if the actor is gone by the time commands are applied.
+  /// @param actor Handle of actor.
+  /// @param change Called with the actor.
+  void modifyActor(Handle actor, ActorFunction change);
+  /// Applies recorded commands to engine in recording order and clears the buffer.
+  /// @details Destroyed actors are only queued with Engine::destroyActor() and go away when the engine flushes them.
+  /// @param engine Engine the commands apply to.
+  void apply(class Engine& engine);
+  /// Returns number of recorded commands.
+  std::size_t size() const;
+  /// Returns True if no command is recorded.
+  bool isEmpty() const;
+  /// Drops recorded commands without applying them.
+  void clear();
+
+private:
+  /// Kind of recorded command.
+  enum class CommandType
+  {
+    Create,
+    Destroy,
+    Modify,
+  };
+  /// Recorded command.
+  struct Command
+  {
+    /// Kind of command.
+    CommandType type{};
+    /// Actor the command applies to, unused for creation.
+    Handle actor{};
+    /// Setup or change callable, empty for destruction.
+    ActorFunction function{};
+  };
+
+private:
+  /// Recorded commands.
+  std::vector<Command> mCommands{};
+};
+
+}
+
+#endif
@@ -1,9 +1,62 @@
 #ifndef D2_SCENE_COMPONENT_HXX
 #define D2_SCENE_COMPONENT_HXX
 
+#include <concepts>
+#include <cstdint>
+
 namespace RipsawEngine
 {
 
+/// Set of component types, one bit each, used by systems to declare what they read and write.
+using ComponentMask = std::uint64_t;
+
+/// Compile-time id of a component type, the index of its bit in @ref ComponentMask.
+using ComponentTypeId = unsigned;
+
+/// Ids of the component types and shared engine data known to the engine.
+/// @details A component type gets its id by declaring it as `static constexpr ComponentTypeId TypeId`, see @ref TypedComponent. Games number their own component types from @ref FirstUser up; two types declaring the same id are caught by @ref componentTypeId().
+namespace ComponentTypeIds
+{
+  /// @ref TransformComponent.
+  inline constexpr ComponentTypeId Transform{0};
+  /// @ref SpriteComponent, held by every sprite including derived ones.
+  inline constexpr ComponentTypeId Sprite{1};
+  /// @ref SpatialHash of the engine. Not a component type, but declared by systems like one.
+  inline constexpr ComponentTypeId Spatial{2};
+  /// @ref SpritesheetComponent.
+  inline constexpr ComponentTypeId Spritesheet{3};
+  /// @ref ParticleEmitterComponent.
+  inline constexpr ComponentTypeId ParticleEmitter{4};
+  /// @ref TilemapComponent.
+  inline constexpr ComponentTypeId Tilemap{5};
+  /// First id free for game component types.
+  inline constexpr ComponentTypeId FirstUser{8};
+  /// Number of ids, i.e. bits of @ref ComponentMask.
+  inline constexpr ComponentTypeId Count{64};
+}
+
+/// Bits of the component types and shared engine data known to the engine.
+/// @details Games number bits of their own component types from @ref FirstUser up.
+namespace ComponentBits
+{
+  /// @ref TransformComponent data, i.e. @ref TransformSystem.
+  inline constexpr ComponentMask Transform{1ull << ComponentTypeIds::Transform};
+  /// @ref SpriteComponent and derived components.
+  inline constexpr ComponentMask Sprite{1ull << ComponentTypeIds::Sprite};
+  /// @ref SpatialHash of the engine.
+  inline constexpr ComponentMask Spatial{1ull << ComponentTypeIds::Spatial};
+  /// @ref SpritesheetComponent, on top of @ref Sprite.
+  inline constexpr ComponentMask Spritesheet{1ull << ComponentTypeIds::Spritesheet};
+  /// @ref ParticleEmitterComponent, i.e. its emitter in @ref ParticleSystem.
+  inline constexpr ComponentMask ParticleEmitter{1ull << ComponentTypeIds::ParticleEmitter};
+  /// @ref TilemapComponent, i.e. its tilemap in @ref TilemapSystem.
+  inline constexpr ComponentMask Tilemap{1ull << ComponentTypeIds::Tilemap};
+  /// First bit free for game component types.
+  inline constexpr unsigned FirstUser{ComponentTypeIds::FirstUser};
+  /// Every component type, for systems that may touch anything.
+  inline constexpr ComponentMask All{~0ull};
+}
+
 class Component
 {
 public:
@@ -20,6 +73,7 @@ public:
   /// Pointer to actor owning the component.
   class Actor* mOwner{nullptr};
   /// Updates component.
+  /// @details With Engine::setParallelUpdate() enabled, actors are updated concurrently, so update() may only change its own actor's components. Creating or destroying actors and adding components must be recorded into Engine::getCommandBuffer() instead.
   /// @param dt Delta-time.
   virtual void update(double dt);
   /// Overridable method that says if a specific component is valid.
@@ -27,6 +81,35 @@ public:
   virtual bool isComponentValid() const = 0;
 };
 
+/// Component type with a compile-time type id, declared as `static constexpr ComponentTypeId TypeId`.
+/// @details Ids are plain constants, so they need no RTTI and no registration at startup. A derived type inherits the id of its base unless it declares its own, and is then treated as its base by the typed API of @ref Actor.
+template <typename T>
+concept TypedComponent = std::derived_from<T, Component> and requires {
+  { T::TypeId } -> std::convertible_to<ComponentTypeId>;
+} and T::TypeId < ComponentTypeIds::Count;
+
+/// Bit of component type T in @ref ComponentMask.
+template <TypedComponent T>
+inline constexpr ComponentMask ComponentBit{1ull << T::TypeId};
+
+/// Claims type id for the component type declaring it.
+/// @details A declaration is told apart by the address of its `TypeId` member, which a derived type without an id of its own shares with its base. @ref ComponentTypeIds::Spatial is reserved for the spatial hash.
+/// @warning Throws runtime error if another declaration already claimed the id, or if the id is reserved.
+/// @param id Component type id.
+/// @param declaration Address of the `TypeId` member declaring it.
+/// @return id.
+ComponentTypeId claimComponentTypeId(ComponentTypeId id, const ComponentTypeId* declaration);
+
+/// Returns type id of component type T, claiming it on first use.
+/// @details Called by the typed API of @ref Actor and by Engine::each(), so two component types sharing an id throw the first time both are used, instead of one being cast to the other.
+/// @warning Throws runtime error if another component type declares the same id.
+template <TypedComponent T>
+ComponentTypeId componentTypeId()
+{
+  static const ComponentTypeId id{claimComponentTypeId(T::TypeId, &T::TypeId)};
+  return id;
+}
+
 }
 
 #endif
@@ -0,0 +1,57 @@
+#ifndef D2_SCENE_PARTICLEEMITTERCOMPONENT_HXX
+#define D2_SCENE_PARTICLEEMITTERCOMPONENT_HXX
+
+#include "Component.hxx"
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+#include "RipsawEngine/2D/Systems/ParticleSystem.hxx"
+
+#include <cstddef>
+#include <string>
+
+namespace RipsawEngine
+{
+
+class ParticleEmitterComponent : public Component
+{
+public:
+  /// Type id of particle emitter components.
+  static constexpr ComponentTypeId TypeId{ComponentTypeIds::ParticleEmitter};
+
+public:
+  /// Constructs particle emitter component with owning actor and emitter parameters.
+  /// @details Particle emitter component emits particles from the position of its actor, offset by ParticleEmitterConfig::offset. Particles are no actors: they live in the engine's @ref ParticleSystem, and the component only keeps a handle to its emitter there. Every particle of the emitter shares one texture, taken from the engine's @ref TextureCache.
+  /// @param actor Actor owning the component.
+  /// @param config Emitter parameters.
+  ParticleEmitterComponent(class Actor* actor, const ParticleEmitterConfig& config);
+  /// Destructs particle emitter component, removing its emitter with every live particle.
+  ~ParticleEmitterComponent();
+  /// Checks if ParticleEmitterComponent is valid.
+  bool isComponentValid() const override;
+  /// Emits particles at the next simulation step, on top of the emission rate.
+  /// @param count Number of particles; whatever doesn't fit into the emitter is dropped.
+  void burst(std::size_t count);
+  /// Starts or stops continuous emission. Live particles play out either way.
+  /// @param emitting Boolean flag to emit.
+  void setEmitting(bool emitting);
+  /// Returns True if emitting continuously.
+  bool isEmitting() const;
+  /// Sets particles emitted per second.
+  /// @param rate Particles per second.
+  void setRate(float rate);
+  /// Returns number of live particles.
+  std::size_t getParticleCount() const;
+
+private:
+  /// System simulating the particles.
+  class ParticleSystem* mParticleSystem{nullptr};
+  /// Handle to the emitter.
+  Handle mEmitter{};
+  /// Image file particles are drawn with, empty for plain colored squares.
+  std::string mImgFile{};
+  /// True if a texture reference is held in the texture cache.
+  bool mIsTextureAcquired{false};
+};
+
+}
+
+#endif
@@ -2,9 +2,13 @@
 #define D2_SCENE_SCENE_HXX
 
 #include "Actor.hxx"
+#include "ArchetypeStore.hxx"
+#include "CommandBuffer.hxx"
 #include "Component.hxx"
+#include "ParticleEmitterComponent.hxx"
 #include "SpriteComponent.hxx"
 #include "SpritesheetComponent.hxx"
+#include "TilemapComponent.hxx"
 #include "TransformComponent.hxx"
 
 #endif
@@ -2,11 +2,16 @@
 #define D2_SCENE_SPRITECOMPONENT_HXX
 
 #include "Component.hxx"
+#include "RipsawEngine/2D/Core/Pool.hxx"
+#include "RipsawEngine/2D/Systems/SpatialHash.hxx"
 
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 #include <glm/glm.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <future>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -16,12 +21,19 @@ namespace RipsawEngine
 
 class SpriteComponent : public RipsawEngine::Component
 {
+public:
+  /// Type id of sprite components, also held by every derived sprite.
+  static constexpr ComponentTypeId TypeId{ComponentTypeIds::Sprite};
+
 public:
   /// Constructs sprite component with owning actor, renderer, and image file.
+  /// @details Texture is taken from the engine's @ref TextureCache, so every sprite using the same image file shares one texture. With asynchronous loading the image is decoded by the engine's @ref AssetLoader and the sprite draws nothing until its texture is uploaded.
   /// @param actor Actor owning the component.
   /// @param renderer Renderer.
   /// @param imgfile Path to image file.
-  SpriteComponent(class Actor* actor, SDL_Renderer* renderer, const std::string& imgfile);
+  /// @param loadAsync Boolean flag to decode image in background instead of blocking.
+  /// @warning Texture size is zero while an asynchronous load is pending.
+  SpriteComponent(class Actor* actor, SDL_Renderer* renderer, const std::string& imgfile, bool loadAsync = false);
   /// Constructs sprite component with owning actor, renderer, rectangle size, and color.
   /// @param actor Actor owning the component.
   /// @param renderer Renderer.
@@ -30,15 +42,69 @@ public:
   SpriteComponent(class Actor* actor, SDL_Renderer* renderer, const glm::vec2& size = {}, const std::tuple<unsigned char, unsigned char, unsigned char, unsigned char>& color = {});
   /// Destructs SpriteComponent.
   ~SpriteComponent();
-  /// Checks if SpriteComponent is valid.
+  /// Allocates component storage from the sprite component pool.
+  /// @param size Size of object in bytes.
+  static void* operator new(std::size_t size);
+  /// Returns component storage to the sprite component pool.
+  /// @param ptr Object storage.
+  /// @param size Size of object in bytes.
+  static void operator delete(void* ptr, std::size_t size);
+  /// Returns occupancy of the sprite component pool.
+  static const PoolStats& getPoolStats();
+  /// Checks if SpriteComponent is valid. A sprite still loading its texture is valid.
   bool isComponentValid() const override;
+  /// Returns True while texture is being loaded asynchronously.
+  bool isLoading() const;
+  /// Returns slot of sprite in engine's sprite list.
+  std::size_t getSpriteIndex() const;
+  /// Sets slot of sprite in engine's sprite list. Maintained by engine.
+  /// @param index Slot index.
+  void setSpriteIndex(std::size_t index);
+  /// Returns draw layer.
+  std::uint8_t getLayer() const;
+  /// Sets draw layer. Higher layers are drawn above lower ones regardless of depth.
+  /// @param layer Draw layer.
+  void setLayer(std::uint8_t layer);
+  /// Returns depth within layer.
+  float getDepth() const;
+  /// Sets depth within layer. Higher depths are drawn above lower ones.
+  /// @param depth Depth within layer.
+  void setDepth(float depth);
+  /// Returns True if depth follows the bottom edge of the sprite.
+  bool isYSorted() const;
+  /// Makes depth follow the bottom edge of the sprite every frame, so that in top-down views whatever stands lower on screen is drawn in front.
+  /// @param ySorted Boolean flag to sort by Y.
+  void setYSorted(bool ySorted);
+  /// Returns key the render pass sorts sprites by.
+  /// @details From the most significant bits down: 8 bits layer, 32 bits depth, 4 bits blend mode, 16 bits texture id. Sprites in the same layer at the same depth are therefore grouped by blend mode and texture, which lets the sprite batch merge them; among equal keys, sprites are drawn in creation order.
+  std::uint64_t getSortKey() const;
   /// Returns mTexture.
   SDL_Texture* getTexture() const;
   /// Returns texture size.
   glm::vec2 getTexSize() const;
-  /// Draws texture on window.
+  /// Returns rectangle of image inside mTexture, which is an atlas page for packed images.
+  const SDL_FRect& getTexRegion() const;
+  /// Draws texture on window immediately with its own draw call.
   /// @param dt Delta-time.
   virtual void draw(double dt);
+  /// Advances per-frame visual state such as rotation.
+  /// @param dt Delta-time.
+  virtual void animate(double dt);
+  /// Returns region of image to be drawn in image pixels, relative to the image rather than to the texture holding it.
+  virtual SDL_FRect getSourceRect() const;
+  /// Returns screen rectangle covered by sprite before rotation.
+  SDL_FRect getDestRect() const;
+  /// Returns box covered by sprite, including scale and rotation, in world coordinates or in viewport pixels for screen-space sprites.
+  Aabb getBounds() const;
+  /// Returns True if sprite is positioned in viewport pixels rather than in the world.
+  bool isScreenSpace() const;
+  /// Positions sprite in viewport pixels, unaffected by camera movement, zoom, and rotation. Meant for backgrounds and HUD.
+  /// @param screenSpace Boolean flag to ignore the camera.
+  void setScreenSpace(bool screenSpace);
+  /// Copies everything needed to draw the sprite into a render packet entry. Visual state is advanced separately with animate().
+  /// @details This is the path used by @ref Engine::renderEngine(): sprites are snapshotted once per frame and drawn from the snapshots, so drawing never touches the sprite itself. A sprite whose texture isn't loaded yet leaves out.texture null and is skipped.
+  /// @param out Render packet entry.
+  void snapshot(struct SpriteSnapshot& out) const;
   /// Returns scale of texture.
   float getScale() const;
   /// Sets scale of texture.
@@ -74,10 +140,23 @@ protected:
   SDL_Renderer* getRenderer() const;
   /// Returns flip state mFlipState.
   SDL_FlipMode getFlipState() const;
+  /// Returns texture size without scale applied.
+  glm::vec2 getSourceTexSize() const;
+  /// Returns screen rectangle covered by sprite before rotation as seen through camera.
+  /// @param camera Camera the sprite is seen through.
+  /// @param angle Rotation of sprite on screen in degrees, written by this method.
+  SDL_FRect getScreenRect(const class Camera& camera, double& angle) const;
 
 public:
   /// Fits sprite covering entire screen preserving aspect ratio.
   void fitByAspectRatio();
+  /// Takes texture from texture cache once asynchronous load has finished.
+  /// @return True if texture is available.
+  bool pollTexture();
+  /// Acquires texture of mImgFile from texture cache.
+  void acquireTexture();
+  /// Updates texture and blend mode bits of sort key from mTexture.
+  void updateTextureKey();
   /// Normalizes angle in [0, 360) range.
   /// @param degrees Angle in degrees to be normalized.
   void normalizeDegrees(double& degrees);
@@ -89,6 +168,14 @@ private:
   std::string mImgFile{};
   /// Main texture.
   SDL_Texture* mTexture{nullptr};
+  /// True if mTexture belongs to the texture cache rather than to this sprite.
+  bool mIsTextureShared{false};
+  /// Rectangle of image inside mTexture.
+  SDL_FRect mTexRegion{};
+  /// Pending asynchronous load, invalid if none.
+  std::shared_future<bool> mLoading{};
+  /// Position of sprite in engine's draw order.
+  std::size_t mSpriteIndex{};
   /// Texture size.
   glm::vec2 mTexSize{};
   /// Modified texture dimension after scale change.
@@ -103,6 +190,16 @@ private:
   bool mHasRotated{false};
   /// Current flip state of sprite.
   SDL_FlipMode mFlipState{SDL_FLIP_NONE};
+  /// True if sprite is positioned in viewport pixels.
+  bool mIsScreenSpace{false};
+  /// Draw layer.
+  std::uint8_t mLayer{};
+  /// Depth within layer.
+  float mDepth{};
+  /// True if depth follows the bottom edge of the sprite.
+  bool mIsYSorted{false};
+  /// Blend mode and texture id bits of sort key.
+  std::uint64_t mTextureKey{};
 };
 
 }
@@ -1,11 +1,14 @@
 #ifndef D2_SCENE_SPRITESHEETCOMPONENT_HXX
 #define D2_SCENE_SPRITESHEETCOMPONENT_HXX
 
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+#include "RipsawEngine/2D/Core/Pool.hxx"
 #include "RipsawEngine/2D/Scene/SpriteComponent.hxx"
 
 #include <SDL3/SDL.h>
 #include <glm/glm.hpp>
 
+#include <cstddef>
 #include <string>
 
 namespace RipsawEngine
@@ -13,6 +16,10 @@ namespace RipsawEngine
 
 class SpritesheetComponent : public SpriteComponent
 {
+public:
+  /// Type id of spritesheet components, held on top of the sprite id.
+  static constexpr ComponentTypeId TypeId{ComponentTypeIds::Spritesheet};
+
 public:
   /// Constructs spritesheet component with owning actor, renderer, spritesheet image, dimension of spritesheet, and default rendering coordinate of spritesheet. 
   /// @param actor Actor owning the component.
@@ -20,26 +27,58 @@ public:
   /// @param imgfile Path to image file.
   /// @param dims Dimension of spritesheet.
   /// @param defaultCoord Default coordinate of spritesheet.
-  /// @param doAnimate Animation state.
+  /// @param doAnimate True to loop the row of defaultCoord from left to right.
   /// @param animFPS Animation FPS.
-  SpritesheetComponent(class Actor* actor, SDL_Renderer* renderer, const std::string& imgfile, const glm::ivec2& dims, const glm::ivec2& defaultCoord = {1, 1}, bool doAnimate = false, float animFPS = 24.f);
-  /// Draws texture on window.
-  /// @param dt Delta-time.
-  void draw(double dt) override;
-  /// Changes default coordinate of spritesheet.
+  /// @param loadAsync Boolean flag to decode image in background instead of blocking.
+  SpritesheetComponent(class Actor* actor, SDL_Renderer* renderer, const std::string& imgfile, const glm::ivec2& dims, const glm::ivec2& defaultCoord = {1, 1}, bool doAnimate = false, float animFPS = 24.f, bool loadAsync = false);
+  /// Destructs spritesheet component, removing its animator.
+  ~SpritesheetComponent();
+  /// Allocates component storage from the spritesheet component pool.
+  /// @param size Size of object in bytes.
+  static void* operator new(std::size_t size);
+  /// Returns component storage to the spritesheet component pool.
+  /// @param ptr Object storage.
+  /// @param size Size of object in bytes.
+  static void operator delete(void* ptr, std::size_t size);
+  /// Returns occupancy of the spritesheet component pool.
+  static const PoolStats& getPoolStats();
+  /// Returns rectangle of current spritesheet cell in texture pixels: the animator's cell if animated, the default coordinate otherwise.
+  SDL_FRect getSourceRect() const override;
+  /// Changes default coordinate of spritesheet and stops animation.
   void changeCoord(const glm::ivec2& coord) override;
+  /// Animates spritesheet with an animation set, starting from its initial clip. See @ref AnimationSystem.
+  /// @param name Name of a set registered with Engine::getAnimationSystem().
+  /// @return True if the set is registered.
+  /// @warning Adds an animator, so while updating in parallel it has to go through the command buffer like adding a component. The other animation methods only touch this sprite's animator and are safe from its own actor's update.
+  bool setAnimationSet(const std::string& name);
+  /// Returns True if spritesheet is animated.
+  bool isAnimated() const;
+  /// Switches to clip right away. See AnimationSystem::play().
+  /// @param clip Clip name.
+  void playAnimation(const std::string& clip);
+  /// Fires animation trigger. See AnimationSystem::trigger().
+  /// @param trigger Trigger name.
+  void triggerAnimation(const std::string& trigger);
+  /// Returns name of the current clip, empty if not animated.
+  std::string getAnimationState() const;
+  /// Returns True if a Once clip has played to its end.
+  bool isAnimationFinished() const;
+  /// Pauses or resumes animation.
+  /// @param paused Boolean flag to pause.
+  void setAnimationPaused(bool paused);
+  /// Sets animation speed factor, 1 for the frame durations of the clips.
+  /// @param speed Speed factor.
+  void setAnimationSpeed(float speed);
 
 private:
   /// Dimension of spritesheet in {col, row} where col is number of sprites horizontally, and row is number of sprites vertically.
   glm::ivec2 mDims{};
-  /// Default coordinate of spritesheet.
+  /// Default coordinate of spritesheet, shown while not animated.
   glm::ivec2 mDefaultCoord{1, 1};
-  /// Animation state.
-  bool mDoAnimate{false};
-  /// Animation FPS.
-  float mAnimFPS{24.f};
-  /// Current animation frame in spritesheet.
-  double mCurrentFrame{1};
+  /// System playing the animation.
+  class AnimationSystem* mAnimationSystem{nullptr};
+  /// Handle to the animator, null if not animated.
+  Handle mAnimator{};
 };
 
 }
@@ -0,0 +1,64 @@
+#ifndef D2_SCENE_TILEMAPCOMPONENT_HXX
+#define D2_SCENE_TILEMAPCOMPONENT_HXX
+
+#include "Component.hxx"
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+#include "RipsawEngine/2D/Systems/TilemapSystem.hxx"
+
+#include <glm/glm.hpp>
+
+#include <string>
+
+namespace RipsawEngine
+{
+
+class TilemapComponent : public Component
+{
+public:
+  /// Type id of tilemap components.
+  static constexpr ComponentTypeId TypeId{ComponentTypeIds::Tilemap};
+
+public:
+  /// Constructs tilemap component with owning actor and tilemap parameters.
+  /// @details Tilemap component lays a grid of tiles from one tileset out from the position of its actor, which is the top left corner of the map. Tiles are no actors: they live in the engine's @ref TilemapSystem, and the component only keeps a handle to its tilemap there. The tileset is taken from the engine's @ref TextureCache. Every cell starts empty.
+  /// @param actor Actor owning the component.
+  /// @param config Tilemap parameters.
+  TilemapComponent(class Actor* actor, const TilemapConfig& config);
+  /// Destructs tilemap component, removing its tilemap.
+  ~TilemapComponent();
+  /// Checks if TilemapComponent is valid.
+  bool isComponentValid() const override;
+  /// Sets tile of cell. Only the chunk holding the cell is rebuilt.
+  /// @param cell Column and row of the cell.
+  /// @param tile Tile id, @ref EmptyTile to clear the cell.
+  /// @return False if cell is outside the map or tile isn't in the tileset.
+  bool setTile(const glm::ivec2& cell, TileId tile);
+  /// Returns tile of cell, @ref EmptyTile outside the map.
+  /// @param cell Column and row of the cell.
+  TileId getTile(const glm::ivec2& cell) const;
+  /// Sets every cell to tile.
+  /// @param tile Tile id, @ref EmptyTile to clear the map.
+  /// @return False if tile isn't in the tileset.
+  bool fill(TileId tile);
+  /// Returns width and height of the map in tiles.
+  glm::ivec2 getMapSize() const;
+  /// Returns width and height of one tile in world units.
+  glm::vec2 getTileSize() const;
+  /// Returns cell covering world position, which may lie outside the map.
+  /// @param pos Position in world coordinates.
+  glm::ivec2 worldToCell(const glm::vec2& pos) const;
+
+private:
+  /// System holding the tiles.
+  class TilemapSystem* mTilemapSystem{nullptr};
+  /// Handle to the tilemap.
+  Handle mTilemap{};
+  /// Tileset image file, empty for plain white squares.
+  std::string mImgFile{};
+  /// True if a texture reference is held in the texture cache.
+  bool mIsTextureAcquired{false};
+};
+
+}
+
+#endif
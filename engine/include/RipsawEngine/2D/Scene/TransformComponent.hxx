@@ -2,43 +2,68 @@
 #define D2_SCENE_TRANSFORMCOMPONENT_HXX
 
 #include "Component.hxx"
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+#include "RipsawEngine/2D/Core/Pool.hxx"
 
 #include <glm/glm.hpp>
 
+#include <cstddef>
+
 namespace RipsawEngine
 {
 
 class TransformComponent : public Component
 {
+public:
+  /// Type id of transform components.
+  static constexpr ComponentTypeId TypeId{ComponentTypeIds::Transform};
+
 public:
   /// @brief Constructs transform component with owning actor, position, and velocity.
+  /// @details Transform component does not hold position and velocity itself. They live in the engine's @ref TransformSystem as packed structure-of-arrays buffers, and the component only keeps a handle to its entry. This lets the engine integrate every transform in one vectorized pass instead of updating each component through its actor.
   /// @param actor Owning actor of transform component.
   /// @param pos Position of actor.
   /// @param vel Velocity of actor.
   TransformComponent(class Actor* actor, const glm::vec2& pos = {}, const glm::vec2& vel = {});
   /// Destructs transform component.
   ~TransformComponent();
+  /// Allocates component storage from the transform component pool.
+  /// @param size Size of object in bytes.
+  static void* operator new(std::size_t size);
+  /// Returns component storage to the transform component pool.
+  /// @param ptr Object storage.
+  /// @param size Size of object in bytes.
+  static void operator delete(void* ptr, std::size_t size);
+  /// Returns occupancy of the transform component pool.
+  static const PoolStats& getPoolStats();
   /// Checks if TransformComponent is valid.
   bool isComponentValid() const override;
-  /// Updates transform component.
-  /// @param dt Delta-time.
-  void update(double dt) override;
   /// Returns position.
   glm::vec2 getPosition() const;
   /// Sets position.
   /// @param pos Position.
   void setPosition(const glm::vec2& pos);
+  /// Sets position without interpolating from the old one when the engine runs at a fixed timestep.
+  /// @param pos Position.
+  void teleport(const glm::vec2& pos);
+  /// Returns position to be drawn, interpolated between the last two ticks when the engine runs at a fixed timestep.
+  glm::vec2 getRenderPosition() const;
   /// Returns velocity.
   glm::vec2 getVelocity() const;
   /// Sets velocity.
   /// @param vel Velocity.
   void setVelocity(const glm::vec2& vel);
+  /// Gives actor a bounding box centered on its position, so that the engine's @ref SpatialHash reports the actor's handle.
+  /// @param size Width and height of bounding box.
+  void setBounds(const glm::vec2& size);
+  /// Removes bounding box, hiding actor from spatial queries.
+  void clearBounds();
 
 private:
-  /// Position.
-  glm::vec2 mPos{};
-  /// Velocity.
-  glm::vec2 mVel{};
+  /// Transform system owned by engine.
+  class TransformSystem* mSystem{nullptr};
+  /// Handle to the packed transform data.
+  Handle mHandle{};
 };
 
 }
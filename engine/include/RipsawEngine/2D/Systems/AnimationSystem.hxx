@@ -0,0 +1,247 @@
+#ifndef D2_SYSTEMS_ANIMATIONSYSTEM_HXX
+#define D2_SYSTEMS_ANIMATIONSYSTEM_HXX
+
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+#include "RipsawEngine/2D/Core/JobSystem.hxx"
+#include "RipsawEngine/2D/Render/Camera.hxx"
+#include "RipsawEngine/2D/Systems/SpatialHash.hxx"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// How a clip continues after its last frame.
+enum class AnimationMode
+{
+  /// Starts over from the first frame.
+  Loop,
+  /// Stays on the last frame and finishes.
+  Once,
+  /// Plays backwards to the first frame, then forwards again.
+  PingPong,
+};
+
+/// One frame of a clip.
+struct AnimationFrame
+{
+  /// Spritesheet cell in {col, row}, starting from {1, 1}.
+  glm::ivec2 coord{1, 1};
+  /// Time the frame is shown, in seconds.
+  float duration{};
+};
+
+/// Named sequence of spritesheet cells.
+struct AnimationClip
+{
+  /// Clip name, unique within its set.
+  std::string name{};
+  /// Frames in playing order.
+  std::vector<AnimationFrame> frames{};
+  /// What happens after the last frame.
+  AnimationMode mode{AnimationMode::Loop};
+  /// Returns clip playing cells of one spritesheet row from left to right, each for the same time.
+  /// @param name Clip name.
+  /// @param row Row of spritesheet, starting from 1.
+  /// @param columns Number of cells in the row.
+  /// @param fps Frames per second.
+  /// @param mode What happens after the last frame.
+  static AnimationClip fromRow(const std::string& name, int row, int columns, float fps, AnimationMode mode = AnimationMode::Loop);
+};
+
+/// Switch from one clip to another.
+struct AnimationTransition
+{
+  /// Clip the transition leaves, empty for any clip.
+  std::string from{};
+  /// Clip the transition enters.
+  std::string to{};
+  /// Trigger firing the transition, see AnimationSystem::trigger(). Empty to fire when a Once clip finishes.
+  std::string trigger{};
+};
+
+/// Clips and transitions forming one animation state machine, e.g. everything a character can do.
+struct AnimationSet
+{
+  /// Clips, each a state of the machine.
+  std::vector<AnimationClip> clips{};
+  /// Transitions between clips, checked in order.
+  std::vector<AnimationTransition> transitions{};
+  /// Clip entered first, empty for the first clip.
+  std::string initial{};
+};
+
+class AnimationSystem
+{
+public:
+  /// Constructs animation system without sets or animators.
+  /// @details Animation system plays spritesheet animations of every @ref SpritesheetComponent. Sets are registered once by name and shared by any number of animators; an animator is the per-sprite state: current clip, frame, and time into it. Engine advances all animators in one batched pass per simulation step, after Game::updateGame(), so animation follows simulation time, stops with a paused engine, and runs at the fixed tick rate if there is one. Rendering only reads the resulting cells.
+  AnimationSystem() = default;
+  /// Registers animation set.
+  /// @details Logs an error and returns False if the name is taken, a clip has no frames or a frame a non-positive duration, or a transition or the initial clip names an unknown clip.
+  /// @param name Set name.
+  /// @param set Clips and transitions.
+  /// @return True if the set was registered.
+  bool addSet(const std::string& name, const AnimationSet& set);
+  /// Returns True if a set with name is registered.
+  /// @param name Set name.
+  bool hasSet(const std::string& name) const;
+  /// Adds animator playing the initial clip of a set.
+  /// @param setName Name of a registered set.
+  /// @param sprite Sprite animated, used to skip off-screen animators. See setCulling().
+  /// @return Handle to the animator, null if the set isn't registered.
+  Handle create(const std::string& setName, const class SpriteComponent* sprite);
+  /// Removes animator. Stale handles are ignored.
+  /// @param handle Handle to the animator.
+  void destroy(Handle handle);
+  /// Returns True if handle refers to a live animator.
+  /// @param handle Handle to the animator.
+  bool isValid(Handle handle) const;
+  /// Switches animator to a clip right away, from its first frame.
+  /// @param handle Handle to the animator.
+  /// @param clip Clip name. Unknown names log an error.
+  void play(Handle handle, const std::string& clip);
+  /// Fires a trigger of animator, taken at its next update by the first transition it matches, if any.
+  /// @details A trigger not taken by that update is dropped; a later trigger before the update replaces it.
+  /// @param handle Handle to the animator.
+  /// @param trigger Trigger name. Names no transition of the set uses log an error.
+  void trigger(Handle handle, const std::string& trigger);
+  /// Returns name of the current clip of animator.
+  /// @param handle Handle to the animator.
+  const std::string& getState(Handle handle) const;
+  /// Returns True if animator played a Once clip to its end.
+  /// @param handle Handle to the animator.
+  bool isFinished(Handle handle) const;
+  /// Pauses or resumes animator. Triggers are still taken while paused.
+  /// @param handle Handle to the animator.
+  /// @param paused Boolean flag to pause.
+  void setPaused(Handle handle, bool paused);
+  /// Sets playback speed of animator, 1 for the frame durations of its clips.
+  /// @param handle Handle to the animator.
+  /// @param speed Speed factor, clamped to non-negative.
+  void setSpeed(Handle handle, float speed);
+  /// Returns spritesheet cell currently shown by animator.
+  /// @param handle Handle to the animator.
+  glm::ivec2 getCoord(Handle handle) const;
+  /// Enables or disables skipping animators of sprites outside every camera view. Disabled by default.
+  /// @details A skipped animator banks the time it missed and catches up on the first update its sprite is back in view, so it shows the same cell it would have shown anyway; whole cycles of repeating clips are dropped, so catching up costs at most one cycle of frames. What gets delayed is everything observable while off screen: triggers are still taken, but a Once clip finishes, and its finish transition fires, only once the sprite is in view again. Screen-space sprites always count as visible.
+  /// @param culling Boolean flag to skip off-screen animators.
+  void setCulling(bool culling);
+  /// Returns True if off-screen animators are skipped.
+  bool isCulling() const;
+  /// Advances every animator.
+  /// @details Animators are independent, so they are updated in parallel on the job system.
+  /// @param dt Delta-time.
+  /// @param cameras Cameras deciding what is on screen when culling.
+  /// @param jobs Job system.
+  void update(double dt, const std::vector<Camera>& cameras, JobSystem& jobs);
+  /// Returns number of live animators.
+  std::size_t size() const;
+  /// Removes every animator and set.
+  void clear();
+
+private:
+  /// Clip with names resolved.
+  struct Clip
+  {
+    /// Clip name.
+    std::string name{};
+    /// Frames in playing order.
+    std::vector<AnimationFrame> frames{};
+    /// What happens after the last frame.
+    AnimationMode mode{AnimationMode::Loop};
+    /// Time after which a repeating clip is back in the same state, 0 for Once clips.
+    float period{};
+  };
+
+  /// Transition with names resolved to indices.
+  struct Transition
+  {
+    /// Index of clip left, AnyClip for any.
+    std::uint32_t from{};
+    /// Index of clip entered.
+    std::uint32_t to{};
+    /// Index of trigger in Set::triggers, NoTrigger to fire when a Once clip finishes.
+    std::int32_t trigger{};
+  };
+
+  /// Set with names resolved.
+  struct Set
+  {
+    /// Clips.
+    std::vector<Clip> clips{};
+    /// Transitions, checked in order.
+    std::vector<Transition> transitions{};
+    /// Names of triggers used by transitions.
+    std::vector<std::string> triggers{};
+    /// Index of clip entered first.
+    std::uint32_t initial{};
+  };
+
+  /// Playback state of one sprite.
+  struct Animator
+  {
+    /// Set played, owned by mSets.
+    const Set* set{nullptr};
+    /// Sprite animated.
+    const class SpriteComponent* sprite{nullptr};
+    /// Index of current clip.
+    std::uint32_t clip{};
+    /// Index of current frame in the clip.
+    std::uint32_t frame{};
+    /// Time spent in the current frame, in seconds.
+    float time{};
+    /// Time missed while skipped, in seconds.
+    float banked{};
+    /// Playback speed factor.
+    float speed{1.f};
+    /// Trigger to take at the next update, NoTrigger if none.
+    std::int32_t trigger{NoTrigger};
+    /// +1 playing forwards, -1 playing backwards.
+    std::int8_t direction{1};
+    /// True if a Once clip has played to its end.
+    bool isFinished{false};
+    /// True if paused.
+    bool isPaused{false};
+  };
+
+  /// Clip index of transitions leaving any clip.
+  static constexpr std::uint32_t AnyClip{UINT32_MAX};
+  /// Trigger index of transitions fired when a Once clip finishes.
+  static constexpr std::int32_t NoTrigger{-1};
+
+private:
+  /// Switches animator to the first frame of clip.
+  /// @param animator Animator.
+  /// @param clip Index of clip.
+  static void enter(Animator& animator, std::uint32_t clip);
+  /// Moves animator forward in time, following finish transitions.
+  /// @param animator Animator.
+  /// @param time Time in seconds.
+  static void advance(Animator& animator, float time);
+  /// Returns True if sprite overlaps a view in mViews, or is drawn in screen space.
+  /// @param sprite Sprite.
+  bool isOnScreen(const class SpriteComponent* sprite) const;
+
+private:
+  /// Registered sets by name. Node-based, so animators can point into it.
+  std::unordered_map<std::string, Set> mSets{};
+  /// Handle bookkeeping.
+  HandleTable mTable{};
+  /// Every animator, packed.
+  std::vector<Animator> mAnimators{};
+  /// True if off-screen animators are skipped.
+  bool mIsCulling{false};
+  /// World views of the cameras of the current update.
+  std::vector<Aabb> mViews{};
+};
+
+}
+
+#endif
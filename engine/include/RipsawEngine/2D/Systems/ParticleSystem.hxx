@@ -0,0 +1,165 @@
+#ifndef D2_SYSTEMS_PARTICLESYSTEM_HXX
+#define D2_SYSTEMS_PARTICLESYSTEM_HXX
+
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+#include "RipsawEngine/2D/Core/JobSystem.hxx"
+#include "RipsawEngine/2D/Render/RenderPacket.hxx"
+#include "RipsawEngine/2D/Render/TextureAtlas.hxx"
+
+#include <SDL3/SDL.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Parameters of a particle emitter.
+struct ParticleEmitterConfig
+{
+  /// Image file every particle is drawn with, shared through the texture cache. Empty to draw plain colored squares.
+  std::string imgfile{};
+  /// Most particles alive at once. Storage for all of them is allocated up front; nothing is emitted while full.
+  std::size_t maxParticles{1024};
+  /// Particles emitted per second, 0 to emit only bursts.
+  float rate{};
+  /// Shortest and longest lifetime in seconds.
+  glm::vec2 lifetime{1.f, 1.f};
+  /// Slowest and fastest initial speed in pixels per second.
+  glm::vec2 speed{50.f, 100.f};
+  /// Direction of emission in degrees, clockwise from +X with Y growing downwards.
+  float direction{-90.f};
+  /// Total angle in degrees directions are spread over, centered on direction. 360 emits in every direction.
+  float spread{360.f};
+  /// Acceleration of every particle in pixels per second squared.
+  glm::vec2 gravity{};
+  /// Smallest and largest size at birth in pixels.
+  glm::vec2 size{4.f, 4.f};
+  /// Size at death relative to size at birth.
+  float endScale{1.f};
+  /// Color at birth.
+  SDL_FColor startColor{1.f, 1.f, 1.f, 1.f};
+  /// Color at death; colors in between are interpolated over lifetime.
+  SDL_FColor endColor{1.f, 1.f, 1.f, 0.f};
+  /// Emission point relative to the position of the owning actor.
+  glm::vec2 offset{};
+  /// Draw layer, as SpriteComponent::setLayer().
+  std::uint8_t layer{};
+  /// Depth within layer, as SpriteComponent::setDepth().
+  float depth{};
+};
+
+class ParticleSystem
+{
+public:
+  /// Constructs particle system without emitters.
+  /// @details Particle system simulates the particles of every @ref ParticleEmitterComponent without any actor or component per particle. Each emitter keeps its particles in fixed-capacity structure-of-arrays pools: position, velocity, age, lifetime, and size, each in its own packed float buffer. Engine advances all emitters once per simulation step, after Game::updateGame(), with SIMD kernels over whole buffers; dead particles are recycled by swapping the last live one into their slot, so steady-state emission never allocates. Emitters are independent and updated in parallel on the job system. Color and size over lifetime are evaluated when particles are copied into the render packet, and all particles of an emitter are drawn with a single SDL_RenderGeometry() call, layered against sprites by the same sort key.
+  ParticleSystem() = default;
+  /// Adds emitter.
+  /// @param config Emitter parameters.
+  /// @param region Texture region particles are drawn with, null texture for plain colored squares.
+  /// @param actor Actor owning the emitter, whose position particles are emitted from.
+  /// @return Handle to the emitter.
+  Handle create(const ParticleEmitterConfig& config, const TextureRegion& region, const class Actor* actor);
+  /// Removes emitter with its particles. Stale handles are ignored.
+  /// @param handle Handle to the emitter.
+  void destroy(Handle handle);
+  /// Returns True if handle refers to a live emitter.
+  /// @param handle Handle to the emitter.
+  bool isValid(Handle handle) const;
+  /// Emits particles at the next update, on top of the emission rate.
+  /// @param handle Handle to the emitter.
+  /// @param count Number of particles; whatever doesn't fit is dropped.
+  void burst(Handle handle, std::size_t count);
+  /// Starts or stops continuous emission. Live particles play out either way.
+  /// @param handle Handle to the emitter.
+  /// @param emitting Boolean flag to emit.
+  void setEmitting(Handle handle, bool emitting);
+  /// Returns True if emitter emits continuously.
+  /// @param handle Handle to the emitter.
+  bool isEmitting(Handle handle) const;
+  /// Sets particles emitted per second.
+  /// @param handle Handle to the emitter.
+  /// @param rate Particles per second, clamped to non-negative.
+  void setRate(Handle handle, float rate);
+  /// Returns number of live particles of emitter.
+  /// @param handle Handle to the emitter.
+  std::size_t getParticleCount(Handle handle) const;
+  /// Returns number of live particles of every emitter.
+  std::size_t getParticleCount() const;
+  /// Ages, moves, retires, and emits particles of every emitter.
+  /// @param dt Delta-time.
+  /// @param jobs Job system.
+  void update(double dt, JobSystem& jobs);
+  /// Copies live particles of every emitter into packet, one batch per emitter, batches ordered by key.
+  /// @param packet Render packet.
+  /// @param jobs Job system.
+  void extract(RenderPacket& packet, JobSystem& jobs) const;
+  /// Returns number of live emitters.
+  std::size_t size() const;
+
+private:
+  /// Emitter with its particle pools. Pools have the capacity of the emitter; the first count entries are alive.
+  struct Emitter
+  {
+    /// Parameters.
+    ParticleEmitterConfig config{};
+    /// Actor owning the emitter.
+    const class Actor* actor{nullptr};
+    /// Texture, nullptr for plain colored squares.
+    SDL_Texture* texture{nullptr};
+    /// Source rectangle in texture pixels.
+    SDL_FRect src{};
+    /// Sort key of the batch.
+    std::uint64_t key{};
+    /// X components of positions.
+    std::vector<float> posX{};
+    /// Y components of positions.
+    std::vector<float> posY{};
+    /// X components of velocities.
+    std::vector<float> velX{};
+    /// Y components of velocities.
+    std::vector<float> velY{};
+    /// Time since birth in seconds.
+    std::vector<float> age{};
+    /// Lifetime in seconds.
+    std::vector<float> lifetime{};
+    /// Size at birth.
+    std::vector<float> size{};
+    /// Number of live particles.
+    std::size_t count{};
+    /// Fraction of a particle owed by the emission rate.
+    float pending{};
+    /// Particles to emit at the next update on top of the rate.
+    std::size_t burst{};
+    /// State of the random generator.
+    std::uint32_t seed{};
+    /// True if emitting continuously.
+    bool isEmitting{true};
+  };
+
+private:
+  /// Advances particles of emitter.
+  /// @param emitter Emitter.
+  /// @param dt Delta-time.
+  static void step(Emitter& emitter, float dt);
+  /// Emits particles from the current position of the owning actor.
+  /// @param emitter Emitter.
+  /// @param count Number of particles, fitting into the pools.
+  static void emit(Emitter& emitter, std::size_t count);
+
+private:
+  /// Handle bookkeeping.
+  HandleTable mTable{};
+  /// Every emitter, packed.
+  std::vector<Emitter> mEmitters{};
+  /// Seed of the next emitter.
+  std::uint32_t mNextSeed{0x9E3779B9u};
+};
+
+}
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef D2_SYSTEMS_SPATIALHASH_HXX
+#define D2_SYSTEMS_SPATIALHASH_HXX
+
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Axis-aligned bounding box.
+struct Aabb
+{
+  /// Corner with the smallest coordinates.
+  glm::vec2 min{};
+  /// Corner with the largest coordinates.
+  glm::vec2 max{};
+  /// Returns True if both boxes overlap, touching edges included.
+  /// @param other Other box.
+  bool overlaps(const Aabb& other) const;
+};
+
+/// Closest proxy hit by a ray.
+struct RayHit
+{
+  /// User data of the proxy hit.
+  Handle userData{};
+  /// Distance from ray origin to the hit point.
+  float distance{};
+};
+
+/// Counters exposed by @ref SpatialHash.
+struct SpatialHashStats
+{
+  /// Number of proxies.
+  std::size_t proxies{};
+  /// Number of occupied cells.
+  std::size_t cells{};
+  /// Proxy moves since the last resetStats() that had to change cells.
+  std::size_t rebinned{};
+  /// Proxy moves since the last resetStats() that stayed in the same cells.
+  std::size_t moved{};
+};
+
+class SpatialHash
+{
+public:
+  /// Default cell edge length in world units.
+  static constexpr float DefaultCellSize{128.f};
+
+public:
+  /// Constructs empty spatial hash.
+  /// @details Spatial hash is a uniform grid of square cells of which only the occupied ones are stored, in a hash map keyed by cell coordinates, so the world has no fixed extent. Every proxy, a bounding box plus a handle of user data, is listed in each cell its box overlaps. Moving a proxy only touches the grid when the set of cells it overlaps changes, so keeping the grid current costs O(moved proxies). Queries visit just the cells they overlap. Cells should be about as big as typical proxies; a proxy much bigger than a cell is listed in many cells.
+  /// @details Queries keep no scratch state; a proxy listed in several cells is reported only from the first of them the query visits. So queries may run concurrently with each other, as systems reading @ref ComponentBits::Spatial and actors updated in parallel do.
+  /// @warning Queries must not run concurrently with inserting, updating, or removing proxies.
+  /// @param cellSize Cell edge length in world units.
+  explicit SpatialHash(float cellSize = DefaultCellSize);
+  /// Adds proxy.
+  /// @param bounds Bounding box of proxy.
+  /// @param userData Handle returned by queries for this proxy, e.g. an actor handle.
+  /// @return Handle to the proxy.
+  Handle insert(const Aabb& bounds, Handle userData);
+  /// Moves proxy to new bounds. Stale handles are ignored.
+  /// @param proxy Handle to the proxy.
+  /// @param bounds New bounding box.
+  void update(Handle proxy, const Aabb& bounds);
+  /// Removes proxy. Stale handles are ignored.
+  /// @param proxy Handle to the proxy.
+  void remove(Handle proxy);
+  /// Returns True if handle refers to a live proxy.
+  /// @param proxy Handle to the proxy.
+  bool isValid(Handle proxy) const;
+  /// Appends user data of every proxy overlapping rect to out, each once.
+  /// @param rect Query rectangle.
+  /// @param out Output list.
+  void queryRect(const Aabb& rect, std::vector<Handle>& out) const;
+  /// Appends user data of every proxy overlapping circle to out, each once.
+  /// @param center Center of circle.
+  /// @param radius Radius of circle.
+  /// @param out Output list.
+  void queryRadius(const glm::vec2& center, float radius, std::vector<Handle>& out) const;
+  /// Finds the proxy a ray hits first.
+  /// @details Walks the cells along the ray in order and stops at the first cell that can't contain anything closer than the best hit so far, or once the ray has left the range of occupied cells for good. The walk is therefore bounded by the extent of the proxies even for an infinite maxDistance. Proxies containing the origin are hit at distance 0.
+  /// @param origin Ray origin.
+  /// @param direction Ray direction, need not be normalized.
+  /// @param maxDistance Maximum distance along the ray, may be infinite. NaN or not positive hits nothing.
+  /// @param hit Closest hit, written only if something was hit.
+  /// @return True if something was hit.
+  bool raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, RayHit& hit) const;
+  /// Appends user data of every pair of overlapping proxies to out, each pair once.
+  /// @details This is the broad phase for collision: narrow-phase tests only need to run on the returned pairs.
+  /// @param out Output list.
+  void queryPairs(std::vector<std::pair<Handle, Handle>>& out) const;
+  /// Removes every proxy.
+  void clear();
+  /// Returns cell edge length in world units.
+  float getCellSize() const;
+  /// Returns counters.
+  SpatialHashStats getStats() const;
+  /// Resets move counters.
+  void resetStats();
+
+private:
+  /// Inclusive range of cell coordinates.
+  struct CellRange
+  {
+    /// Smallest cell coordinates.
+    glm::ivec2 min{};
+    /// Largest cell coordinates.
+    glm::ivec2 max{};
+    /// Returns True if cell lies in range.
+    /// @param cell Cell coordinates.
+    bool contains(const glm::ivec2& cell) const;
+    bool operator==(const CellRange&) const = default;
+  };
+  /// Stable proxy slot.
+  struct Proxy
+  {
+    /// Bounding box.
+    Aabb bounds{};
+    /// User data returned by queries.
+    Handle userData{};
+    /// Cells the proxy is listed in.
+    CellRange cells{};
+    /// Current generation of slot.
+    std::uint32_t generation{};
+    /// True if slot holds a proxy.
+    bool isAlive{false};
+    /// Next free slot while the slot is free.
+    std::uint32_t nextFree{Handle::InvalidIndex};
+  };
+
+private:
+  /// Returns cells overlapped by box.
+  /// @param bounds Box.
+  CellRange cellsOf(const Aabb& bounds) const;
+  /// Returns cell containing point.
+  /// @param point Point.
+  glm::ivec2 cellOf(const glm::vec2& point) const;
+  /// Returns hash map key of cell.
+  /// @param cell Cell coordinates.
+  static std::uint64_t keyOf(const glm::ivec2& cell);
+  /// Lists slot in every cell of range.
+  /// @param slot Proxy slot.
+  /// @param range Cell range.
+  /// @param skip Cells to leave alone, nullptr if none.
+  void link(std::uint32_t slot, const CellRange& range, const CellRange* skip = nullptr);
+  /// Removes slot from every cell of range.
+  /// @param slot Proxy slot.
+  /// @param range Cell range.
+  /// @param skip Cells to leave alone, nullptr if none.
+  void unlink(std::uint32_t slot, const CellRange& range, const CellRange* skip = nullptr);
+  /// Returns True if cell is the first cell of range listing slot, so a query over range reports the proxy there and nowhere else.
+  /// @param slot Proxy slot listed in cell.
+  /// @param range Cells visited by the query.
+  /// @param cell Cell of range.
+  bool isFirstCell(std::uint32_t slot, const CellRange& range, const glm::ivec2& cell) const;
+
+private:
+  /// Cell edge length.
+  float mCellSize{DefaultCellSize};
+  /// Reciprocal of mCellSize.
+  float mInvCellSize{1.f / DefaultCellSize};
+  /// Proxy slots addressed by Handle::index.
+  std::vector<Proxy> mProxies{};
+  /// Head of free slot list.
+  std::uint32_t mFreeHead{Handle::InvalidIndex};
+  /// Number of live proxies.
+  std::size_t mProxyCount{};
+  /// Slots listed in each occupied cell.
+  std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> mCells{};
+  /// Cells occupied since the grid was last empty; only grows, so it may be larger than the cells occupied now.
+  CellRange mOccupied{};
+  /// Moves that changed cells.
+  std::size_t mRebinned{};
+  /// Moves that stayed in the same cells.
+  std::size_t mMoved{};
+};
+
+}
+
+#endif
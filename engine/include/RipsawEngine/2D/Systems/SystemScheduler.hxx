@@ -0,0 +1,79 @@
+#ifndef D2_SYSTEMS_SYSTEMSCHEDULER_HXX
+#define D2_SYSTEMS_SYSTEMSCHEDULER_HXX
+
+#include "RipsawEngine/2D/Core/JobSystem.hxx"
+#include "RipsawEngine/2D/Scene/Component.hxx"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Update function of a system.
+using SystemFunction = std::function<void(double dt)>;
+
+class SystemScheduler
+{
+public:
+  /// Constructs scheduler without systems.
+  /// @details A system is an update function that declares which component types it reads and which it writes, see @ref ComponentBits. Two systems conflict if one writes a type the other reads or writes. Systems are grouped into phases: a system goes into the first phase after every earlier registered system it conflicts with, so conflicting systems run in registration order while independent ones share a phase and run concurrently on the job system. Phases run one after another. Phases are rebuilt only when systems are added or removed.
+  /// @warning Systems sharing a phase run concurrently; structural changes must be recorded into Engine::getCommandBuffer().
+  SystemScheduler() = default;
+  /// Registers system after every system registered so far.
+  /// @param name Unique name of system.
+  /// @param reads Component types the system reads.
+  /// @param writes Component types the system writes.
+  /// @param update Update function.
+  /// @return True if successful, False if the name is taken or update is empty.
+  bool addSystem(const std::string& name, ComponentMask reads, ComponentMask writes, SystemFunction update);
+  /// Unregisters system. Unknown names are ignored.
+  /// @param name Name of system.
+  void removeSystem(const std::string& name);
+  /// Runs every system once, phase by phase.
+  /// @param dt Delta-time.
+  /// @param jobs Job system phases are spread over.
+  void run(double dt, JobSystem& jobs);
+  /// Returns number of registered systems.
+  std::size_t getSystemCount() const;
+  /// Returns number of phases systems are grouped into.
+  std::size_t getPhaseCount();
+
+private:
+  /// Registered system.
+  struct System
+  {
+    /// Unique name.
+    std::string name{};
+    /// Component types read.
+    ComponentMask reads{};
+    /// Component types written.
+    ComponentMask writes{};
+    /// Update function.
+    SystemFunction update{};
+  };
+
+private:
+  /// Returns True if two systems can't run concurrently.
+  /// @param a First system.
+  /// @param b Second system.
+  static bool conflicts(const System& a, const System& b);
+  /// Groups systems into phases.
+  void buildPhases();
+
+private:
+  /// Systems in registration order.
+  std::vector<System> mSystems{};
+  /// Indices into mSystems, grouped by phase.
+  std::vector<std::size_t> mOrder{};
+  /// Offset of every phase in mOrder, followed by mOrder.size().
+  std::vector<std::size_t> mPhaseStarts{};
+  /// True if phases must be rebuilt before the next run.
+  bool mIsDirty{false};
+};
+
+}
+
+#endif
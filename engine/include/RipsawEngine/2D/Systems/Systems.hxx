@@ -0,0 +1,11 @@
+#ifndef D2_SYSTEMS_SYSTEMS_HXX
+#define D2_SYSTEMS_SYSTEMS_HXX
+
+#include "AnimationSystem.hxx"
+#include "ParticleSystem.hxx"
+#include "SpatialHash.hxx"
+#include "SystemScheduler.hxx"
+#include "TilemapSystem.hxx"
+#include "TransformSystem.hxx"
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef D2_SYSTEMS_TILEMAPSYSTEM_HXX
+#define D2_SYSTEMS_TILEMAPSYSTEM_HXX
+
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+#include "RipsawEngine/2D/Core/JobSystem.hxx"
+#include "RipsawEngine/2D/Render/RenderPacket.hxx"
+#include "RipsawEngine/2D/Render/TextureAtlas.hxx"
+#include "RipsawEngine/2D/Systems/SpatialHash.hxx"
+
+#include <SDL3/SDL.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+/// Id of a tile: 0 is an empty cell, n is the n-th tile of the tileset, counted row by row from the top left.
+using TileId = std::uint16_t;
+
+/// Id of an empty cell.
+inline constexpr TileId EmptyTile{0};
+
+/// Parameters of a tilemap.
+struct TilemapConfig
+{
+  /// Tileset image file, shared through the texture cache. Empty to draw tiles as plain white squares.
+  std::string imgfile{};
+  /// Size of one tile in tileset pixels.
+  glm::ivec2 tileSize{32, 32};
+  /// Width and height of the map in tiles.
+  glm::ivec2 mapSize{64, 64};
+  /// Width and height of a chunk in tiles. Chunks are the unit of caching, culling, and drawing.
+  int chunkSize{16};
+  /// World units per tileset pixel.
+  float scale{1.f};
+  /// Draw layer, as SpriteComponent::setLayer().
+  std::uint8_t layer{};
+  /// Depth within layer, as SpriteComponent::setDepth().
+  float depth{};
+};
+
+class TilemapSystem
+{
+public:
+  /// Constructs tilemap system without tilemaps.
+  /// @details Tilemap system keeps the tiles of every @ref TilemapComponent as compact arrays of @ref TileId, without any actor or component per tile. A map is split into square chunks; each chunk caches the vertices of its non-empty tiles in world units relative to the map origin, built the first time the chunk comes into view and rebuilt only after one of its tiles changed. Extracting a frame finds the chunks overlapping a camera from the view bounds directly, without visiting the others, rebuilds those that are dirty in parallel on the job system, and copies their cached vertices into the render packet, so cached geometry is never shared with a frame being drawn. Each chunk is drawn with a single SDL_RenderGeometry() call from the tileset texture, layered against sprites by the same sort key.
+  TilemapSystem() = default;
+  /// Adds tilemap with every cell empty.
+  /// @param config Tilemap parameters.
+  /// @param region Texture region of the tileset, null texture for plain white squares.
+  /// @param actor Actor owning the tilemap, whose position is the top left corner of the map.
+  /// @return Handle to the tilemap.
+  Handle create(const TilemapConfig& config, const TextureRegion& region, const class Actor* actor);
+  /// Removes tilemap. Stale handles are ignored.
+  /// @param handle Handle to the tilemap.
+  void destroy(Handle handle);
+  /// Returns True if handle refers to a live tilemap.
+  /// @param handle Handle to the tilemap.
+  bool isValid(Handle handle) const;
+  /// Sets tile of cell, marking its chunk for rebuild if the tile changes.
+  /// @warning Not thread-safe; don't call it from Component::update() with parallel update enabled.
+  /// @param handle Handle to the tilemap.
+  /// @param cell Column and row of the cell.
+  /// @param tile Tile id, @ref EmptyTile to clear the cell.
+  /// @return False if cell is outside the map or tile isn't in the tileset.
+  bool setTile(Handle handle, const glm::ivec2& cell, TileId tile);
+  /// Returns tile of cell, @ref EmptyTile outside the map.
+  /// @param handle Handle to the tilemap.
+  /// @param cell Column and row of the cell.
+  TileId getTile(Handle handle, const glm::ivec2& cell) const;
+  /// Sets every cell to tile, marking every chunk for rebuild.
+  /// @param handle Handle to the tilemap.
+  /// @param tile Tile id, @ref EmptyTile to clear the map.
+  /// @return False if tile isn't in the tileset.
+  bool fill(Handle handle, TileId tile);
+  /// Returns width and height of the map in tiles.
+  /// @param handle Handle to the tilemap.
+  glm::ivec2 getMapSize(Handle handle) const;
+  /// Returns width and height of one tile in world units.
+  /// @param handle Handle to the tilemap.
+  glm::vec2 getTileSize(Handle handle) const;
+  /// Returns cell covering world position, which may lie outside the map.
+  /// @param handle Handle to the tilemap.
+  /// @param pos Position in world coordinates.
+  glm::ivec2 worldToCell(Handle handle, const glm::vec2& pos) const;
+  /// Rebuilds dirty chunks and copies chunks overlapping a camera of packet into it, one batch per chunk, batches ordered by key.
+  /// @param packet Render packet, its cameras already set.
+  /// @param jobs Job system.
+  void extract(RenderPacket& packet, JobSystem& jobs);
+  /// Returns number of chunk rebuilds so far.
+  std::size_t getRebuildCount() const;
+  /// Returns number of live tilemaps.
+  std::size_t size() const;
+
+private:
+  /// Square block of cells with its cached geometry.
+  struct Chunk
+  {
+    /// Vertices of non-empty tiles, four per tile, relative to the map origin.
+    std::vector<SDL_Vertex> vertices{};
+    /// Number of the last extraction that picked the chunk, so chunks seen by several cameras are copied once.
+    std::size_t extraction{};
+    /// True if vertices are out of date.
+    bool isDirty{true};
+  };
+
+  /// Tilemap with its cells and chunks.
+  struct Tilemap
+  {
+    /// Parameters.
+    TilemapConfig config{};
+    /// Actor owning the tilemap.
+    const class Actor* actor{nullptr};
+    /// Tileset texture, nullptr for plain white squares.
+    SDL_Texture* texture{nullptr};
+    /// Tileset rectangle in texture pixels.
+    SDL_FRect src{};
+    /// Size of the texture in pixels.
+    glm::vec2 textureSize{};
+    /// Number of tile columns of the tileset.
+    int columns{};
+    /// Number of tiles of the tileset.
+    int tileCount{};
+    /// Number of chunks per row and column.
+    glm::ivec2 chunkCount{};
+    /// Sort key of the batches.
+    std::uint64_t key{};
+    /// Cells chunk by chunk, each chunk row by row, so a chunk's cells are contiguous.
+    std::vector<TileId> cells{};
+    /// Chunks row by row.
+    std::vector<Chunk> chunks{};
+  };
+
+private:
+  /// Returns index of cell in Tilemap::cells.
+  /// @param map Tilemap.
+  /// @param cell Column and row of the cell, inside the map.
+  static std::size_t indexOf(const Tilemap& map, const glm::ivec2& cell);
+  /// Picks chunks of tilemap overlapping view that weren't picked this extraction yet.
+  /// @param map Index of tilemap.
+  /// @param view Box in coordinates relative to the map origin.
+  void pick(std::size_t map, const Aabb& view);
+  /// Rebuilds vertices of chunk.
+  /// @param map Tilemap.
+  /// @param index Index of chunk.
+  static void build(Tilemap& map, std::size_t index);
+
+private:
+  /// Handle bookkeeping.
+  HandleTable mTable{};
+  /// Every tilemap, packed.
+  std::vector<Tilemap> mTilemaps{};
+  /// Chunks picked this extraction, as tilemap and chunk index.
+  std::vector<std::pair<std::size_t, std::size_t>> mPicked{};
+  /// Picked chunks to rebuild this extraction.
+  std::vector<std::pair<std::size_t, std::size_t>> mDirty{};
+  /// Number of the current extraction.
+  std::size_t mExtraction{};
+  /// Number of chunk rebuilds so far.
+  std::size_t mRebuilds{};
+};
+
+}
+
+#endif
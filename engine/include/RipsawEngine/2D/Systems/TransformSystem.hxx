@@ -0,0 +1,137 @@
+#ifndef D2_SYSTEMS_TRANSFORMSYSTEM_HXX
+#define D2_SYSTEMS_TRANSFORMSYSTEM_HXX
+
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+#include "RipsawEngine/2D/Systems/SpatialHash.hxx"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+class TransformSystem
+{
+public:
+  /// Constructs empty transform system.
+  /// @details Transform system owns position and velocity of every @ref TransformComponent as structure-of-arrays: x and y of positions and velocities each live in their own packed float buffer. Engine integrates all of them once per update with @ref integrate(), which runs over whole buffers with SIMD kernels instead of dispatching one virtual call per component. Positions of the previous simulation tick are kept in two more buffers so that a fixed-step engine can render positions interpolated between the last two ticks. Entries given bounds are mirrored into a @ref SpatialHash; only entries that moved since the last syncSpatialHash() are touched there.
+  TransformSystem() = default;
+  /// Adds new transform entry.
+  /// @param pos Position.
+  /// @param vel Velocity.
+  /// @return Handle to the entry.
+  Handle create(const glm::vec2& pos, const glm::vec2& vel);
+  /// Removes transform entry. Stale handles are ignored.
+  /// @param handle Handle to the entry.
+  void destroy(Handle handle);
+  /// Returns True if handle refers to a live entry.
+  /// @param handle Handle to the entry.
+  bool isValid(Handle handle) const;
+  /// Returns position of entry.
+  /// @param handle Handle to the entry.
+  glm::vec2 getPosition(Handle handle) const;
+  /// Sets position of entry.
+  /// @param handle Handle to the entry.
+  /// @param pos Position.
+  void setPosition(Handle handle, const glm::vec2& pos);
+  /// Sets position of entry without interpolating from where it was, e.g. to wrap it around the screen.
+  /// @param handle Handle to the entry.
+  /// @param pos Position.
+  void teleport(Handle handle, const glm::vec2& pos);
+  /// Returns position of entry to be drawn, interpolated between the previous and the current tick.
+  /// @param handle Handle to the entry.
+  glm::vec2 getRenderPosition(Handle handle) const;
+  /// Returns velocity of entry.
+  /// @param handle Handle to the entry.
+  glm::vec2 getVelocity(Handle handle) const;
+  /// Sets velocity of entry.
+  /// @param handle Handle to the entry.
+  /// @param vel Velocity.
+  void setVelocity(Handle handle, const glm::vec2& vel);
+  /// Integrates positions by velocities with the SIMD kernels.
+  /// @param dt Delta-time.
+  void integrate(float dt);
+  /// Integrates positions by velocities with plain scalar loops.
+  /// @details Reference path kept for benchmarking and validation.
+  /// @param dt Delta-time.
+  void integrateScalar(float dt);
+  /// Sets spatial hash entries with bounds are mirrored into.
+  /// @param hash Spatial hash, nullptr to disable bounds.
+  void setSpatialHash(SpatialHash* hash);
+  /// Gives entry a bounding box centered on its position, making it visible to spatial queries.
+  /// @param handle Handle to the entry.
+  /// @param size Width and height of bounding box.
+  /// @param userData Handle reported by spatial queries, e.g. handle of the owning actor.
+  void setBounds(Handle handle, const glm::vec2& size, Handle userData);
+  /// Removes bounding box of entry.
+  /// @param handle Handle to the entry.
+  void clearBounds(Handle handle);
+  /// Moves bounding boxes of entries that moved since the last call into the spatial hash.
+  /// @details Entries with non-zero velocity and entries whose position was set directly are tracked as they change, so this costs O(moved entries) rather than O(entries).
+  void syncSpatialHash();
+  /// Moves bounding boxes of entries whose position was set directly since the last sync into the spatial hash, leaving moving entries alone.
+  void syncDirtyBounds();
+  /// Remembers current positions as the previous tick. Called by engine before every fixed tick.
+  void snapshot();
+  /// Sets how far rendering is between the previous and the current tick.
+  /// @param alpha Interpolation factor in [0, 1]; 1 draws current positions.
+  void setInterpolation(float alpha);
+  /// Returns number of live entries.
+  std::size_t size() const;
+  /// Reserves memory for specified number of entries.
+  /// @param capacity Number of entries.
+  void reserve(std::size_t capacity);
+
+private:
+  /// Moves bounding box of entry at dense index to its current position.
+  /// @param index Dense index of entry.
+  void updateProxy(std::size_t index);
+  /// Flags entry and appends it to a tracking list.
+  /// @param list mMovers or mDirty.
+  /// @param index Dense index of entry.
+  /// @param handle Handle to the entry.
+  /// @param flag Flag marking the entry as listed.
+  void track(std::vector<Handle>& list, std::size_t index, Handle handle, std::uint8_t flag);
+
+private:
+  /// Handle bookkeeping.
+  HandleTable mTable{};
+  /// X components of positions.
+  std::vector<float> mPosX{};
+  /// Y components of positions.
+  std::vector<float> mPosY{};
+  /// X components of velocities.
+  std::vector<float> mVelX{};
+  /// Y components of velocities.
+  std::vector<float> mVelY{};
+  /// X components of positions at the previous tick.
+  std::vector<float> mPrevX{};
+  /// Y components of positions at the previous tick.
+  std::vector<float> mPrevY{};
+  /// Interpolation factor between previous and current positions.
+  float mAlpha{1.f};
+  /// Half widths of bounding boxes.
+  std::vector<float> mHalfW{};
+  /// Half heights of bounding boxes.
+  std::vector<float> mHalfH{};
+  /// Spatial hash proxy of each entry, null if the entry has no bounds.
+  std::vector<Handle> mProxies{};
+  /// Tracking flags of each entry, see syncSpatialHash().
+  std::vector<std::uint8_t> mFlags{};
+  /// Entries with bounds and possibly non-zero velocity.
+  std::vector<Handle> mMovers{};
+  /// Entries with bounds whose position was set directly.
+  std::vector<Handle> mDirty{};
+  /// Guards mMovers and mDirty while actors are updated in parallel.
+  std::mutex mTrackingMutex{};
+  /// Spatial hash entries with bounds are mirrored into.
+  SpatialHash* mSpatialHash{nullptr};
+};
+
+}
+
+#endif
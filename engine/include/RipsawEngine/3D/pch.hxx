@@ -2,6 +2,7 @@
 #define _3D_PCH_HXX
 
 #include "RipsawEngine/3D/Util/stbimg.hxx"
+#include "RipsawEngine/Common/Log.hxx"
 
 #include <SDL3/SDL.h>
 #include <cstdlib>
@@ -0,0 +1,226 @@
+#ifndef COMMON_LOG_HXX
+#define COMMON_LOG_HXX
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#define RIPSAW_LOG_LEVEL_TRACE 0
+#define RIPSAW_LOG_LEVEL_DEBUG 1
+#define RIPSAW_LOG_LEVEL_INFO 2
+#define RIPSAW_LOG_LEVEL_WARN 3
+#define RIPSAW_LOG_LEVEL_ERROR 4
+#define RIPSAW_LOG_LEVEL_OFF 5
+
+/// Lowest severity compiled in, one of RIPSAW_LOG_LEVEL_*. Set by RIPSAW_ENGINE_LOG_LEVEL in CMake.
+#if !defined(RIPSAW_ENGINE_LOG_LEVEL)
+#define RIPSAW_ENGINE_LOG_LEVEL RIPSAW_LOG_LEVEL_DEBUG
+#endif
+
+namespace RipsawEngine
+{
+
+/// Severity of a log message, in increasing order.
+enum class LogLevel : std::uint8_t
+{
+  Trace = RIPSAW_LOG_LEVEL_TRACE,
+  Debug = RIPSAW_LOG_LEVEL_DEBUG,
+  Info = RIPSAW_LOG_LEVEL_INFO,
+  Warn = RIPSAW_LOG_LEVEL_WARN,
+  Error = RIPSAW_LOG_LEVEL_ERROR,
+  /// Runtime level disabling a category.
+  Off = RIPSAW_LOG_LEVEL_OFF,
+};
+
+/// Part of the engine a log message comes from.
+enum class LogCategory : std::uint8_t
+{
+  /// Engine lifetime, timing, threads.
+  Core,
+  /// Actors and components.
+  Scene,
+  /// Renderer, sprites, cameras.
+  Render,
+  /// Textures, atlases, asset loading.
+  Assets,
+  /// Systems and their scheduling.
+  Systems,
+  /// Game code.
+  Game,
+  /// Number of categories.
+  Count,
+};
+
+/// One formatted message.
+struct LogRecord
+{
+  /// Longest message kept, including the terminating null; longer messages are truncated.
+  static constexpr std::size_t MessageSize{240};
+  /// Message text.
+  std::array<char, MessageSize> text{};
+  /// Category.
+  LogCategory category{LogCategory::Core};
+  /// Severity.
+  LogLevel level{LogLevel::Info};
+};
+
+class LogRing
+{
+public:
+  /// Number of records the ring holds.
+  static constexpr std::size_t Capacity{1 << 12};
+
+public:
+  /// Constructs empty ring.
+  /// @details Bounded multi-producer single-consumer ring of records. Every cell carries a sequence number telling producers whether it is free and the consumer whether it is filled, so pushing costs one compare-and-swap and never blocks; pushes into a full ring fail instead.
+  LogRing();
+  /// Formats message into the next free cell. Called by any thread.
+  /// @param category Category.
+  /// @param level Severity.
+  /// @param fmt printf-style format.
+  /// @param args Format arguments.
+  /// @return True if pushed, False if the ring was full.
+  bool push(LogCategory category, LogLevel level, const char* fmt, std::va_list args);
+  /// Moves the oldest record into out. Called only by the consumer.
+  /// @param out Destination.
+  /// @return True if a record was popped, False if the ring was empty.
+  bool pop(LogRecord& out);
+
+private:
+  /// Record with its sequence number.
+  struct Cell
+  {
+    /// Position the cell is free for when equal to it, filled for when one past it.
+    std::atomic<std::size_t> sequence{};
+    /// Record.
+    LogRecord record{};
+  };
+
+private:
+  /// Cell storage, on the heap because it is large.
+  std::unique_ptr<Cell[]> mCells{};
+  /// Position of the next push.
+  std::atomic<std::size_t> mHead{};
+  /// Position of the next pop.
+  std::size_t mTail{};
+};
+
+class Log
+{
+public:
+  /// Interval at which the drain thread polls an empty ring, in milliseconds.
+  static constexpr int DrainIntervalMs{5};
+  /// Interval after which repeats of a suppressed message are reported, in milliseconds.
+  static constexpr Uint64 RepeatReportMs{1000};
+
+public:
+  /// Returns process-wide log.
+  /// @details Messages go through the RIPSAW_LOG_* macros. A message below RIPSAW_ENGINE_LOG_LEVEL is compiled out; one below the runtime level of its category, Info by default, costs one relaxed load. Anything else is formatted on the calling thread into a lock-free ring, and a background thread writes it out through SDL_LogMessage(), so logging never waits for the console. Consecutive identical messages are written once and then counted, with the count reported when a different message arrives or a second has passed. When the ring is full, messages are dropped and counted, except errors, which are then written synchronously.
+  static Log& get();
+  /// Drains remaining messages and stops the drain thread.
+  ~Log();
+  Log(const Log&) = delete;
+  Log& operator=(const Log&) = delete;
+  Log(Log&&) = delete;
+  Log& operator=(Log&&) = delete;
+  /// Sets lowest severity written for category.
+  /// @param category Category.
+  /// @param level Lowest severity, LogLevel::Off to silence the category.
+  void setLevel(LogCategory category, LogLevel level);
+  /// Sets lowest severity written for every category.
+  /// @param level Lowest severity, LogLevel::Off to silence everything.
+  void setLevel(LogLevel level);
+  /// Returns lowest severity written for category.
+  /// @param category Category.
+  LogLevel getLevel(LogCategory category) const;
+  /// Returns True if messages of level are written for category.
+  /// @param category Category.
+  /// @param level Severity.
+  bool isEnabled(LogCategory category, LogLevel level) const
+  {
+    return level >= mLevels[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+  }
+  /// Queues message. Use the RIPSAW_LOG_* macros instead, which skip disabled messages before formatting.
+  /// @param category Category.
+  /// @param level Severity.
+  /// @param fmt printf-style format.
+  void write(LogCategory category, LogLevel level, SDL_PRINTF_FORMAT_STRING const char* fmt, ...) SDL_PRINTF_VARARG_FUNC(4);
+  /// Blocks until every message queued before the call has been written.
+  void flush();
+  /// Returns number of messages dropped because the ring was full.
+  std::size_t getDropped() const;
+
+private:
+  /// Constructs log and starts its drain thread.
+  Log();
+  /// Writes queued messages until stopped.
+  void drainLoop();
+  /// Writes every queued message.
+  /// @return True if any message was written.
+  bool drain();
+  /// Writes record, or counts it if it repeats the previous one.
+  /// @param record Record.
+  void emit(const LogRecord& record);
+  /// Writes how often the previous message repeated, if it did.
+  void reportRepeats();
+  /// Writes text through SDL.
+  /// @param category Category.
+  /// @param level Severity.
+  /// @param text Message text.
+  static void output(LogCategory category, LogLevel level, const char* text);
+
+private:
+  /// Queued messages.
+  LogRing mRing{};
+  /// Lowest severity written for each category.
+  std::array<std::atomic<LogLevel>, static_cast<std::size_t>(LogCategory::Count)> mLevels{};
+  /// Messages pushed into the ring.
+  std::atomic<std::size_t> mPushed{};
+  /// Messages taken out of the ring by the drain thread.
+  std::atomic<std::size_t> mDrained{};
+  /// Messages dropped because the ring was full.
+  std::atomic<std::size_t> mDropped{};
+  /// Dropped messages already reported.
+  std::size_t mReportedDropped{};
+  /// Last message written, compared against to suppress repeats.
+  LogRecord mLast{};
+  /// Number of times mLast repeated since it was written.
+  std::size_t mRepeats{};
+  /// Time mLast was written or its repeats last reported, in milliseconds.
+  Uint64 mLastReport{};
+  /// True while the drain thread is asked to exit.
+  std::atomic<bool> mIsStopping{false};
+  /// Thread writing messages out.
+  std::thread mThread{};
+};
+
+}
+
+/// Logs printf-style message of level in category if enabled at compile time and at runtime. Arguments are evaluated only if the message is written.
+#define RIPSAW_LOG(category, level, ...) \
+  do \
+  { \
+    if constexpr (static_cast<int>(::RipsawEngine::LogLevel::level) >= RIPSAW_ENGINE_LOG_LEVEL) \
+    { \
+      if (::RipsawEngine::Log::get().isEnabled(::RipsawEngine::LogCategory::category, ::RipsawEngine::LogLevel::level)) \
+        ::RipsawEngine::Log::get().write(::RipsawEngine::LogCategory::category, ::RipsawEngine::LogLevel::level, __VA_ARGS__); \
+    } \
+  } while (false)
+/// Logs trace message, e.g. per-frame detail.
+#define RIPSAW_LOG_TRACE(category, ...) RIPSAW_LOG(category, Trace, __VA_ARGS__)
+/// Logs debug message, e.g. per-object lifetime events.
+#define RIPSAW_LOG_DEBUG(category, ...) RIPSAW_LOG(category, Debug, __VA_ARGS__)
+/// Logs info message.
+#define RIPSAW_LOG_INFO(category, ...) RIPSAW_LOG(category, Info, __VA_ARGS__)
+/// Logs warning, for something wrong that was worked around.
+#define RIPSAW_LOG_WARN(category, ...) RIPSAW_LOG(category, Warn, __VA_ARGS__)
+/// Logs error.
+#define RIPSAW_LOG_ERROR(category, ...) RIPSAW_LOG(category, Error, __VA_ARGS__)
+
+#endif
@@ -1,20 +1,52 @@
 #include "RipsawEngine/2D/Core/Engine.hxx"
 #include "RipsawEngine/2D/Scene/Actor.hxx"
 #include "RipsawEngine/2D/Scene/Component.hxx"
+#include "RipsawEngine/2D/Scene/ParticleEmitterComponent.hxx"
 #include "RipsawEngine/2D/Scene/TransformComponent.hxx"
 #include "RipsawEngine/2D/Scene/SpriteComponent.hxx"
 #include "RipsawEngine/2D/Scene/SpritesheetComponent.hxx"
+#include "RipsawEngine/2D/Scene/TilemapComponent.hxx"
+#include "RipsawEngine/Common/Log.hxx"
 
+#include <algorithm>
+#include <bit>
 #include <stdexcept>
 #include <utility>
 
 namespace RipsawEngine
 {
 
+namespace
+{
+
+/// Pool every Actor is allocated from.
+Pool<Actor>& actorPool()
+{
+  static Pool<Actor> pool{};
+  return pool;
+}
+
+}
+
+void* Actor::operator new(std::size_t size)
+{
+  return actorPool().allocate(size);
+}
+
+void Actor::operator delete(void* ptr, std::size_t size)
+{
+  actorPool().deallocate(ptr, size);
+}
+
+const PoolStats& Actor::getPoolStats()
+{
+  return actorPool().getStats();
+}
+
 Actor::Actor(Engine* engine)
   : mEngine{engine}
 {
-  SDL_Log("[INFO] Actor (%zu bytes) created: %p", static_cast<size_t>(sizeof(*this)), static_cast<void*>(this));
+  RIPSAW_LOG_DEBUG(Scene, "Actor (%zu bytes) created: %p", static_cast<size_t>(sizeof(*this)), static_cast<void*>(this));
   mEngine->addActor(this);
 }
 
@@ -26,7 +58,7 @@ Actor::~Actor()
     delete mComponents.back();
     mComponents.pop_back();
   }
-  SDL_Log("[INFO] Actor destroyed: %p", static_cast<void*>(this));
+  RIPSAW_LOG_DEBUG(Scene, "Actor destroyed: %p", static_cast<void*>(this));
 }
 
 void Actor::update(double dt)
@@ -71,7 +103,7 @@ glm::vec2 Actor::getPosition() const
 {
   if (mTransformComponent == nullptr)
   {
-    SDL_Log("[ERROR] TransformComponent unavailable for Actor: %p", static_cast<const void*>(this));
+    RIPSAW_LOG_ERROR(Scene, "TransformComponent unavailable for Actor: %p", static_cast<const void*>(this));
     return {};
   }
   return mTransformComponent->getPosition();
@@ -81,17 +113,27 @@ void Actor::setPosition(const glm::vec2& pos)
 {
   if (mTransformComponent == nullptr)
   {
-    SDL_Log("[ERROR] TransformComponent unavailable for Actor: %p", static_cast<void*>(this));
+    RIPSAW_LOG_ERROR(Scene, "TransformComponent unavailable for Actor: %p", static_cast<void*>(this));
     return;
   }
   mTransformComponent->setPosition(pos);
 }
 
+void Actor::teleport(const glm::vec2& pos)
+{
+  if (mTransformComponent == nullptr)
+  {
+    RIPSAW_LOG_ERROR(Scene, "TransformComponent unavailable for Actor: %p", static_cast<void*>(this));
+    return;
+  }
+  mTransformComponent->teleport(pos);
+}
+
 glm::vec2 Actor::getVelocity() const
 {
   if (mTransformComponent == nullptr)
   {
-    SDL_Log("[ERROR] TransformComponent unavailable for Actor: %p", static_cast<const void*>(this));
+    RIPSAW_LOG_ERROR(Scene, "TransformComponent unavailable for Actor: %p", static_cast<const void*>(this));
     return {};
   }
   return mTransformComponent->getVelocity();
@@ -100,67 +142,129 @@ void Actor::setVelocity(const glm::vec2& vel)
 {
   if (mTransformComponent == nullptr)
   {
-    SDL_Log("[ERROR] TransformComponent unavailable for Actor: %p", static_cast<void*>(this));
+    RIPSAW_LOG_ERROR(Scene, "TransformComponent unavailable for Actor: %p", static_cast<void*>(this));
     return;
   }
   mTransformComponent->setVelocity(vel);
 }
 
+void Actor::setBounds(const glm::vec2& size)
+{
+  if (mTransformComponent == nullptr)
+  {
+    RIPSAW_LOG_ERROR(Scene, "TransformComponent unavailable for Actor: %p", static_cast<void*>(this));
+    return;
+  }
+  mTransformComponent->setBounds(size);
+}
+
 Engine* Actor::getEngine() const
 {
   return mEngine;
 }
 
-bool Actor::hasComponent(const std::string& compname) const
+Handle Actor::getHandle() const
 {
-  if (mComponentMap.contains(compname))
-  {
-    return mComponentMap.at(compname);
-  }
-  return false;
+  return mHandle;
+}
+
+void Actor::setHandle(Handle handle)
+{
+  mHandle = handle;
 }
 
-void Actor::registerComponent(const std::string& compname)
+Component* Actor::getComponent(ComponentTypeId id) const
 {
-  mComponentMap[compname] = true;
+  if (this->hasComponent(id) == false)
+    return nullptr;
+  return mTypedComponents[this->rankOf(id)];
 }
 
-void Actor::deregisterComponent(const std::string& compname)
+bool Actor::hasComponent(ComponentTypeId id) const
 {
-  mComponentMap[compname] = false;
+  return (mComponentMask & (1ull << id)) != 0;
 }
-  
-void Actor::helperRegisterComponent(const std::string& compname)
+
+ComponentMask Actor::getComponentMask() const
+{
+  return mComponentMask;
+}
+
+void Actor::registerComponent(ComponentTypeId id, Component* component)
 {
-  if (this->hasComponent(compname))
+  if (this->hasComponent(id))
   {
-    throw std::runtime_error{"[ABORT] Actor already owns " + compname};
+    throw std::runtime_error{"[ABORT] Actor already owns component type " + std::to_string(id)};
   }
-  this->registerComponent(compname);
+  std::size_t count{static_cast<std::size_t>(std::popcount(mComponentMask))};
+  if (count == MaxTypedComponents)
+  {
+    throw std::runtime_error{"[ABORT] Actor can't hold more than " + std::to_string(MaxTypedComponents) + " typed components"};
+  }
+
+  std::size_t rank{this->rankOf(id)};
+  std::move_backward(mTypedComponents.begin() + static_cast<std::ptrdiff_t>(rank), mTypedComponents.begin() + static_cast<std::ptrdiff_t>(count), mTypedComponents.begin() + static_cast<std::ptrdiff_t>(count + 1));
+  mTypedComponents[rank] = component;
+  mComponentMask |= 1ull << id;
+  mEngine->getArchetypes().update(this);
+}
+
+void Actor::deregisterComponent(ComponentTypeId id)
+{
+  if (this->hasComponent(id) == false)
+    return;
+
+  std::size_t count{static_cast<std::size_t>(std::popcount(mComponentMask))};
+  std::size_t rank{this->rankOf(id)};
+  std::move(mTypedComponents.begin() + static_cast<std::ptrdiff_t>(rank + 1), mTypedComponents.begin() + static_cast<std::ptrdiff_t>(count), mTypedComponents.begin() + static_cast<std::ptrdiff_t>(rank));
+  mTypedComponents[count - 1] = nullptr;
+  mComponentMask &= ~(1ull << id);
+  mEngine->getArchetypes().update(this);
+}
+
+ArchetypeLocation Actor::getArchetypeLocation() const
+{
+  return mArchetypeLocation;
+}
+
+void Actor::setArchetypeLocation(ArchetypeLocation location)
+{
+  mArchetypeLocation = location;
+}
+
+std::size_t Actor::rankOf(ComponentTypeId id) const
+{
+  return static_cast<std::size_t>(std::popcount(mComponentMask & ((1ull << id) - 1)));
 }
 
 void Actor::createTransformComponent(const glm::vec2& pos, const glm::vec2& vel)
 {
-  [[maybe_unused]] Component* tempComponent{new TransformComponent(this, pos, vel)};
+  this->addComponent<TransformComponent>(pos, vel);
 }
 
-void Actor::createSpriteComponent(const std::string& imgfile)
+void Actor::createSpriteComponent(const std::string& imgfile, bool loadAsync)
 {
-  Component* tempComponent{new SpriteComponent{this, mEngine->getRenderer(), imgfile}};
-  mEngine->insertActorSpritePair(std::make_pair(this, tempComponent));
+  this->addComponent<SpriteComponent>(mEngine->getRenderer(), imgfile, loadAsync);
 }
 
 void Actor::createSpriteComponent(const glm::vec2& size, const std::tuple<unsigned char, unsigned char, unsigned char, unsigned char>& color)
 {
-  Component* tempComponent{new SpriteComponent{this, mEngine->getRenderer(), size, color}};
-  mEngine->insertActorSpritePair(std::make_pair(this, tempComponent));
+  this->addComponent<SpriteComponent>(mEngine->getRenderer(), size, color);
 }
 
-void Actor::createSpritesheetComponent(const std::string& imgfile, const glm::vec2& dims, const glm::vec2& defaultCoords, bool doAnimate, float animFPS)
+void Actor::createSpritesheetComponent(const std::string& imgfile, const glm::vec2& dims, const glm::vec2& defaultCoords, bool doAnimate, float animFPS, bool loadAsync)
 {
-  Component* tempComponent{new SpritesheetComponent{this, mEngine->getRenderer(), imgfile, dims, defaultCoords, doAnimate, animFPS}};
-  mEngine->insertActorSpritePair(std::make_pair(this, tempComponent));
+  this->addComponent<SpritesheetComponent>(mEngine->getRenderer(), imgfile, dims, defaultCoords, doAnimate, animFPS, loadAsync);
 }
 
+void Actor::createParticleEmitterComponent(const ParticleEmitterConfig& config)
+{
+  this->addComponent<ParticleEmitterComponent>(config);
 }
 
+void Actor::createTilemapComponent(const TilemapConfig& config)
+{
+  this->addComponent<TilemapComponent>(config);
+}
+
+}
@@ -0,0 +1,348 @@
+#include "RipsawEngine/2D/Scene/SpriteComponent.hxx"
+#include "RipsawEngine/2D/Systems/AnimationSystem.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace RipsawEngine
+{
+
+namespace
+{
+
+/// Minimum number of animators per job of the parallel update.
+constexpr std::size_t AnimatorGrain{512};
+
+}
+
+AnimationClip AnimationClip::fromRow(const std::string& name, int row, int columns, float fps, AnimationMode mode)
+{
+  AnimationClip clip{name, {}, mode};
+  float duration{fps > 0.f ? 1.f / fps : 0.f};
+  for (int col{1}; col <= columns; ++col)
+  {
+    clip.frames.push_back({{col, row}, duration});
+  }
+  return clip;
+}
+
+bool AnimationSystem::addSet(const std::string& name, const AnimationSet& set)
+{
+  if (mSets.contains(name))
+  {
+    RIPSAW_LOG_ERROR(Systems, "Animation set already registered: %s", name.c_str());
+    return false;
+  }
+  if (set.clips.empty())
+  {
+    RIPSAW_LOG_ERROR(Systems, "Animation set %s has no clips", name.c_str());
+    return false;
+  }
+
+  Set compiled{};
+  for (const auto& clip : set.clips)
+  {
+    if (clip.frames.empty())
+    {
+      RIPSAW_LOG_ERROR(Systems, "Animation clip %s of set %s has no frames", clip.name.c_str(), name.c_str());
+      return false;
+    }
+    float total{};
+    for (const auto& frame : clip.frames)
+    {
+      if (frame.duration <= 0.f)
+      {
+        RIPSAW_LOG_ERROR(Systems, "Animation clip %s of set %s has a frame without duration", clip.name.c_str(), name.c_str());
+        return false;
+      }
+      total += frame.duration;
+    }
+
+    float period{};
+    if (clip.mode == AnimationMode::Loop)
+      period = total;
+    else if (clip.mode == AnimationMode::PingPong)
+      // End frames are shown once per cycle, inner frames twice.
+      period = clip.frames.size() > 1 ? 2.f * total - clip.frames.front().duration - clip.frames.back().duration : total;
+    compiled.clips.push_back({clip.name, clip.frames, clip.mode, period});
+  }
+
+  auto clipIndex{[&compiled](const std::string& clip) {
+      auto it{std::find_if(compiled.clips.begin(), compiled.clips.end(), [&clip](const Clip& c) {
+          return c.name == clip;
+      })};
+      return it == compiled.clips.end() ? AnyClip : static_cast<std::uint32_t>(it - compiled.clips.begin());
+  }};
+
+  if (set.initial.empty() == false)
+  {
+    compiled.initial = clipIndex(set.initial);
+    if (compiled.initial == AnyClip)
+    {
+      RIPSAW_LOG_ERROR(Systems, "Initial clip %s of animation set %s doesn't exist", set.initial.c_str(), name.c_str());
+      return false;
+    }
+  }
+
+  for (const auto& transition : set.transitions)
+  {
+    std::uint32_t from{transition.from.empty() ? AnyClip : clipIndex(transition.from)};
+    std::uint32_t to{clipIndex(transition.to)};
+    if ((transition.from.empty() == false and from == AnyClip) or to == AnyClip)
+    {
+      RIPSAW_LOG_ERROR(Systems, "Transition %s -> %s of animation set %s names an unknown clip", transition.from.c_str(), transition.to.c_str(), name.c_str());
+      return false;
+    }
+
+    std::int32_t trigger{NoTrigger};
+    if (transition.trigger.empty() == false)
+    {
+      auto it{std::find(compiled.triggers.begin(), compiled.triggers.end(), transition.trigger)};
+      trigger = static_cast<std::int32_t>(it - compiled.triggers.begin());
+      if (it == compiled.triggers.end())
+        compiled.triggers.push_back(transition.trigger);
+    }
+    compiled.transitions.push_back({from, to, trigger});
+  }
+
+  mSets.emplace(name, std::move(compiled));
+  return true;
+}
+
+bool AnimationSystem::hasSet(const std::string& name) const
+{
+  return mSets.contains(name);
+}
+
+Handle AnimationSystem::create(const std::string& setName, const SpriteComponent* sprite)
+{
+  auto it{mSets.find(setName)};
+  if (it == mSets.end())
+  {
+    RIPSAW_LOG_ERROR(Systems, "Animation set not registered: %s", setName.c_str());
+    return {};
+  }
+
+  Handle handle{mTable.allocate()};
+  Animator animator{};
+  animator.set = &it->second;
+  animator.sprite = sprite;
+  enter(animator, animator.set->initial);
+  mAnimators.push_back(animator);
+  return handle;
+}
+
+void AnimationSystem::destroy(Handle handle)
+{
+  if (mTable.isValid(handle) == false)
+    return;
+
+  HandleTable::Removal removal{mTable.release(handle)};
+  mAnimators[removal.index] = mAnimators[removal.last];
+  mAnimators.pop_back();
+}
+
+bool AnimationSystem::isValid(Handle handle) const
+{
+  return mTable.isValid(handle);
+}
+
+void AnimationSystem::play(Handle handle, const std::string& clip)
+{
+  Animator& animator{mAnimators[mTable.indexOf(handle)]};
+  const std::vector<Clip>& clips{animator.set->clips};
+  auto it{std::find_if(clips.begin(), clips.end(), [&clip](const Clip& c) {
+      return c.name == clip;
+  })};
+  if (it == clips.end())
+  {
+    RIPSAW_LOG_ERROR(Systems, "Animation clip not found: %s", clip.c_str());
+    return;
+  }
+  enter(animator, static_cast<std::uint32_t>(it - clips.begin()));
+}
+
+void AnimationSystem::trigger(Handle handle, const std::string& trigger)
+{
+  Animator& animator{mAnimators[mTable.indexOf(handle)]};
+  const std::vector<std::string>& triggers{animator.set->triggers};
+  auto it{std::find(triggers.begin(), triggers.end(), trigger)};
+  if (it == triggers.end())
+  {
+    RIPSAW_LOG_ERROR(Systems, "Animation trigger not found: %s", trigger.c_str());
+    return;
+  }
+  animator.trigger = static_cast<std::int32_t>(it - triggers.begin());
+}
+
+const std::string& AnimationSystem::getState(Handle handle) const
+{
+  const Animator& animator{mAnimators[mTable.indexOf(handle)]};
+  return animator.set->clips[animator.clip].name;
+}
+
+bool AnimationSystem::isFinished(Handle handle) const
+{
+  return mAnimators[mTable.indexOf(handle)].isFinished;
+}
+
+void AnimationSystem::setPaused(Handle handle, bool paused)
+{
+  mAnimators[mTable.indexOf(handle)].isPaused = paused;
+}
+
+void AnimationSystem::setSpeed(Handle handle, float speed)
+{
+  mAnimators[mTable.indexOf(handle)].speed = std::max(speed, 0.f);
+}
+
+glm::ivec2 AnimationSystem::getCoord(Handle handle) const
+{
+  const Animator& animator{mAnimators[mTable.indexOf(handle)]};
+  return animator.set->clips[animator.clip].frames[animator.frame].coord;
+}
+
+void AnimationSystem::setCulling(bool culling)
+{
+  mIsCulling = culling;
+}
+
+bool AnimationSystem::isCulling() const
+{
+  return mIsCulling;
+}
+
+void AnimationSystem::update(double dt, const std::vector<Camera>& cameras, JobSystem& jobs)
+{
+  mViews.clear();
+  for (const auto& camera : cameras)
+  {
+    mViews.push_back(camera.getViewBounds());
+  }
+
+  float step{static_cast<float>(dt)};
+  jobs.parallelFor(mAnimators.size(), [this, step](std::size_t begin, std::size_t end) {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        Animator& animator{mAnimators[i]};
+        if (animator.trigger != NoTrigger)
+        {
+          for (const auto& transition : animator.set->transitions)
+          {
+            if (transition.trigger == animator.trigger and (transition.from == AnyClip or transition.from == animator.clip))
+            {
+              enter(animator, transition.to);
+              break;
+            }
+          }
+          animator.trigger = NoTrigger;
+        }
+        if (animator.isPaused)
+          continue;
+
+        float time{step * animator.speed + animator.banked};
+        if (mIsCulling and this->isOnScreen(animator.sprite) == false)
+        {
+          float period{animator.set->clips[animator.clip].period};
+          animator.banked = period > 0.f and time > period ? std::fmod(time, period) : time;
+          continue;
+        }
+        animator.banked = 0.f;
+        advance(animator, time);
+      }
+  }, AnimatorGrain);
+}
+
+std::size_t AnimationSystem::size() const
+{
+  return mAnimators.size();
+}
+
+void AnimationSystem::clear()
+{
+  mTable.clear();
+  mAnimators.clear();
+  mSets.clear();
+}
+
+void AnimationSystem::enter(Animator& animator, std::uint32_t clip)
+{
+  animator.clip = clip;
+  animator.frame = 0;
+  animator.time = 0.f;
+  animator.direction = 1;
+  animator.isFinished = false;
+}
+
+void AnimationSystem::advance(Animator& animator, float time)
+{
+  if (animator.isFinished)
+    return;
+
+  const Clip* clip{&animator.set->clips[animator.clip]};
+  // A repeating clip is back in the same state after each period, so whole periods can be dropped.
+  if (clip->period > 0.f and time > clip->period)
+    time = std::fmod(time, clip->period);
+
+  animator.time += time;
+  while (animator.time >= clip->frames[animator.frame].duration)
+  {
+    animator.time -= clip->frames[animator.frame].duration;
+    std::uint32_t count{static_cast<std::uint32_t>(clip->frames.size())};
+    switch (clip->mode)
+    {
+      case AnimationMode::Loop:
+        animator.frame = (animator.frame + 1) % count;
+        break;
+      case AnimationMode::PingPong:
+        if (count == 1)
+          break;
+        if ((animator.direction > 0 and animator.frame + 1 == count) or (animator.direction < 0 and animator.frame == 0))
+          animator.direction = static_cast<std::int8_t>(-animator.direction);
+        animator.frame = animator.direction > 0 ? animator.frame + 1 : animator.frame - 1;
+        break;
+      case AnimationMode::Once:
+        if (animator.frame + 1 < count)
+        {
+          ++animator.frame;
+          break;
+        }
+        animator.isFinished = true;
+        for (const auto& transition : animator.set->transitions)
+        {
+          if (transition.trigger == NoTrigger and (transition.from == AnyClip or transition.from == animator.clip))
+          {
+            // Time left over goes into the next clip. Frames have positive durations, so this ends.
+            float left{animator.time};
+            enter(animator, transition.to);
+            clip = &animator.set->clips[animator.clip];
+            animator.time = clip->period > 0.f and left > clip->period ? std::fmod(left, clip->period) : left;
+            break;
+          }
+        }
+        if (animator.isFinished)
+        {
+          animator.time = 0.f;
+          return;
+        }
+        break;
+    }
+  }
+}
+
+bool AnimationSystem::isOnScreen(const SpriteComponent* sprite) const
+{
+  if (sprite->isScreenSpace())
+    return true;
+
+  Aabb bounds{sprite->getBounds()};
+  return std::any_of(mViews.begin(), mViews.end(), [&bounds](const Aabb& view) {
+      return bounds.overlaps(view);
+  });
+}
+
+}
@@ -0,0 +1,141 @@
+#include "RipsawEngine/2D/Scene/Actor.hxx"
+#include "RipsawEngine/2D/Scene/ArchetypeStore.hxx"
+
+#include <bit>
+
+namespace RipsawEngine
+{
+
+void ArchetypeStore::add(Actor* actor)
+{
+  this->insert(actor, this->archetypeOf(actor->getComponentMask()));
+}
+
+void ArchetypeStore::remove(Actor* actor)
+{
+  ArchetypeLocation location{actor->getArchetypeLocation()};
+  if (location.archetype == NoArchetype)
+    return;
+
+  this->erase(location);
+  actor->setArchetypeLocation({});
+}
+
+void ArchetypeStore::update(Actor* actor)
+{
+  ArchetypeLocation location{actor->getArchetypeLocation()};
+  if (location.archetype == NoArchetype)
+    return;
+
+  std::uint32_t target{this->archetypeOf(actor->getComponentMask())};
+  if (target == location.archetype)
+    return;
+  this->erase(location);
+  this->insert(actor, target);
+}
+
+std::size_t ArchetypeStore::count(ComponentMask mask)
+{
+  std::size_t total{};
+  for (std::uint32_t index : this->match(mask))
+  {
+    total += mArchetypes[index].size;
+  }
+  return total;
+}
+
+std::size_t ArchetypeStore::getArchetypeCount() const
+{
+  return mArchetypes.size();
+}
+
+void ArchetypeStore::clear()
+{
+  for (const auto& archetype : mArchetypes)
+  {
+    for (const auto& chunk : archetype.chunks)
+    {
+      for (std::size_t row{}; row < chunk.count; ++row)
+      {
+        chunk.actors[row]->setArchetypeLocation({});
+      }
+    }
+  }
+  mArchetypes.clear();
+  mIndex.clear();
+  mQueries.clear();
+}
+
+const std::vector<std::uint32_t>& ArchetypeStore::match(ComponentMask mask)
+{
+  auto [it, isNew]{mQueries.try_emplace(mask)};
+  if (isNew)
+  {
+    for (std::uint32_t index{}; index < mArchetypes.size(); ++index)
+    {
+      if ((mArchetypes[index].mask & mask) == mask)
+        it->second.push_back(index);
+    }
+  }
+  return it->second;
+}
+
+std::uint32_t ArchetypeStore::archetypeOf(ComponentMask mask)
+{
+  auto it{mIndex.find(mask)};
+  if (it != mIndex.end())
+    return it->second;
+
+  std::uint32_t index{static_cast<std::uint32_t>(mArchetypes.size())};
+  mArchetypes.push_back({mask, static_cast<std::size_t>(std::popcount(mask)), 0, {}});
+  mIndex.emplace(mask, index);
+  mQueries.clear();
+  return index;
+}
+
+void ArchetypeStore::insert(Actor* actor, std::uint32_t archetype)
+{
+  Archetype& target{mArchetypes[archetype]};
+  std::size_t row{target.size};
+  if (row / ChunkCapacity == target.chunks.size())
+  {
+    target.chunks.push_back({0, std::make_unique<Actor*[]>(ChunkCapacity), std::make_unique<Component*[]>(target.columns * ChunkCapacity)});
+  }
+
+  Chunk& chunk{target.chunks[row / ChunkCapacity]};
+  std::size_t slot{row % ChunkCapacity};
+  chunk.actors[slot] = actor;
+  std::size_t column{};
+  for (ComponentMask bits{target.mask}; bits != 0; bits &= bits - 1)
+  {
+    chunk.components[column++ * ChunkCapacity + slot] = actor->getComponent(static_cast<ComponentTypeId>(std::countr_zero(bits)));
+  }
+  ++chunk.count;
+  ++target.size;
+  actor->setArchetypeLocation({archetype, static_cast<std::uint32_t>(row)});
+}
+
+void ArchetypeStore::erase(ArchetypeLocation location)
+{
+  Archetype& source{mArchetypes[location.archetype]};
+  std::size_t last{source.size - 1};
+  Chunk& lastChunk{source.chunks[last / ChunkCapacity]};
+  std::size_t lastSlot{last % ChunkCapacity};
+
+  if (location.row != last)
+  {
+    Chunk& chunk{source.chunks[location.row / ChunkCapacity]};
+    std::size_t slot{location.row % ChunkCapacity};
+    Actor* moved{lastChunk.actors[lastSlot]};
+    chunk.actors[slot] = moved;
+    for (std::size_t column{}; column < source.columns; ++column)
+    {
+      chunk.components[column * ChunkCapacity + slot] = lastChunk.components[column * ChunkCapacity + lastSlot];
+    }
+    moved->setArchetypeLocation(location);
+  }
+  --lastChunk.count;
+  --source.size;
+}
+
+}
@@ -0,0 +1,192 @@
+#include "RipsawEngine/2D/Core/Profiler.hxx"
+#include "RipsawEngine/2D/Render/AssetLoader.hxx"
+#include "RipsawEngine/2D/Render/TextureCache.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <SDL3_image/SDL_image.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace RipsawEngine
+{
+
+AssetLoader::~AssetLoader()
+{
+  this->stop();
+}
+
+void AssetLoader::start(TextureCache* cache, std::size_t workers)
+{
+  if (!mWorkers.empty())
+    return;
+
+  mCache = cache;
+  if (workers == 0)
+  {
+    // Leave one core to the main thread, and don't starve it with too many decoders either.
+    std::size_t cores{std::thread::hardware_concurrency()};
+    workers = std::clamp<std::size_t>(cores > 1 ? cores - 1 : 1, 1, 4);
+  }
+
+  mIsStopping = false;
+  for (std::size_t i{}; i < workers; ++i)
+  {
+    mWorkers.emplace_back(&AssetLoader::workerLoop, this);
+  }
+  RIPSAW_LOG_INFO(Assets, "Asset loader started with %zu worker threads", workers);
+}
+
+void AssetLoader::stop()
+{
+  {
+    std::scoped_lock lock{mDecodeMutex};
+    mIsStopping = true;
+  }
+  mDecodeCondition.notify_all();
+  for (auto& worker : mWorkers)
+  {
+    worker.join();
+  }
+  mWorkers.clear();
+
+  for (auto& job : mDecodeJobs)
+  {
+    job.promise.set_value(false);
+  }
+  mDecodeJobs.clear();
+  for (auto& job : mUploadJobs)
+  {
+    SDL_DestroySurface(job.surface);
+    job.promise.set_value(false);
+  }
+  mUploadJobs.clear();
+  mInFlight.clear();
+}
+
+std::shared_future<bool> AssetLoader::loadTexture(const std::string& path)
+{
+  auto it{mInFlight.find(path)};
+  if (it != mInFlight.end())
+  {
+    ++it->second.claims;
+    return it->second.future;
+  }
+
+  std::promise<bool> promise{};
+  std::shared_future<bool> future{promise.get_future().share()};
+  if (mCache != nullptr and mCache->contains(path))
+  {
+    mCache->pin(path);
+    promise.set_value(true);
+    return future;
+  }
+  if (mWorkers.empty())
+  {
+    RIPSAW_LOG_ERROR(Assets, "Asset loader is not running: %s", path.c_str());
+    promise.set_value(false);
+    return future;
+  }
+
+  mInFlight.emplace(path, InFlight{future, 1});
+  {
+    std::scoped_lock lock{mDecodeMutex};
+    mDecodeJobs.push_back(DecodeJob{path, std::move(promise)});
+  }
+  mDecodeCondition.notify_one();
+  return future;
+}
+
+void AssetLoader::releaseTexture(const std::string& path)
+{
+  auto it{mInFlight.find(path)};
+  if (it == mInFlight.end())
+  {
+    // Uploaded already, so the claim is a pin in the cache.
+    if (mCache != nullptr)
+      mCache->unpin(path);
+    return;
+  }
+  if (it->second.claims > 0)
+    --it->second.claims;
+}
+
+std::size_t AssetLoader::pumpUploads()
+{
+  RIPSAW_PROFILE_ZONE("AssetLoader::pumpUploads");
+  Uint64 start{SDL_GetTicksNS()};
+  std::size_t uploaded{};
+
+  while (true)
+  {
+    UploadJob job{};
+    {
+      std::scoped_lock lock{mUploadMutex};
+      if (mUploadJobs.empty())
+        break;
+      job = std::move(mUploadJobs.front());
+      mUploadJobs.pop_front();
+    }
+
+    auto it{mInFlight.find(job.path)};
+    std::size_t claims{it != mInFlight.end() ? it->second.claims : 0};
+    bool isLoaded{job.surface != nullptr and mCache->insert(job.path, job.surface, claims)};
+    SDL_DestroySurface(job.surface);
+    if (it != mInFlight.end())
+      mInFlight.erase(it);
+    job.promise.set_value(isLoaded);
+    ++uploaded;
+
+    if (SDL_GetTicksNS() - start >= mUploadBudget)
+      break;
+  }
+
+  return uploaded;
+}
+
+void AssetLoader::setUploadBudget(Uint64 ns)
+{
+  mUploadBudget = ns;
+}
+
+Uint64 AssetLoader::getUploadBudget() const
+{
+  return mUploadBudget;
+}
+
+std::size_t AssetLoader::getPending() const
+{
+  return mInFlight.size();
+}
+
+void AssetLoader::workerLoop()
+{
+  RIPSAW_PROFILE_THREAD("Asset loader");
+  while (true)
+  {
+    DecodeJob job{};
+    {
+      std::unique_lock lock{mDecodeMutex};
+      mDecodeCondition.wait(lock, [this] { return mIsStopping or !mDecodeJobs.empty(); });
+      if (mIsStopping)
+        return;
+      job = std::move(mDecodeJobs.front());
+      mDecodeJobs.pop_front();
+    }
+
+    SDL_Surface* surface{nullptr};
+    {
+      RIPSAW_PROFILE_ZONE("AssetLoader::decode");
+      surface = IMG_Load(job.path.c_str());
+    }
+    if (surface == nullptr)
+    {
+      RIPSAW_LOG_ERROR(Assets, "Failed to load image: %s", job.path.c_str());
+    }
+
+    std::scoped_lock lock{mUploadMutex};
+    mUploadJobs.push_back(UploadJob{std::move(job.path), surface, std::move(job.promise)});
+  }
+}
+
+}
@@ -1,142 +1,138 @@
 #include "RipsawEngine/2D/Core/Engine.hxx"
 #include "RipsawEngine/2D/Managers/BGManager.hxx"
-#include "RipsawEngine/2D/Scene/Actor.hxx"
-#include "RipsawEngine/2D/Scene/SpriteComponent.hxx"
-#include "RipsawEngine/2D/Scene/TransformComponent.hxx"
-
-#include <glm/glm.hpp>
+#include "RipsawEngine/2D/Render/RenderPacket.hxx"
+#include "RipsawEngine/Common/Log.hxx"
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 namespace RipsawEngine
 {
 
+namespace
+{
+
+/// Returns fractional part of value, in [0, 1) for negative values too.
+float wrap(float value)
+{
+  return value - std::floor(value);
+}
+
+}
+
 BGManager::BGManager(Engine* engine, const std::vector<std::string>& layers, const std::vector<float>& layerSpeeds)
-  : mEngine{engine},
-    mLayers{layers},
-    mLayerSpeeds{layerSpeeds}
+  : mEngine{engine}
 {
-  if (mLayers.size() != mLayerSpeeds.size())
+  if (layers.size() != layerSpeeds.size())
   {
     throw std::runtime_error{"BGManager::BGManager(): layers should be provided with equal number of speed factors"};
   }
-  mActorTriplets.reserve(mLayers.size() * 3);
+  mLayers.reserve(layers.size());
 
-  for (size_t i{}; i < mLayers.size(); ++i)
+  float sw{static_cast<float>(mEngine->getScreenSize().first)};
+  float sh{static_cast<float>(mEngine->getScreenSize().second)};
+  for (size_t i{}; i < layers.size(); ++i)
   {
-    Actor* middle{nullptr};
-    Actor* right{nullptr};
-    Actor* left{nullptr};
-
-    middle = mEngine->createActor();
-    middle->createTransformComponent({0, 0}, {mLayerSpeeds[i], 0});
-    middle->createSpriteComponent(mLayers[i]);
-    middle->getSpriteComponent()->fitByAspectRatio();
-    middle->setPosition({static_cast<float>(mEngine->getScreenSize().first) / 2.f, static_cast<float>(mEngine->getScreenSize().second) / 2.f});
-
-    right = mEngine->createActor();
-    right->createTransformComponent({0, 0}, {mLayerSpeeds[i], 0});
-    right->createSpriteComponent(mLayers[i]);
-    right->getSpriteComponent()->fitByAspectRatio();
-    right->setPosition({middle->getPosition().x + middle->getSpriteComponent()->getTexSize().x, static_cast<float>(mEngine->getScreenSize().second) / 2.f});
-    
-    left = mEngine->createActor();
-    left->createTransformComponent({0, 0}, {mLayerSpeeds[i], 0});
-    left->createSpriteComponent(mLayers[i]);
-    left->getSpriteComponent()->fitByAspectRatio();
-    left->setPosition({middle->getPosition().x - middle->getSpriteComponent()->getTexSize().x, static_cast<float>(mEngine->getScreenSize().second) / 2.f});
-
-    mActorTriplets.push_back(std::make_tuple(middle, right, left));
+    Layer layer{};
+    layer.image = layers[i];
+    layer.region = mEngine->getTextureCache().acquire(layer.image);
+    layer.velocity = {layerSpeeds[i], 0};
+    if (layer.region.texture == nullptr or layer.region.rect.w <= 0 or layer.region.rect.h <= 0)
+    {
+      RIPSAW_LOG_ERROR(Render, "BGManager failed to load layer: %s", layer.image.c_str());
+    }
+    else
+    {
+      // Same fit as SpriteComponent::fitByAspectRatio(): cover the screen, preserving aspect ratio.
+      float scale{std::max(sw / layer.region.rect.w, sh / layer.region.rect.h)};
+      layer.screenTileSize = {layer.region.rect.w * scale, layer.region.rect.h * scale};
+    }
+    mLayers.push_back(layer);
   }
 }
 
-void BGManager::update()
+BGManager::~BGManager()
 {
-  for (const auto& triplet : mActorTriplets)
+  for (const auto& layer : mLayers)
   {
-    Actor* middle{std::get<0>(triplet)};
-    Actor* right{std::get<1>(triplet)};
-    Actor* left{std::get<2>(triplet)};
-
-    if (middle->getPosition().x + middle->getSpriteComponent()->getTexSize().x / 2.f < 0)
-    {
-      left->setPosition({
-        right->getPosition().x + right->getSpriteComponent()->getTexSize().x,
-        static_cast<float>(right->getEngine()->getScreenSize().second) / 2.f
-      });
-    }
-    
-    if (right->getPosition().x + right->getSpriteComponent()->getTexSize().x / 2.f < 0)
-    {
-      middle->setPosition({
-        left->getPosition().x + left->getSpriteComponent()->getTexSize().x,
-        static_cast<float>(left->getEngine()->getScreenSize().second) / 2.f
-      });
-    }
-    
-    if (left->getPosition().x + left->getSpriteComponent()->getTexSize().x / 2.f < 0)
-    {
-      right->setPosition({
-        middle->getPosition().x + middle->getSpriteComponent()->getTexSize().x,
-        static_cast<float>(middle->getEngine()->getScreenSize().second) / 2.f
-      });
-    }
-    
-    if (middle->getPosition().x - middle->getSpriteComponent()->getTexSize().x / 2.f > static_cast<float>(middle->getEngine()->getScreenSize().first))
-    {
-      right->setPosition({
-        left->getPosition().x - left->getSpriteComponent()->getTexSize().x,
-        static_cast<float>(left->getEngine()->getScreenSize().second) / 2.f
-      });
-    }
-    
-    if (left->getPosition().x - left->getSpriteComponent()->getTexSize().x / 2.f > static_cast<float>(left->getEngine()->getScreenSize().first))
-    {
-      middle->setPosition({
-        right->getPosition().x - right->getSpriteComponent()->getTexSize().x,
-        static_cast<float>(right->getEngine()->getScreenSize().second) / 2.f
-      });
-    }
-    
-    if (right->getPosition().x - right->getSpriteComponent()->getTexSize().x / 2.f > static_cast<float>(right->getEngine()->getScreenSize().first))
-    {
-      left->setPosition({
-        middle->getPosition().x - middle->getSpriteComponent()->getTexSize().x,
-        static_cast<float>(middle->getEngine()->getScreenSize().second) / 2.f
-      });
-    }
+    if (layer.region.texture != nullptr)
+      mEngine->getTextureCache().release(layer.image);
   }
 }
 
+void BGManager::update()
+{}
+
 void BGManager::setSpeeds(const std::vector<float>& speeds)
 {
   if (mLayers.size() != speeds.size())
   {
     throw std::runtime_error{"BGManager::setSpeeds(): layers should be provided with equal number of speed factors"};
   }
-  mLayerSpeeds = speeds;
-  size_t i{};
-
-  for (const auto& triplet : mActorTriplets)
+  for (size_t i{}; i < mLayers.size(); ++i)
   {
-    std::get<0>(triplet)->getTransformComponent()->setVelocity({mLayerSpeeds[i], 0});
-    std::get<1>(triplet)->getTransformComponent()->setVelocity({mLayerSpeeds[i], 0});
-    std::get<2>(triplet)->getTransformComponent()->setVelocity({mLayerSpeeds[i], 0});
-    ++i;
+    mLayers[i].velocity.x = speeds[i];
   }
 }
   
 void BGManager::changeSpeedBy(float dx, float dy)
 {
-  for (const auto& triplet : mActorTriplets)
+  for (auto& layer : mLayers)
+  {
+    layer.velocity += glm::vec2{dx, dy};
+  }
+}
+
+void BGManager::setCameraFactors(const std::vector<glm::vec2>& factors)
+{
+  if (mLayers.size() != factors.size())
+  {
+    throw std::runtime_error{"BGManager::setCameraFactors(): layers should be provided with equal number of camera factors"};
+  }
+  for (size_t i{}; i < mLayers.size(); ++i)
+  {
+    mLayers[i].cameraFactor = factors[i];
+  }
+}
+
+void BGManager::animate(double dt)
+{
+  for (auto& layer : mLayers)
   {
-    glm::vec2 currentVel{std::get<0>(triplet)->getTransformComponent()->getVelocity()};
-    
-    std::get<0>(triplet)->getTransformComponent()->setVelocity({currentVel.x + dx, currentVel.y + dy});
-    std::get<1>(triplet)->getTransformComponent()->setVelocity({currentVel.x + dx, currentVel.y + dy});
-    std::get<2>(triplet)->getTransformComponent()->setVelocity({currentVel.x + dx, currentVel.y + dy});
+    if (layer.region.texture == nullptr)
+      continue;
+    // Phase is measured in tiles so that it wraps without drift and means the same in every viewport.
+    layer.phase.x = wrap(layer.phase.x + layer.velocity.x * static_cast<float>(dt) / layer.screenTileSize.x);
+    layer.phase.y = wrap(layer.phase.y + layer.velocity.y * static_cast<float>(dt) / layer.screenTileSize.y);
   }
 }
 
+void BGManager::submit(RenderPacket& packet, std::size_t cameraIndex) const
+{
+  const Camera& camera{packet.cameras[cameraIndex]};
+  SDL_FRect viewport{camera.getViewportRect()};
+  for (const auto& layer : mLayers)
+  {
+    if (layer.region.texture == nullptr)
+      continue;
+
+    float scale{std::max(viewport.w / layer.region.rect.w, viewport.h / layer.region.rect.h)};
+    glm::vec2 tile{layer.region.rect.w * scale, layer.region.rect.h * scale};
+    // Image coordinate at the top-left of the viewport, in tiles: the image starts centered, content moves with the phase and against the camera.
+    glm::vec2 follow{camera.getPosition() * layer.cameraFactor};
+    float u{wrap((tile.x - viewport.w) / (2.f * tile.x) - layer.phase.x + follow.x / layer.screenTileSize.x)};
+    float v{wrap((tile.y - viewport.h) / (2.f * tile.y) - layer.phase.y + follow.y / layer.screenTileSize.y)};
+
+    // A tile covers the viewport, so at most two tiles per axis are visible.
+    for (float y{viewport.y - v * tile.y}; y < viewport.y + viewport.h; y += tile.y)
+    {
+      for (float x{viewport.x - u * tile.x}; x < viewport.x + viewport.w; x += tile.x)
+      {
+        packet.quads.push_back({cameraIndex, layer.region.texture, layer.region.rect, {x, y, tile.x, tile.y}});
+      }
+    }
+  }
 }
 
+}
@@ -0,0 +1,122 @@
+#include "RipsawEngine/2D/Render/Camera.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <cmath>
+#include <numbers>
+
+namespace RipsawEngine
+{
+
+Camera::Camera(const SDL_FRect& viewport)
+{
+  this->setViewport(viewport);
+}
+
+const glm::vec2& Camera::getPosition() const
+{
+  return mPosition;
+}
+
+void Camera::setPosition(const glm::vec2& pos)
+{
+  mPosition = pos;
+}
+
+void Camera::move(const glm::vec2& offset)
+{
+  mPosition += offset;
+}
+
+float Camera::getZoom() const
+{
+  return mZoom;
+}
+
+void Camera::setZoom(float zoom)
+{
+  if (zoom <= 0.f)
+  {
+    RIPSAW_LOG_ERROR(Render, "Camera zoom should be positive");
+    return;
+  }
+  mZoom = zoom;
+}
+
+double Camera::getRotation() const
+{
+  return mRotation;
+}
+
+void Camera::setRotation(double degrees)
+{
+  mRotation = degrees;
+  double radians{degrees * std::numbers::pi / 180.0};
+  mCos = static_cast<float>(std::cos(radians));
+  mSin = static_cast<float>(std::sin(radians));
+}
+
+const SDL_FRect& Camera::getViewport() const
+{
+  return mViewport;
+}
+
+void Camera::setViewport(const SDL_FRect& viewport)
+{
+  if (viewport.w <= 0.f or viewport.h <= 0.f or viewport.x < 0.f or viewport.y < 0.f or viewport.x + viewport.w > 1.f or viewport.y + viewport.h > 1.f)
+  {
+    RIPSAW_LOG_ERROR(Render, "Camera viewport should lie inside the screen, given as fractions of screen size");
+    return;
+  }
+  mViewport = viewport;
+}
+
+SDL_FRect Camera::getViewportRect() const
+{
+  return {mViewport.x * mScreenSize.x, mViewport.y * mScreenSize.y, mViewport.w * mScreenSize.x, mViewport.h * mScreenSize.y};
+}
+
+void Camera::setScreenSize(const glm::vec2& size)
+{
+  mScreenSize = size;
+}
+
+glm::vec2 Camera::worldToScreen(const glm::vec2& point) const
+{
+  SDL_FRect rect{this->getViewportRect()};
+  glm::vec2 d{(point - mPosition) * mZoom};
+  // The world turns against the camera: rotate by -rotation in screen space where Y grows downwards.
+  return {rect.x + rect.w / 2.f + d.x * mCos + d.y * mSin, rect.y + rect.h / 2.f - d.x * mSin + d.y * mCos};
+}
+
+glm::vec2 Camera::screenToWorld(const glm::vec2& point) const
+{
+  SDL_FRect rect{this->getViewportRect()};
+  glm::vec2 d{point.x - rect.x - rect.w / 2.f, point.y - rect.y - rect.h / 2.f};
+  return mPosition + glm::vec2{d.x * mCos - d.y * mSin, d.x * mSin + d.y * mCos} / mZoom;
+}
+
+Aabb Camera::getViewBounds() const
+{
+  SDL_FRect rect{this->getViewportRect()};
+  float hw{rect.w / 2.f / mZoom};
+  float hh{rect.h / 2.f / mZoom};
+  float c{std::abs(mCos)};
+  float s{std::abs(mSin)};
+  glm::vec2 half{hw * c + hh * s, hw * s + hh * c};
+  return {mPosition - half, mPosition + half};
+}
+
+SDL_FRect Camera::projectRect(const SDL_FRect& rect, bool screenSpace, double& angle) const
+{
+  SDL_FRect viewport{this->getViewportRect()};
+  if (screenSpace)
+    return {rect.x + viewport.x, rect.y + viewport.y, rect.w, rect.h};
+
+  glm::vec2 center{this->worldToScreen({rect.x + rect.w / 2.f, rect.y + rect.h / 2.f})};
+  float w{rect.w * mZoom};
+  float h{rect.h * mZoom};
+  angle -= mRotation;
+  return {center.x - w / 2.f, center.y - h / 2.f, w, h};
+}
+
+}
@@ -0,0 +1,70 @@
+#include "RipsawEngine/2D/Core/Engine.hxx"
+#include "RipsawEngine/2D/Scene/Actor.hxx"
+#include "RipsawEngine/2D/Scene/CommandBuffer.hxx"
+
+#include <utility>
+
+namespace RipsawEngine
+{
+
+void CommandBuffer::createActor(ActorFunction setup)
+{
+  mCommands.push_back({CommandType::Create, {}, std::move(setup)});
+}
+
+void CommandBuffer::destroyActor(Handle actor)
+{
+  mCommands.push_back({CommandType::Destroy, actor, {}});
+}
+
+void CommandBuffer::modifyActor(Handle actor, ActorFunction change)
+{
+  mCommands.push_back({CommandType::Modify, actor, std::move(change)});
+}
+
+void CommandBuffer::apply(Engine& engine)
+{
+  // Commands applied here may record new ones into this very buffer, so indices are used instead of iterators.
+  for (std::size_t i{}; i < mCommands.size(); ++i)
+  {
+    Command command{std::move(mCommands[i])};
+    switch (command.type)
+    {
+      case CommandType::Create:
+      {
+        Actor* actor{engine.createActor()};
+        if (command.function)
+          command.function(actor);
+        break;
+      }
+      case CommandType::Destroy:
+        engine.destroyActor(command.actor);
+        break;
+      case CommandType::Modify:
+      {
+        Actor* actor{engine.getActor(command.actor)};
+        if (actor != nullptr)
+          command.function(actor);
+        break;
+      }
+    }
+  }
+  mCommands.clear();
+}
+
+std::size_t CommandBuffer::size() const
+{
+  return mCommands.size();
+}
+
+bool CommandBuffer::isEmpty() const
+{
+  return mCommands.empty();
+}
+
+void CommandBuffer::clear()
+{
+  mCommands.clear();
+}
+
+}
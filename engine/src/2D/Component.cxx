@@ -1,9 +1,38 @@
 #include "RipsawEngine/2D/Scene/Actor.hxx"
 #include "RipsawEngine/2D/Scene/Component.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <string>
 
 namespace RipsawEngine
 {
 
+namespace
+{
+
+/// Declaration that claimed each type id, nullptr while free.
+constinit std::array<std::atomic<const ComponentTypeId*>, ComponentTypeIds::Count> claimedTypeIds{};
+
+}
+
+ComponentTypeId claimComponentTypeId(ComponentTypeId id, const ComponentTypeId* declaration)
+{
+  if (id == ComponentTypeIds::Spatial)
+  {
+    throw std::runtime_error{"[ABORT] Component type id " + std::to_string(id) + " is reserved for the spatial hash"};
+  }
+  std::atomic<const ComponentTypeId*>& slot{claimedTypeIds[id]};
+  const ComponentTypeId* expected{nullptr};
+  if (slot.compare_exchange_strong(expected, declaration) == false and expected != declaration)
+  {
+    throw std::runtime_error{"[ABORT] Two component types declare type id " + std::to_string(id)};
+  }
+  return id;
+}
+
 Component::Component(Actor* actor)
   : mOwner{actor}
 {
@@ -12,7 +41,7 @@ Component::Component(Actor* actor)
 
 Component::~Component()
 {
-  SDL_Log("[INFO] Removed Component: %p from Actor: %p", static_cast<void*>(this), static_cast<void*>(mOwner));
+  RIPSAW_LOG_DEBUG(Scene, "Removed Component: %p from Actor: %p", static_cast<void*>(this), static_cast<void*>(mOwner));
 }
 
 void Component::update([[maybe_unused]] double dt)
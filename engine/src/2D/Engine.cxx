@@ -1,10 +1,15 @@
 #include "RipsawEngine/2D/Core/Engine.hxx"
 #include "RipsawEngine/2D/Core/Game.hxx"
+#include "RipsawEngine/2D/Core/Profiler.hxx"
 #include "RipsawEngine/2D/Managers/BGManager.hxx"
 #include "RipsawEngine/2D/Scene/Actor.hxx"
 #include "RipsawEngine/2D/Scene/SpriteComponent.hxx"
+#include "RipsawEngine/2D/Scene/SpritesheetComponent.hxx"
 #include "RipsawEngine/2D/Scene/TransformComponent.hxx"
+#include "RipsawEngine/Common/Log.hxx"
 
+#include <cmath>
+#include <limits>
 #include <stdexcept>
 
 namespace RipsawEngine
@@ -14,6 +19,8 @@ Engine::Engine(Game* game, const std::string& wname, int w, int h)
   : mWname{wname},
     mGame{game}
 {
+  mTransformSystem.setSpatialHash(&mSpatialHash);
+
   if (w != 0 and h != 0)
   {
     mIsDisplaySetManually = true;
@@ -23,6 +30,11 @@ Engine::Engine(Game* game, const std::string& wname, int w, int h)
 }
 
 Engine::~Engine()
+{
+  this->destroyScene();
+}
+
+void Engine::destroyScene()
 {
   for (auto& manager : mManagers)
   {
@@ -30,24 +42,52 @@ Engine::~Engine()
         delete ptr;
     }, manager);
   }
+  mManagers.clear();
+  // Components deregistering as their actors go don't need to move them between archetypes.
+  mArchetypes.clear();
   while (!mActors.empty())
   {
     delete mActors.back();
     mActors.pop_back();
   }
+  mActorHandles.clear();
+  mActorsToBeDestroyed.clear();
+  for (auto& buffer : mCommandBuffers)
+  {
+    buffer.clear();
+  }
+  // Packets point at textures of the sprites going away.
+  for (auto& packet : mRenderPackets)
+  {
+    packet.clear();
+  }
+  mSprites.clear();
+  mHasSpriteHoles = false;
 }
 
 bool Engine::init()
 {
+  if (mIsHeadless)
+  {
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    mRendererBackend = "software";
+    if (mIsDisplaySetManually == false)
+    {
+      mIsDisplaySetManually = true;
+      mScreenWidth = 1280;
+      mScreenHeight = 720;
+    }
+  }
+
   if (SDL_Init(SDL_INIT_VIDEO) == false)
   {
-    SDL_Log("[ERROR] SDL_INIT_VIDEO failed");
+    RIPSAW_LOG_ERROR(Core, "SDL_INIT_VIDEO failed");
     return false;
   }
 
   if (TTF_Init() == false)
   {
-    SDL_Log("[ERROR] TTF_Init failed");
+    RIPSAW_LOG_ERROR(Core, "TTF_Init failed");
     return false;
   }
 
@@ -59,31 +99,50 @@ bool Engine::init()
     mScreenHeight = dm->h;
     if (mScreenWidth <= 0 or mScreenHeight <= 0)
       throw std::runtime_error{"[ERROR] Invalid display dimension"};
-    SDL_Log("[INFO] Detected display dimension: %d X %d", mScreenWidth, mScreenHeight);
+    RIPSAW_LOG_INFO(Core, "Detected display dimension: %d X %d", mScreenWidth, mScreenHeight);
+  }
+  RIPSAW_LOG_INFO(Core, "Display Resolution: %d X %d", mScreenWidth, mScreenHeight);
+
+  for (auto& camera : mCameras)
+  {
+    camera.setScreenSize({static_cast<float>(mScreenWidth), static_cast<float>(mScreenHeight)});
+    camera.setPosition({static_cast<float>(mScreenWidth) / 2.f, static_cast<float>(mScreenHeight) / 2.f});
   }
-  SDL_Log("[INFO] Display Resolution: %d X %d", mScreenWidth, mScreenHeight);
 
-  SDL_CreateWindowAndRenderer(
+  mWindow = SDL_CreateWindow(
     mWname.c_str(),
     mScreenWidth, mScreenHeight,
-    SDL_WINDOW_FULLSCREEN,
-    &mWindow,
-    &mRenderer
+    mIsHeadless ? SDL_WindowFlags{} : SDL_WINDOW_FULLSCREEN
   );
 
+  if (mWindow != nullptr)
+  {
+    mRenderer = SDL_CreateRenderer(mWindow, mRendererBackend.c_str());
+    if (mRenderer == nullptr)
+    {
+      RIPSAW_LOG_WARN(Core, "Renderer backend %s unavailable, falling back to default", mRendererBackend.c_str());
+      mRenderer = SDL_CreateRenderer(mWindow, nullptr);
+    }
+  }
+
   if (mWindow == nullptr or mRenderer == nullptr)
   {
-    SDL_Log("[ERROR] Failed to set up window and/or renderer");
+    RIPSAW_LOG_ERROR(Core, "Failed to set up window and/or renderer");
     return false;
   }
 
   if (mVsyncEnabled == true)
   {
     if (SDL_SetRenderVSync(mRenderer, 1) == false)
-    SDL_Log("[ERROR] Failed to enable vsync");
+    RIPSAW_LOG_WARN(Core, "Failed to enable vsync");
   }
 
   SDL_SetRenderDrawBlendMode(mRenderer, SDL_BLENDMODE_BLEND);
+  mTextureCache.setRenderer(mRenderer);
+  mAssetLoader.start(&mTextureCache);
+  // One slot for the simulation thread, so it never shares a queue or command buffer with the main thread.
+  mJobSystem.start(0, 1);
+  mCommandBuffers.resize(mJobSystem.getThreadCount());
 
   SDL_PropertiesID props = SDL_GetRendererProperties(mRenderer);
   std::string driver{SDL_GetStringProperty(
@@ -91,7 +150,7 @@ bool Engine::init()
       SDL_PROP_RENDERER_NAME_STRING,
       "unknown"
   )};
-  SDL_Log("[INFO] Renderer Backend: %s", driver.c_str());
+  RIPSAW_LOG_INFO(Core, "Renderer Backend: %s", driver.c_str());
 
   if (mGame != nullptr)
   {
@@ -99,7 +158,7 @@ bool Engine::init()
   }
   else
   {
-    SDL_Log("[ERROR] Failed to create Game object");
+    RIPSAW_LOG_ERROR(Core, "Failed to create Game object");
     return false;
   }
 
@@ -108,27 +167,131 @@ bool Engine::init()
 
 void Engine::run()
 {
+  RIPSAW_PROFILE_THREAD("Main");
   mGame->initGame();
   mTimer.start();
 
   while (mIsRunning)
   {
-    this->processInput();
-    this->updateEngine();
-    mGame->updateGame(mDt);
-    this->renderEngine();
-    mGame->renderGame();
+    if (mIsPipelined)
+      this->runPipelinedFrame();
+    else
+      this->runFrame();
+    RIPSAW_PROFILE_FRAME();
+  }
+  this->finishSimulation();
+}
+
+void Engine::runFrame()
+{
+  // Switching the pipeline off takes effect once the step simulating in the background has finished.
+  this->finishSimulation();
+  mFrameArena.reset();
+  this->processInput();
+  this->updateEngine();
+  this->renderEngine();
+  mGame->renderGame();
+}
+
+void Engine::runPipelinedFrame()
+{
+  if (mSimulationThread.isRunning() == false)
+  {
+    mSimulationThread.start("Simulation", [this]() {
+        mJobSystem.attach();
+        this->updateEngine();
+        this->extractRenderPacket(mRenderPackets[1 - mFrontPacket]);
+    });
+  }
+
+  // Sync point: the simulation thread is idle until it is kicked again, so the scene can be touched freely.
+  this->finishSimulation();
+  mFrameArena.reset();
+  this->processInput();
+  this->prepareSprites();
+  mGame->renderGame();
+
+  if (mIsRunning)
+  {
+    mIsUpdatingInParallel = true;
+    mIsSimulationInFlight = true;
+    mSimulationThread.kick();
   }
+  // Draws the previous step while the next one is simulated.
+  mPendingStats = this->drawRenderPacket(mRenderPackets[mFrontPacket]);
+}
+
+void Engine::finishSimulation()
+{
+  if (mIsSimulationInFlight == false)
+    return;
+
+  {
+    RIPSAW_PROFILE_ZONE("waitForSimulation");
+    mSimulationThread.wait();
+  }
+  mIsSimulationInFlight = false;
+  mIsUpdatingInParallel = false;
+  mFrontPacket = 1 - mFrontPacket;
+  mRenderStats = mPendingStats;
+
+  // Structural changes recorded during the step take effect here, where they race neither simulation nor drawing.
+  this->applyCommands();
+  if (mActorsToBeDestroyed.empty())
+    return;
+  this->flushDestroyedActors();
+  // Snapshots of destroyed actors may point at textures that are gone now.
+  RenderPacket& packet{mRenderPackets[mFrontPacket]};
+  for (auto& sprite : packet.sprites)
+  {
+    if (sprite.texture != nullptr and mActorHandles.isValid(sprite.actor) == false)
+      sprite.texture = nullptr;
+  }
+  // Untextured batches are drawn as squares, so batches of destroyed emitters and tilemaps are dropped instead.
+  std::erase_if(packet.particleBatches, [this](const ParticleBatch& batch) {
+      return mActorHandles.isValid(batch.actor) == false;
+  });
+  std::erase_if(packet.tileBatches, [this](const TileBatch& batch) {
+      return mActorHandles.isValid(batch.actor) == false;
+  });
 }
 
 void Engine::shutdown()
 {
   mTimer.stop();
+  mSimulationThread.stop();
+
+  // Scene and cached textures have to go before the renderer owning them.
+  this->destroyScene();
+  mAssetLoader.stop();
+  mJobSystem.stop();
+  const TextureCacheStats& stats{mTextureCache.getStats()};
+  RIPSAW_LOG_INFO(Assets, "Texture cache: %zu hits, %zu baked atlas hits, %zu misses, %zu evictions", stats.hits, stats.atlasHits, stats.misses, stats.evictions);
+  PoolUsage pools{this->getPoolUsage()};
+  RIPSAW_LOG_INFO(Core, "Pool peaks: %zu actors, %zu transforms, %zu sprites, %zu spritesheets", pools.actors.peak, pools.transforms.peak, pools.sprites.peak, pools.spritesheets.peak);
+  RIPSAW_LOG_INFO(Core, "Frame arena peak: %zu of %zu bytes", mFrameArena.getStats().peak, mFrameArena.getStats().capacity);
+#if defined(RIPSAW_ENGINE_PROFILER)
+  FrameTimeStats frameTimes{Profiler::get().getFrameTimeStats()};
+  RIPSAW_LOG_INFO(Core, "Frame times over %zu frames: p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms", frameTimes.frames, frameTimes.p50, frameTimes.p95, frameTimes.p99, frameTimes.max);
+  if (Profiler::get().isCapturing())
+  {
+    Profiler::get().stopCapture();
+    Profiler::get().writeChromeTrace(ProfilerTracePath);
+  }
+#endif
+  mTextureCache.clear();
+  Log::get().flush();
+
   SDL_DestroyRenderer(mRenderer);
   SDL_DestroyWindow(mWindow);
   SDL_Quit();
 }
 
+void Engine::quit()
+{
+  mIsRunning = false;
+}
+
 void Engine::pauseEngine()
 {
   if (mTimer.isRunning())
@@ -136,7 +299,7 @@ void Engine::pauseEngine()
     if (mTimer.isPaused() == false)
     {
       mTimer.pause();
-      SDL_Log("[INFO] Paused");
+      RIPSAW_LOG_INFO(Core, "Paused");
     }
   }
 }
@@ -148,7 +311,7 @@ void Engine::resumeEngine()
     if (mTimer.isPaused() == true)
     {
       mTimer.resume();
-      SDL_Log("[INFO] Resumed");
+      RIPSAW_LOG_INFO(Core, "Resumed");
     }
   }
 }
@@ -160,12 +323,12 @@ void Engine::enginePauseResumeToggle()
     if (mTimer.isPaused() == false)
     {
       mTimer.pause();
-      SDL_Log("[INFO] Paused");
+      RIPSAW_LOG_INFO(Core, "Paused");
     }
     else
     {
       mTimer.resume();
-      SDL_Log("[INFO] Resumed");
+      RIPSAW_LOG_INFO(Core, "Resumed");
     }
   }
 }
@@ -205,57 +368,296 @@ void Engine::setRendererBackend(const std::string& backend)
   }
 }
 
+void Engine::setHeadless(bool headless)
+{
+  mIsHeadless = headless;
+}
+
+Camera& Engine::getCamera(std::size_t index)
+{
+  if (index >= mCameras.size())
+  {
+    RIPSAW_LOG_ERROR(Render, "Camera index out of range: %zu", index);
+    return mCameras.front();
+  }
+  return mCameras[index];
+}
+
+std::size_t Engine::addCamera(const SDL_FRect& viewport)
+{
+  Camera& camera{mCameras.emplace_back(viewport)};
+  camera.setScreenSize({static_cast<float>(mScreenWidth), static_cast<float>(mScreenHeight)});
+  camera.setPosition(mCameras.front().getPosition());
+  return mCameras.size() - 1;
+}
+
+void Engine::removeCamera(std::size_t index)
+{
+  if (index == 0 or index >= mCameras.size())
+  {
+    RIPSAW_LOG_ERROR(Render, "Cannot remove camera: %zu", index);
+    return;
+  }
+  mCameras.erase(mCameras.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+std::size_t Engine::getCameraCount() const
+{
+  return mCameras.size();
+}
+
+void Engine::setViewportCulling(bool culling)
+{
+  mIsViewportCulling = culling;
+}
+
+void Engine::setFixedTimestep(bool enabled, double tickRate, int maxSubsteps)
+{
+  if (tickRate <= 0 or maxSubsteps < 1)
+  {
+    RIPSAW_LOG_ERROR(Core, "Invalid fixed timestep: %.2f Hz, %d substeps", tickRate, maxSubsteps);
+    return;
+  }
+
+  mIsFixedTimestep = enabled;
+  mFixedDt = 1.0 / tickRate;
+  mMaxSubsteps = maxSubsteps;
+  mAccumulator = 0;
+  mInterpolationAlpha = 1;
+  mTransformSystem.setInterpolation(1.f);
+}
+
+bool Engine::isFixedTimestep() const
+{
+  return mIsFixedTimestep;
+}
+
+void Engine::setParallelUpdate(bool parallel)
+{
+  mIsParallelUpdate = parallel;
+}
+
+bool Engine::isParallelUpdate() const
+{
+  return mIsParallelUpdate;
+}
+
+void Engine::setPipelined(bool pipelined)
+{
+  mIsPipelined = pipelined;
+}
+
+bool Engine::isPipelined() const
+{
+  return mIsPipelined;
+}
+
+double Engine::getInterpolationAlpha() const
+{
+  return mInterpolationAlpha;
+}
+
+ArchetypeStore& Engine::getArchetypes()
+{
+  return mArchetypes;
+}
+
+TransformSystem& Engine::getTransformSystem()
+{
+  return mTransformSystem;
+}
+
+AnimationSystem& Engine::getAnimationSystem()
+{
+  return mAnimationSystem;
+}
+
+ParticleSystem& Engine::getParticleSystem()
+{
+  return mParticleSystem;
+}
+
+TilemapSystem& Engine::getTilemapSystem()
+{
+  return mTilemapSystem;
+}
+
+SystemScheduler& Engine::getSystemScheduler()
+{
+  return mSystemScheduler;
+}
+
+CommandBuffer& Engine::getCommandBuffer()
+{
+  std::size_t index{mJobSystem.getThreadIndex()};
+  return mCommandBuffers[index < mCommandBuffers.size() ? index : 0];
+}
+
+SpatialHash& Engine::getSpatialHash()
+{
+  return mSpatialHash;
+}
+
+const RenderStats& Engine::getRenderStats() const
+{
+  return mRenderStats;
+}
+
+TextureCache& Engine::getTextureCache()
+{
+  return mTextureCache;
+}
+
+AssetLoader& Engine::getAssetLoader()
+{
+  return mAssetLoader;
+}
+
+JobSystem& Engine::getJobSystem()
+{
+  return mJobSystem;
+}
+
+FrameArena& Engine::getFrameArena()
+{
+  return mFrameArena;
+}
+
+PoolUsage Engine::getPoolUsage() const
+{
+  return
+  {
+    Actor::getPoolStats(),
+    TransformComponent::getPoolStats(),
+    SpriteComponent::getPoolStats(),
+    SpritesheetComponent::getPoolStats()
+  };
+}
+
 Actor* Engine::createActor()
 {
+  if (mIsUpdatingInParallel)
+  {
+    RIPSAW_LOG_ERROR(Scene, "Actors can't be created while updating in parallel or pipelined; use CommandBuffer::createActor()");
+    return nullptr;
+  }
+  // Actor::operator new takes the storage from the actor pool.
   Actor* tempActor{new Actor{this}};
   return tempActor;
 }
 
-void Engine::destroyActor(Actor** actor)
+void Engine::destroyActor(ActorHandle handle)
 {
-  if (mActorsBeingUpdated == false)
+  if (mIsUpdatingInParallel)
   {
-    this->removeActor(*actor);
-    *actor = nullptr;
-  }
-  else
-  {
-    mActorsToBeKilled.push_back(actor);
+    this->getCommandBuffer().destroyActor(handle);
+    return;
   }
+  // Stale and repeated handles are filtered out when the queue is flushed.
+  if (mActorHandles.isValid(handle))
+    mActorsToBeDestroyed.push_back(handle);
+}
+
+void Engine::destroyActor(Actor** actor)
+{
+  if (*actor == nullptr)
+    return;
+
+  this->destroyActor((*actor)->getHandle());
+  *actor = nullptr;
+}
+
+Actor* Engine::getActor(ActorHandle handle) const
+{
+  if (mActorHandles.isValid(handle) == false)
+    return nullptr;
+  return mActors[mActorHandles.indexOf(handle)];
+}
+
+bool Engine::isActorValid(ActorHandle handle) const
+{
+  return mActorHandles.isValid(handle);
+}
+
+std::size_t Engine::getActorCount() const
+{
+  return mActors.size();
 }
 
 void Engine::addActor(Actor* actor)
 {
+  actor->setHandle(mActorHandles.allocate());
   mActors.emplace_back(actor);
+  mArchetypes.add(actor);
   mTotalActorsSize += sizeof(*actor);
-  SDL_Log("[INFO] Cumulative actor size: %zu bytes", mTotalActorsSize);
+  RIPSAW_LOG_DEBUG(Scene, "Cumulative actor size: %zu bytes", mTotalActorsSize);
 }
 
 void Engine::removeActor(Actor* actor)
 {
-  auto it{std::find(mActors.begin(), mActors.end(), actor)};
-  if (it != mActors.end())
+  if (actor == nullptr or mActorHandles.isValid(actor->getHandle()) == false)
+    return;
+
+  HandleTable::Removal removal{mActorHandles.release(actor->getHandle())};
+  mActors[removal.index] = mActors[removal.last];
+  mActors.pop_back();
+  mArchetypes.remove(actor);
+  delete actor;
+}
+
+void Engine::flushDestroyedActors()
+{
+  // Destroying an actor may queue more (e.g. from component destructors), so index instead of iterating.
+  for (std::size_t i{}; i < mActorsToBeDestroyed.size(); ++i)
+  {
+    this->removeActor(this->getActor(mActorsToBeDestroyed[i]));
+  }
+  mActorsToBeDestroyed.clear();
+}
+
+void Engine::applyCommands()
+{
+  for (auto& buffer : mCommandBuffers)
   {
-    delete *it;
-    mActors.erase(it);
+    buffer.apply(*this);
   }
-  actor = nullptr;
 }
 
 void Engine::addSprite(class SpriteComponent* sc)
 {
+  sc->setSpriteIndex(mSprites.size());
   mSprites.emplace_back(sc);
-  SDL_Log("[INFO] Total active sprites++: %zu", mSprites.size());
+  ++mSpriteCount;
+  RIPSAW_LOG_DEBUG(Render, "Total active sprites++: %zu", mSpriteCount);
 }
 
 void Engine::removeSprite(SpriteComponent* sprite)
 {
-  auto it{std::find(mSprites.begin(), mSprites.end(), sprite)};
-  if (it != mSprites.end())
+  std::size_t index{sprite->getSpriteIndex()};
+  if (index < mSprites.size() and mSprites[index] == sprite)
   {
-    mSprites.erase(it);
+    mSprites[index] = nullptr;
+    mHasSpriteHoles = true;
+    --mSpriteCount;
   }
-  SDL_Log("[INFO] Total active sprites--: %zu", mSprites.size());
+  RIPSAW_LOG_DEBUG(Render, "Total active sprites--: %zu", mSpriteCount);
+}
+
+void Engine::compactSprites()
+{
+  if (mHasSpriteHoles == false)
+    return;
+
+  std::size_t kept{};
+  for (auto* sprite : mSprites)
+  {
+    if (sprite == nullptr)
+      continue;
+    sprite->setSpriteIndex(kept);
+    mSprites[kept++] = sprite;
+  }
+  mSprites.resize(kept);
+  mHasSpriteHoles = false;
 }
 
 void Engine::insertActorSpritePair(const std::pair<Actor*, Component*>& asp)
@@ -282,23 +684,28 @@ BGManager* Engine::createBGManager(const std::vector<std::string>& layers, const
 
 void Engine::actorGoesBelow(Actor* a1, Actor* a2)
 {
-  auto it1{std::find(mSprites.begin(), mSprites.end(), mActorSpritePairs[a1])};
-  auto it2{std::find(mSprites.begin(), mSprites.end(), mActorSpritePairs[a2])};
+  auto* s1{a1->getSpriteComponent()};
+  auto* s2{a2->getSpriteComponent()};
+  if (s1 == nullptr or s2 == nullptr)
+    return;
 
-  if (it1 < it2)
+  if (s1->getSortKey() < s2->getSortKey())
     return;
-  std::rotate(it2, it1, it1 + 1);
+  s1->setLayer(s2->getLayer());
+  s1->setDepth(std::nextafter(s2->getDepth(), -std::numeric_limits<float>::infinity()));
 }
 
 void Engine::actorGoesAbove(Actor* a1, Actor* a2)
 {
-  auto it1{std::find(mSprites.begin(), mSprites.end(), mActorSpritePairs[a1])};
-  auto it2{std::find(mSprites.begin(), mSprites.end(), mActorSpritePairs[a2])};
+  auto* s1{a1->getSpriteComponent()};
+  auto* s2{a2->getSpriteComponent()};
+  if (s1 == nullptr or s2 == nullptr)
+    return;
 
-  if (it1 > it2)
+  if (s1->getSortKey() > s2->getSortKey())
     return;
-  std::rotate(it1, it1 + 1, it2 + 1);
+  s1->setLayer(s2->getLayer());
+  s1->setDepth(std::nextafter(s2->getDepth(), std::numeric_limits<float>::infinity()));
 }
 
 }
-
@@ -0,0 +1,60 @@
+#include "RipsawEngine/2D/Core/FrameArena.hxx"
+
+#include <cstdint>
+
+namespace RipsawEngine
+{
+
+FrameArena::FrameArena(std::size_t capacity)
+  : mBlock{std::make_unique_for_overwrite<std::byte[]>(capacity)}
+{
+  mStats.capacity = capacity;
+}
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+  std::uintptr_t base{reinterpret_cast<std::uintptr_t>(mBlock.get())};
+  std::uintptr_t aligned{(base + mOffset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1)};
+  std::size_t offset{static_cast<std::size_t>(aligned - base)};
+
+  if (offset + size <= mStats.capacity)
+  {
+    mOffset = offset + size;
+    mStats.used += size;
+    return mBlock.get() + offset;
+  }
+
+  // Over-allocate so the block can be aligned by hand; operator new[] only guarantees max_align_t.
+  mOverflow.emplace_back(std::make_unique_for_overwrite<std::byte[]>(size + alignment));
+  std::uintptr_t overflow{reinterpret_cast<std::uintptr_t>(mOverflow.back().get())};
+  std::uintptr_t overflowAligned{(overflow + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1)};
+  mStats.used += size;
+  ++mStats.overflows;
+  return mOverflow.back().get() + (overflowAligned - overflow);
+}
+
+void FrameArena::reset()
+{
+  if (mStats.used > mStats.peak)
+    mStats.peak = mStats.used;
+
+  if (mOverflow.empty() == false)
+  {
+    // Alignment padding isn't counted in used, so leave some headroom.
+    std::size_t capacity{mStats.peak + mStats.peak / 4};
+    mBlock = std::make_unique_for_overwrite<std::byte[]>(capacity);
+    mStats.capacity = capacity;
+    mOverflow.clear();
+  }
+
+  mOffset = 0;
+  mStats.used = 0;
+  mStats.overflows = 0;
+}
+
+const FrameArenaStats& FrameArena::getStats() const
+{
+  return mStats;
+}
+
+}
@@ -0,0 +1,90 @@
+#include "RipsawEngine/2D/Core/HandleTable.hxx"
+
+namespace RipsawEngine
+{
+
+bool Handle::isNull() const
+{
+  return index == InvalidIndex;
+}
+
+Handle HandleTable::allocate()
+{
+  std::uint32_t slot{};
+  if (mFreeHead != Handle::InvalidIndex)
+  {
+    slot = mFreeHead;
+    mFreeHead = mSlots[slot].dense;
+  }
+  else
+  {
+    slot = static_cast<std::uint32_t>(mSlots.size());
+    mSlots.emplace_back();
+  }
+
+  mSlots[slot].dense = static_cast<std::uint32_t>(mDenseToSlot.size());
+  mDenseToSlot.push_back(slot);
+  return {slot, mSlots[slot].generation};
+}
+
+HandleTable::Removal HandleTable::release(Handle handle)
+{
+  Slot& slot{mSlots[handle.index]};
+  Removal removal{slot.dense, mDenseToSlot.size() - 1};
+
+  if (removal.index != removal.last)
+  {
+    std::uint32_t movedSlot{mDenseToSlot[removal.last]};
+    mDenseToSlot[removal.index] = movedSlot;
+    mSlots[movedSlot].dense = static_cast<std::uint32_t>(removal.index);
+  }
+  mDenseToSlot.pop_back();
+
+  ++slot.generation;
+  slot.dense = mFreeHead;
+  mFreeHead = handle.index;
+  return removal;
+}
+
+bool HandleTable::isValid(Handle handle) const
+{
+  if (handle.index >= mSlots.size())
+    return false;
+  const Slot& slot{mSlots[handle.index]};
+  return slot.generation == handle.generation and slot.dense < mDenseToSlot.size() and mDenseToSlot[slot.dense] == handle.index;
+}
+
+std::size_t HandleTable::indexOf(Handle handle) const
+{
+  return mSlots[handle.index].dense;
+}
+
+Handle HandleTable::handleAt(std::size_t index) const
+{
+  std::uint32_t slot{mDenseToSlot[index]};
+  return {slot, mSlots[slot].generation};
+}
+
+std::size_t HandleTable::size() const
+{
+  return mDenseToSlot.size();
+}
+
+void HandleTable::reserve(std::size_t capacity)
+{
+  mSlots.reserve(capacity);
+  mDenseToSlot.reserve(capacity);
+}
+
+void HandleTable::clear()
+{
+  for (std::uint32_t slot : mDenseToSlot)
+  {
+    ++mSlots[slot].generation;
+    mSlots[slot].dense = mFreeHead;
+    mFreeHead = slot;
+  }
+  mDenseToSlot.clear();
+}
+
+}
@@ -0,0 +1,262 @@
+#include "RipsawEngine/2D/Core/JobSystem.hxx"
+#include "RipsawEngine/2D/Core/Profiler.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace RipsawEngine
+{
+
+namespace
+{
+
+/// Job system the calling thread belongs to.
+thread_local const JobSystem* tJobSystem{nullptr};
+/// Queue index of the calling thread in tJobSystem.
+thread_local std::size_t tQueueIndex{};
+
+}
+
+bool JobCounter::isDone() const
+{
+  return pending.load(std::memory_order_acquire) == 0;
+}
+
+JobSystem::~JobSystem()
+{
+  this->stop();
+}
+
+void JobSystem::start(std::size_t workers, std::size_t outside)
+{
+  if (!mQueues.empty())
+    return;
+
+  if (workers == 0)
+  {
+    std::size_t cores{std::thread::hardware_concurrency()};
+    workers = cores > 1 ? cores - 1 : 0;
+  }
+
+  mIsStopping = false;
+  mWorkerCount = workers;
+  mNextOutside.store(workers + 1, std::memory_order_relaxed);
+  // Every queue exists before any thread starts, since runOne() walks them without locking the vector.
+  for (std::size_t i{}; i <= workers + outside; ++i)
+  {
+    mQueues.push_back(std::make_unique<WorkerQueue>());
+  }
+  tJobSystem = this;
+  tQueueIndex = 0;
+  for (std::size_t i{1}; i <= workers; ++i)
+  {
+    mWorkers.emplace_back(&JobSystem::workerLoop, this, i);
+  }
+  RIPSAW_LOG_INFO(Core, "Job system started with %zu worker threads", workers);
+}
+
+bool JobSystem::attach()
+{
+  if (tJobSystem == this)
+    return true;
+
+  std::size_t index{mNextOutside.fetch_add(1, std::memory_order_relaxed)};
+  if (index >= mQueues.size())
+  {
+    RIPSAW_LOG_ERROR(Core, "Job system has no free slot for another thread");
+    return false;
+  }
+  tJobSystem = this;
+  tQueueIndex = index;
+  return true;
+}
+
+void JobSystem::stop()
+{
+  if (mQueues.empty())
+    return;
+
+  // Jobs still queued are finished first; someone may be about to wait for them.
+  while (this->runOne())
+  {}
+
+  {
+    std::scoped_lock lock{mSleepMutex};
+    mIsStopping = true;
+  }
+  mSleepCondition.notify_all();
+  for (auto& worker : mWorkers)
+  {
+    worker.join();
+  }
+  mWorkers.clear();
+  mWorkerCount = 0;
+  mQueues.clear();
+  if (tJobSystem == this)
+    tJobSystem = nullptr;
+}
+
+std::size_t JobSystem::getThreadCount() const
+{
+  return std::max<std::size_t>(mQueues.size(), 1);
+}
+
+std::size_t JobSystem::getThreadIndex() const
+{
+  return tJobSystem == this ? tQueueIndex : 0;
+}
+
+void JobSystem::run(std::function<void()> job, JobCounter& counter)
+{
+  counter.pending.fetch_add(1, std::memory_order_relaxed);
+  if (mQueues.empty())
+  {
+    job();
+    counter.pending.fetch_sub(1, std::memory_order_release);
+    return;
+  }
+
+  // Counted before it becomes visible, so a thief never takes a job that isn't counted yet.
+  mQueued.fetch_add(1, std::memory_order_release);
+  {
+    WorkerQueue& queue{*mQueues[this->getThreadIndex()]};
+    std::scoped_lock lock{queue.mutex};
+    queue.jobs.push_back({std::move(job), nullptr, nullptr, 0, 0, &counter});
+  }
+  this->notify(1);
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+  while (counter.isDone() == false)
+  {
+    if (this->runOne() == false)
+      std::this_thread::yield();
+  }
+}
+
+void JobSystem::dispatchRange(std::size_t count, std::size_t grain, RangeFunction invoke, const void* context)
+{
+  if (count == 0)
+    return;
+
+  std::size_t threads{this->getThreadCount()};
+  if (grain == 0)
+  {
+    // A few chunks per thread leave room for stealing to even out uneven chunks.
+    grain = std::max<std::size_t>(count / (threads * 4), 1);
+  }
+  if (mQueues.empty() or count <= grain)
+  {
+    invoke(context, 0, count);
+    return;
+  }
+
+  std::size_t chunks{(count + grain - 1) / grain};
+  JobCounter counter{};
+  counter.pending.store(chunks, std::memory_order_relaxed);
+  mQueued.fetch_add(chunks, std::memory_order_release);
+  {
+    WorkerQueue& queue{*mQueues[this->getThreadIndex()]};
+    std::scoped_lock lock{queue.mutex};
+    for (std::size_t begin{}; begin < count; begin += grain)
+    {
+      queue.jobs.push_back({{}, invoke, context, begin, std::min(begin + grain, count), &counter});
+    }
+  }
+  this->notify(chunks);
+  this->wait(counter);
+}
+
+bool JobSystem::runOne()
+{
+  if (mQueued.load(std::memory_order_acquire) == 0 or mQueues.empty())
+    return false;
+
+  std::size_t own{this->getThreadIndex()};
+  Job job{};
+  bool isFound{false};
+  {
+    // Own jobs are taken from the back: the most recent ones are the most likely to still be in cache.
+    WorkerQueue& queue{*mQueues[own]};
+    std::scoped_lock lock{queue.mutex};
+    if (!queue.jobs.empty())
+    {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+      isFound = true;
+    }
+  }
+  for (std::size_t i{1}; i < mQueues.size() and isFound == false; ++i)
+  {
+    std::size_t index{(own + i) % mQueues.size()};
+    if (this->isWorker(own) == false and this->isWorker(index) == false)
+      continue;
+    // Steal the oldest job of the next thread that has one, so thieves take the biggest leftover pieces.
+    WorkerQueue& victim{*mQueues[index]};
+    std::scoped_lock lock{victim.mutex};
+    if (!victim.jobs.empty())
+    {
+      job = std::move(victim.jobs.front());
+      victim.jobs.pop_front();
+      isFound = true;
+    }
+  }
+  if (isFound == false)
+    return false;
+
+  mQueued.fetch_sub(1, std::memory_order_relaxed);
+  this->execute(job);
+  return true;
+}
+
+void JobSystem::execute(Job& job)
+{
+  if (job.range != nullptr)
+    job.range(job.context, job.begin, job.end);
+  else
+    job.task();
+  job.counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::notify(std::size_t jobs)
+{
+  {
+    // Taking the lock orders the queued count before any worker's check, so no wakeup is lost.
+    std::scoped_lock lock{mSleepMutex};
+  }
+  if (jobs == 1)
+    mSleepCondition.notify_one();
+  else
+    mSleepCondition.notify_all();
+}
+
+bool JobSystem::isWorker(std::size_t index) const
+{
+  return index >= 1 and index <= mWorkerCount;
+}
+
+void JobSystem::workerLoop(std::size_t index)
+{
+  RIPSAW_PROFILE_THREAD("Job worker " + std::to_string(index));
+  tJobSystem = this;
+  tQueueIndex = index;
+  while (true)
+  {
+    if (this->runOne())
+      continue;
+
+    std::unique_lock lock{mSleepMutex};
+    mSleepCondition.wait(lock, [this]() {
+        return mIsStopping or mQueued.load(std::memory_order_acquire) > 0;
+    });
+    if (mIsStopping)
+      return;
+  }
+}
+
+}
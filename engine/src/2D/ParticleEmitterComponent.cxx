@@ -0,0 +1,67 @@
+#include "RipsawEngine/2D/Core/Engine.hxx"
+#include "RipsawEngine/2D/Scene/Actor.hxx"
+#include "RipsawEngine/2D/Scene/ParticleEmitterComponent.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+namespace RipsawEngine
+{
+
+ParticleEmitterComponent::ParticleEmitterComponent(Actor* actor, const ParticleEmitterConfig& config)
+  : Component{actor},
+    mParticleSystem{&actor->getEngine()->getParticleSystem()},
+    mImgFile{config.imgfile}
+{
+  mOwner->registerComponent(TypeId, this);
+
+  TextureRegion region{};
+  if (mImgFile.empty() == false)
+  {
+    region = mOwner->getEngine()->getTextureCache().acquire(mImgFile);
+    mIsTextureAcquired = region.texture != nullptr;
+    if (mIsTextureAcquired == false)
+      RIPSAW_LOG_WARN(Scene, "Particle texture %s couldn't be loaded, particles are drawn as squares", mImgFile.c_str());
+  }
+  mEmitter = mParticleSystem->create(config, region, mOwner);
+
+  RIPSAW_LOG_DEBUG(Scene, "Component added: ParticleEmitterComponent: %p to Actor: %p, capacity: %zu particles", static_cast<void*>(this), static_cast<void*>(mOwner), config.maxParticles);
+}
+
+ParticleEmitterComponent::~ParticleEmitterComponent()
+{
+  mOwner->deregisterComponent(TypeId);
+  mParticleSystem->destroy(mEmitter);
+  if (mIsTextureAcquired)
+    mOwner->getEngine()->getTextureCache().release(mImgFile);
+}
+
+bool ParticleEmitterComponent::isComponentValid() const
+{
+  return mParticleSystem->isValid(mEmitter);
+}
+
+void ParticleEmitterComponent::burst(std::size_t count)
+{
+  mParticleSystem->burst(mEmitter, count);
+}
+
+void ParticleEmitterComponent::setEmitting(bool emitting)
+{
+  mParticleSystem->setEmitting(mEmitter, emitting);
+}
+
+bool ParticleEmitterComponent::isEmitting() const
+{
+  return mParticleSystem->isEmitting(mEmitter);
+}
+
+void ParticleEmitterComponent::setRate(float rate)
+{
+  mParticleSystem->setRate(mEmitter, rate);
+}
+
+std::size_t ParticleEmitterComponent::getParticleCount() const
+{
+  return mParticleSystem->getParticleCount(mEmitter);
+}
+
+}
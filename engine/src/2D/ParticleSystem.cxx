@@ -0,0 +1,249 @@
+#include "RipsawEngine/2D/Core/Simd.hxx"
+#include "RipsawEngine/2D/Render/RenderQueue.hxx"
+#include "RipsawEngine/2D/Scene/Actor.hxx"
+#include "RipsawEngine/2D/Scene/TransformComponent.hxx"
+#include "RipsawEngine/2D/Systems/ParticleSystem.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace RipsawEngine
+{
+
+namespace
+{
+
+/// Shortest lifetime of a particle in seconds, so lifetime can be divided by.
+constexpr float MinLifetime{1e-3f};
+
+/// Returns next pseudo-random number in [0, 1) of an xorshift generator.
+/// @param state Generator state, never 0.
+float random(std::uint32_t& state)
+{
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  // Top 24 bits fill the mantissa exactly.
+  return static_cast<float>(state >> 8) * (1.f / 16777216.f);
+}
+
+/// Returns value between range.x and range.y at t.
+/// @param range Range.
+/// @param t Interpolation factor in [0, 1].
+float lerp(const glm::vec2& range, float t)
+{
+  return range.x + (range.y - range.x) * t;
+}
+
+}
+
+Handle ParticleSystem::create(const ParticleEmitterConfig& config, const TextureRegion& region, const Actor* actor)
+{
+  Handle handle{mTable.allocate()};
+  Emitter emitter{};
+  emitter.config = config;
+  emitter.config.rate = std::max(config.rate, 0.f);
+  emitter.config.lifetime = glm::max(config.lifetime, glm::vec2{MinLifetime});
+  emitter.actor = actor;
+  emitter.texture = region.texture;
+  emitter.src = region.rect;
+  emitter.key = makeSortKey(config.layer, config.depth);
+  for (auto* pool : {&emitter.posX, &emitter.posY, &emitter.velX, &emitter.velY, &emitter.age, &emitter.lifetime, &emitter.size})
+  {
+    pool->resize(config.maxParticles);
+  }
+  // Golden-ratio steps keep seeds of consecutive emitters apart, and never reach 0.
+  emitter.seed = mNextSeed;
+  mNextSeed += 0x9E3779B9u;
+  if (mNextSeed == 0)
+    mNextSeed = 0x9E3779B9u;
+  mEmitters.push_back(std::move(emitter));
+  return handle;
+}
+
+void ParticleSystem::destroy(Handle handle)
+{
+  if (mTable.isValid(handle) == false)
+    return;
+
+  HandleTable::Removal removal{mTable.release(handle)};
+  if (removal.index != removal.last)
+    mEmitters[removal.index] = std::move(mEmitters[removal.last]);
+  mEmitters.pop_back();
+}
+
+bool ParticleSystem::isValid(Handle handle) const
+{
+  return mTable.isValid(handle);
+}
+
+void ParticleSystem::burst(Handle handle, std::size_t count)
+{
+  mEmitters[mTable.indexOf(handle)].burst += count;
+}
+
+void ParticleSystem::setEmitting(Handle handle, bool emitting)
+{
+  Emitter& emitter{mEmitters[mTable.indexOf(handle)]};
+  emitter.isEmitting = emitting;
+  emitter.pending = 0.f;
+}
+
+bool ParticleSystem::isEmitting(Handle handle) const
+{
+  return mEmitters[mTable.indexOf(handle)].isEmitting;
+}
+
+void ParticleSystem::setRate(Handle handle, float rate)
+{
+  mEmitters[mTable.indexOf(handle)].config.rate = std::max(rate, 0.f);
+}
+
+std::size_t ParticleSystem::getParticleCount(Handle handle) const
+{
+  return mEmitters[mTable.indexOf(handle)].count;
+}
+
+std::size_t ParticleSystem::getParticleCount() const
+{
+  std::size_t total{};
+  for (const auto& emitter : mEmitters)
+  {
+    total += emitter.count;
+  }
+  return total;
+}
+
+void ParticleSystem::update(double dt, JobSystem& jobs)
+{
+  float step{static_cast<float>(dt)};
+  jobs.parallelFor(mEmitters.size(), [this, step](std::size_t begin, std::size_t end) {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        ParticleSystem::step(mEmitters[i], step);
+      }
+  }, 1);
+}
+
+void ParticleSystem::extract(RenderPacket& packet, JobSystem& jobs) const
+{
+  // One batch per emitter in emitter order, so emitter i fills batch first + i; empty ones are dropped afterwards.
+  std::size_t firstBatch{packet.particleBatches.size()};
+  std::size_t total{packet.particles.size()};
+  for (const auto& emitter : mEmitters)
+  {
+    packet.particleBatches.push_back({emitter.texture, emitter.actor->getHandle(), emitter.src, {}, emitter.key, total, emitter.count});
+    total += emitter.count;
+  }
+  packet.particles.resize(total);
+
+  jobs.parallelFor(mEmitters.size(), [this, &packet, firstBatch](std::size_t begin, std::size_t end) {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        const Emitter& emitter{mEmitters[i]};
+        ParticleBatch& batch{packet.particleBatches[firstBatch + i]};
+        PacketParticle* out{packet.particles.data() + batch.first};
+        const ParticleEmitterConfig& config{emitter.config};
+        glm::vec2 lo{INFINITY, INFINITY};
+        glm::vec2 hi{-INFINITY, -INFINITY};
+        for (std::size_t p{}; p < emitter.count; ++p)
+        {
+          float t{std::min(emitter.age[p] / emitter.lifetime[p], 1.f)};
+          float size{emitter.size[p] * (1.f + (config.endScale - 1.f) * t)};
+          out[p] =
+          {
+            emitter.posX[p],
+            emitter.posY[p],
+            size,
+            {
+              config.startColor.r + (config.endColor.r - config.startColor.r) * t,
+              config.startColor.g + (config.endColor.g - config.startColor.g) * t,
+              config.startColor.b + (config.endColor.b - config.startColor.b) * t,
+              config.startColor.a + (config.endColor.a - config.startColor.a) * t
+            }
+          };
+          float half{size / 2.f};
+          lo = glm::min(lo, glm::vec2{emitter.posX[p] - half, emitter.posY[p] - half});
+          hi = glm::max(hi, glm::vec2{emitter.posX[p] + half, emitter.posY[p] + half});
+        }
+        batch.bounds = {lo, hi};
+      }
+  }, 1);
+
+  std::erase_if(packet.particleBatches, [](const ParticleBatch& batch) {
+      return batch.count == 0;
+  });
+  // Ties go by position in the packet, i.e. emitter order, so drawing order is stable.
+  std::sort(packet.particleBatches.begin(), packet.particleBatches.end(), [](const ParticleBatch& a, const ParticleBatch& b) {
+      return a.key != b.key ? a.key < b.key : a.first < b.first;
+  });
+}
+
+std::size_t ParticleSystem::size() const
+{
+  return mEmitters.size();
+}
+
+void ParticleSystem::step(Emitter& emitter, float dt)
+{
+  Simd::add(emitter.age.data(), dt, emitter.count);
+  // Dead particles are replaced by the last live one, so live particles stay packed.
+  for (std::size_t i{}; i < emitter.count;)
+  {
+    if (emitter.age[i] < emitter.lifetime[i])
+    {
+      ++i;
+      continue;
+    }
+    std::size_t last{--emitter.count};
+    for (auto* pool : {&emitter.posX, &emitter.posY, &emitter.velX, &emitter.velY, &emitter.age, &emitter.lifetime, &emitter.size})
+    {
+      (*pool)[i] = (*pool)[last];
+    }
+  }
+
+  const ParticleEmitterConfig& config{emitter.config};
+  if (config.gravity.x != 0.f)
+    Simd::add(emitter.velX.data(), config.gravity.x * dt, emitter.count);
+  if (config.gravity.y != 0.f)
+    Simd::add(emitter.velY.data(), config.gravity.y * dt, emitter.count);
+  Simd::mulAdd(emitter.posX.data(), emitter.velX.data(), dt, emitter.count);
+  Simd::mulAdd(emitter.posY.data(), emitter.velY.data(), dt, emitter.count);
+
+  std::size_t wanted{emitter.burst};
+  emitter.burst = 0;
+  if (emitter.isEmitting)
+  {
+    emitter.pending += config.rate * dt;
+    float whole{std::floor(emitter.pending)};
+    emitter.pending -= whole;
+    wanted += static_cast<std::size_t>(whole);
+  }
+  emit(emitter, std::min(wanted, config.maxParticles - emitter.count));
+}
+
+void ParticleSystem::emit(Emitter& emitter, std::size_t count)
+{
+  const ParticleEmitterConfig& config{emitter.config};
+  glm::vec2 origin{config.offset};
+  if (const TransformComponent* transform{emitter.actor->getTransformComponent()}; transform != nullptr)
+    origin += transform->getPosition();
+
+  constexpr float DegToRad{std::numbers::pi_v<float> / 180.f};
+  for (std::size_t n{}; n < count; ++n)
+  {
+    std::size_t i{emitter.count++};
+    float angle{(config.direction + (random(emitter.seed) - 0.5f) * config.spread) * DegToRad};
+    float speed{lerp(config.speed, random(emitter.seed))};
+    emitter.posX[i] = origin.x;
+    emitter.posY[i] = origin.y;
+    emitter.velX[i] = std::cos(angle) * speed;
+    emitter.velY[i] = std::sin(angle) * speed;
+    emitter.age[i] = 0.f;
+    emitter.lifetime[i] = lerp(config.lifetime, random(emitter.seed));
+    emitter.size[i] = lerp(config.size, random(emitter.seed));
+  }
+}
+
+}
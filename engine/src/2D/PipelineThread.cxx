@@ -0,0 +1,82 @@
+#include "RipsawEngine/2D/Core/PipelineThread.hxx"
+#include "RipsawEngine/2D/Core/Profiler.hxx"
+
+#include <utility>
+
+namespace RipsawEngine
+{
+
+PipelineThread::~PipelineThread()
+{
+  this->stop();
+}
+
+void PipelineThread::start(const std::string& name, std::function<void()> task)
+{
+  if (mThread.joinable())
+    return;
+
+  mTask = std::move(task);
+  mIsKicked = false;
+  mIsStopping = false;
+  mThread = std::thread{&PipelineThread::loop, this, name};
+}
+
+void PipelineThread::stop()
+{
+  if (mThread.joinable() == false)
+    return;
+
+  this->wait();
+  {
+    std::scoped_lock lock{mMutex};
+    mIsStopping = true;
+  }
+  mCondition.notify_all();
+  mThread.join();
+}
+
+bool PipelineThread::isRunning() const
+{
+  return mThread.joinable();
+}
+
+void PipelineThread::kick()
+{
+  {
+    std::scoped_lock lock{mMutex};
+    mIsKicked = true;
+  }
+  mCondition.notify_all();
+}
+
+void PipelineThread::wait()
+{
+  std::unique_lock lock{mMutex};
+  mCondition.wait(lock, [this]() {
+      return mIsKicked == false;
+  });
+}
+
+void PipelineThread::loop([[maybe_unused]] std::string name)
+{
+  RIPSAW_PROFILE_THREAD(name);
+  std::unique_lock lock{mMutex};
+  while (true)
+  {
+    mCondition.wait(lock, [this]() {
+        return mIsStopping or mIsKicked;
+    });
+    if (mIsStopping)
+      return;
+
+    lock.unlock();
+    mTask();
+    lock.lock();
+    // The flag stays set for the whole run, so wait() can't return early.
+    mIsKicked = false;
+    mCondition.notify_all();
+  }
+}
+
+}
@@ -0,0 +1,216 @@
+#include "RipsawEngine/2D/Core/Profiler.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#if defined(RIPSAW_ENGINE_PROFILER)
+
+#include <algorithm>
+#include <utility>
+
+namespace RipsawEngine
+{
+
+namespace
+{
+
+/// Ring of the calling thread, registered on first use.
+thread_local void* tThreadRing{nullptr};
+
+/// Returns percentile p of sorted frame times in milliseconds.
+double percentile(const std::vector<Uint64>& sorted, double p)
+{
+  std::size_t index{static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1))};
+  return static_cast<double>(sorted[index]) / 1e6;
+}
+
+}
+
+void ProfileRing::push(const ProfileEvent& event)
+{
+  std::size_t head{mHead.load(std::memory_order_relaxed)};
+  if (head - mTail.load(std::memory_order_acquire) >= Capacity)
+  {
+    mDropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  mEvents[head % Capacity] = event;
+  mHead.store(head + 1, std::memory_order_release);
+}
+
+void ProfileRing::drain(std::vector<ProfileEvent>* out)
+{
+  std::size_t tail{mTail.load(std::memory_order_relaxed)};
+  std::size_t head{mHead.load(std::memory_order_acquire)};
+  if (out != nullptr)
+  {
+    for (std::size_t i{tail}; i < head; ++i)
+    {
+      out->push_back(mEvents[i % Capacity]);
+    }
+  }
+  mTail.store(head, std::memory_order_release);
+}
+
+std::size_t ProfileRing::getDropped() const
+{
+  return mDropped.load(std::memory_order_relaxed);
+}
+
+Profiler& Profiler::get()
+{
+  static Profiler profiler{};
+  return profiler;
+}
+
+Profiler::ThreadRing& Profiler::threadRing()
+{
+  if (tThreadRing == nullptr)
+  {
+    std::scoped_lock lock{mRingsMutex};
+    auto ring{std::make_unique<ThreadRing>()};
+    ring->id = static_cast<std::uint32_t>(mRings.size());
+    ring->name = "Thread " + std::to_string(ring->id);
+    tThreadRing = ring.get();
+    mRings.push_back(std::move(ring));
+  }
+  return *static_cast<ThreadRing*>(tThreadRing);
+}
+
+void Profiler::record(const char* name, Uint64 start, Uint64 end)
+{
+  this->threadRing().ring.push({name, start, end});
+}
+
+void Profiler::setThreadName(const std::string& name)
+{
+  ThreadRing& ring{this->threadRing()};
+  std::scoped_lock lock{mRingsMutex};
+  ring.name = name;
+}
+
+void Profiler::endFrame()
+{
+  Uint64 now{SDL_GetTicksNS()};
+  if (mLastFrameEnd != 0)
+  {
+    if (mFrameTimes.size() < FrameWindow)
+      mFrameTimes.push_back(now - mLastFrameEnd);
+    else
+    {
+      mFrameTimes[mFrameCursor] = now - mLastFrameEnd;
+      mFrameCursor = (mFrameCursor + 1) % FrameWindow;
+    }
+  }
+  mLastFrameEnd = now;
+
+  std::scoped_lock lock{mRingsMutex};
+  for (auto& ring : mRings)
+  {
+    if (mIsCapturing == false)
+    {
+      ring->ring.drain(nullptr);
+      continue;
+    }
+
+    mDrained.clear();
+    ring->ring.drain(&mDrained);
+    for (const auto& event : mDrained)
+    {
+      if (mCaptured.size() >= MaxCapturedEvents)
+      {
+        ++mCaptureDropped;
+        continue;
+      }
+      mCaptured.push_back({event, ring->id});
+    }
+  }
+}
+
+void Profiler::startCapture()
+{
+  mCaptured.clear();
+  mCaptureDropped = 0;
+  mIsCapturing = true;
+  RIPSAW_LOG_INFO(Core, "Profiler capture started");
+}
+
+void Profiler::stopCapture()
+{
+  mIsCapturing = false;
+  RIPSAW_LOG_INFO(Core, "Profiler capture stopped: %zu events", mCaptured.size());
+}
+
+bool Profiler::isCapturing() const
+{
+  return mIsCapturing;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const
+{
+  SDL_IOStream* io{SDL_IOFromFile(path.c_str(), "wb")};
+  if (io == nullptr)
+  {
+    RIPSAW_LOG_ERROR(Core, "Failed to open trace file: %s", path.c_str());
+    return false;
+  }
+
+  bool ok{SDL_IOprintf(io, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") > 0};
+  bool isFirst{true};
+  {
+    std::scoped_lock lock{mRingsMutex};
+    for (const auto& ring : mRings)
+    {
+      ok = ok and SDL_IOprintf(io, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", isFirst ? "" : ",", ring->id, ring->name.c_str()) > 0;
+      isFirst = false;
+    }
+  }
+  // Timestamps are in microseconds; zone names are string literals and need no escaping.
+  for (const auto& captured : mCaptured)
+  {
+    ok = ok and SDL_IOprintf(io, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+        isFirst ? "" : ",",
+        captured.event.name,
+        captured.thread,
+        static_cast<double>(captured.event.start) / 1e3,
+        static_cast<double>(captured.event.end - captured.event.start) / 1e3) > 0;
+    isFirst = false;
+  }
+  ok = ok and SDL_IOprintf(io, "\n]}\n") > 0;
+  ok = SDL_CloseIO(io) and ok;
+
+  if (ok)
+    RIPSAW_LOG_INFO(Core, "Wrote %zu profiler events to %s", mCaptured.size(), path.c_str());
+  else
+    RIPSAW_LOG_ERROR(Core, "Failed to write trace file: %s", path.c_str());
+  return ok;
+}
+
+FrameTimeStats Profiler::getFrameTimeStats() const
+{
+  FrameTimeStats stats{};
+  if (mFrameTimes.empty())
+    return stats;
+
+  std::vector<Uint64> sorted{mFrameTimes};
+  std::sort(sorted.begin(), sorted.end());
+  stats.frames = sorted.size();
+  stats.p50 = percentile(sorted, 0.50);
+  stats.p95 = percentile(sorted, 0.95);
+  stats.p99 = percentile(sorted, 0.99);
+  stats.max = static_cast<double>(sorted.back()) / 1e6;
+  return stats;
+}
+
+std::size_t Profiler::getDroppedEvents() const
+{
+  std::size_t dropped{mCaptureDropped};
+  std::scoped_lock lock{mRingsMutex};
+  for (const auto& ring : mRings)
+  {
+    dropped += ring->ring.getDropped();
+  }
+  return dropped;
+}
+
+}
+
+#endif
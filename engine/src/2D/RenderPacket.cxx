@@ -0,0 +1,17 @@
+#include "RipsawEngine/2D/Render/RenderPacket.hxx"
+
+namespace RipsawEngine
+{
+
+void RenderPacket::clear()
+{
+  cameras.clear();
+  sprites.clear();
+  quads.clear();
+  particles.clear();
+  particleBatches.clear();
+  tileVertices.clear();
+  tileBatches.clear();
+}
+
+}
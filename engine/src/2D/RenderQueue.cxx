@@ -0,0 +1,71 @@
+#include "RipsawEngine/2D/Render/RenderQueue.hxx"
+
+#include <array>
+#include <bit>
+#include <utility>
+
+namespace RipsawEngine
+{
+
+std::uint64_t makeSortKey(std::uint8_t layer, float depth)
+{
+  // Flip float bits so that unsigned comparison orders them like the floats: all bits of negatives, only the sign bit of the rest.
+  std::uint32_t bits{std::bit_cast<std::uint32_t>(depth)};
+  bits = (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+  return (static_cast<std::uint64_t>(layer) << 56) | (static_cast<std::uint64_t>(bits) << 24);
+}
+
+void RenderQueue::clear()
+{
+  mItems.clear();
+}
+
+void RenderQueue::push(std::uint64_t key, const SpriteSnapshot* sprite)
+{
+  mItems.push_back({key, sprite});
+}
+
+void RenderQueue::sort()
+{
+  if (mItems.size() < 2)
+    return;
+
+  // Histograms of all eight key bytes are gathered in one sweep.
+  std::array<std::array<std::size_t, 256>, 8> counts{};
+  for (const auto& item : mItems)
+  {
+    for (std::size_t byte{}; byte < 8; ++byte)
+    {
+      ++counts[byte][(item.key >> (byte * 8)) & 0xFF];
+    }
+  }
+
+  mScratch.resize(mItems.size());
+  for (std::size_t byte{}; byte < 8; ++byte)
+  {
+    std::array<std::size_t, 256>& count{counts[byte]};
+    // Every key has the same value in this byte: the pass wouldn't move anything.
+    if (count[(mItems.front().key >> (byte * 8)) & 0xFF] == mItems.size())
+      continue;
+
+    std::size_t offset{};
+    for (auto& c : count)
+    {
+      std::size_t n{c};
+      c = offset;
+      offset += n;
+    }
+    for (const auto& item : mItems)
+    {
+      mScratch[count[(item.key >> (byte * 8)) & 0xFF]++] = item;
+    }
+    std::swap(mItems, mScratch);
+  }
+}
+
+const std::vector<RenderItem>& RenderQueue::getItems() const
+{
+  return mItems;
+}
+
+}
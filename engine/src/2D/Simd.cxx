@@ -0,0 +1,106 @@
+#include "RipsawEngine/2D/Core/Simd.hxx"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace RipsawEngine::Simd
+{
+
+const char* getInstructionSet()
+{
+#if defined(__AVX2__)
+  return "avx2";
+#elif defined(__SSE2__)
+  return "sse2";
+#elif defined(__ARM_NEON)
+  return "neon";
+#else
+  return "scalar";
+#endif
+}
+
+void mulAdd(float* dst, const float* src, float scale, std::size_t n)
+{
+  std::size_t i{};
+
+#if defined(__AVX2__)
+  const __m256 s{_mm256_set1_ps(scale)};
+  for (; i + 8 <= n; i += 8)
+  {
+#if defined(__FMA__)
+    __m256 d{_mm256_fmadd_ps(_mm256_loadu_ps(src + i), s, _mm256_loadu_ps(dst + i))};
+#else
+    __m256 d{_mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), s))};
+#endif
+    _mm256_storeu_ps(dst + i, d);
+  }
+#elif defined(__SSE2__)
+  const __m128 s{_mm_set1_ps(scale)};
+  for (; i + 4 <= n; i += 4)
+  {
+    __m128 d{_mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), s))};
+    _mm_storeu_ps(dst + i, d);
+  }
+#elif defined(__ARM_NEON)
+  const float32x4_t s{vdupq_n_f32(scale)};
+  for (; i + 4 <= n; i += 4)
+  {
+    float32x4_t d{vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), s)};
+    vst1q_f32(dst + i, d);
+  }
+#endif
+
+  // Tail that doesn't fill a whole register.
+  mulAddScalar(dst + i, src + i, scale, n - i);
+}
+
+void mulAddScalar(float* dst, const float* src, float scale, std::size_t n)
+{
+  for (std::size_t i{}; i < n; ++i)
+  {
+    dst[i] += src[i] * scale;
+  }
+}
+
+void add(float* dst, float value, std::size_t n)
+{
+  std::size_t i{};
+
+#if defined(__AVX2__)
+  const __m256 v{_mm256_set1_ps(value)};
+  for (; i + 8 <= n; i += 8)
+  {
+    _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), v));
+  }
+#elif defined(__SSE2__)
+  const __m128 v{_mm_set1_ps(value)};
+  for (; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), v));
+  }
+#elif defined(__ARM_NEON)
+  const float32x4_t v{vdupq_n_f32(value)};
+  for (; i + 4 <= n; i += 4)
+  {
+    vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), v));
+  }
+#endif
+
+  // Tail that doesn't fill a whole register.
+  addScalar(dst + i, value, n - i);
+}
+
+void addScalar(float* dst, float value, std::size_t n)
+{
+  for (std::size_t i{}; i < n; ++i)
+  {
+    dst[i] += value;
+  }
+}
+
+}
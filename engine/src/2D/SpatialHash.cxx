@@ -0,0 +1,327 @@
+#include "RipsawEngine/2D/Systems/SpatialHash.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace RipsawEngine
+{
+
+bool Aabb::overlaps(const Aabb& other) const
+{
+  return min.x <= other.max.x and other.min.x <= max.x and min.y <= other.max.y and other.min.y <= max.y;
+}
+
+SpatialHash::SpatialHash(float cellSize)
+  : mCellSize{cellSize > 0.f ? cellSize : DefaultCellSize},
+    mInvCellSize{1.f / mCellSize}
+{}
+
+Handle SpatialHash::insert(const Aabb& bounds, Handle userData)
+{
+  std::uint32_t slot{};
+  if (mFreeHead != Handle::InvalidIndex)
+  {
+    slot = mFreeHead;
+    mFreeHead = mProxies[slot].nextFree;
+  }
+  else
+  {
+    slot = static_cast<std::uint32_t>(mProxies.size());
+    mProxies.emplace_back();
+  }
+
+  Proxy& proxy{mProxies[slot]};
+  proxy.bounds = bounds;
+  proxy.userData = userData;
+  proxy.cells = this->cellsOf(bounds);
+  proxy.isAlive = true;
+  this->link(slot, proxy.cells);
+  ++mProxyCount;
+  return {slot, proxy.generation};
+}
+
+void SpatialHash::update(Handle handle, const Aabb& bounds)
+{
+  if (this->isValid(handle) == false)
+    return;
+
+  Proxy& proxy{mProxies[handle.index]};
+  proxy.bounds = bounds;
+  CellRange cells{this->cellsOf(bounds)};
+  if (cells == proxy.cells)
+  {
+    ++mMoved;
+    return;
+  }
+
+  // Cells in both ranges keep the proxy listed; only the difference is touched.
+  this->unlink(handle.index, proxy.cells, &cells);
+  this->link(handle.index, cells, &proxy.cells);
+  proxy.cells = cells;
+  ++mRebinned;
+}
+
+void SpatialHash::remove(Handle handle)
+{
+  if (this->isValid(handle) == false)
+    return;
+
+  Proxy& proxy{mProxies[handle.index]};
+  this->unlink(handle.index, proxy.cells);
+  proxy.isAlive = false;
+  ++proxy.generation;
+  proxy.nextFree = mFreeHead;
+  mFreeHead = handle.index;
+  --mProxyCount;
+}
+
+bool SpatialHash::isValid(Handle handle) const
+{
+  return handle.index < mProxies.size() and mProxies[handle.index].isAlive and mProxies[handle.index].generation == handle.generation;
+}
+
+void SpatialHash::queryRect(const Aabb& rect, std::vector<Handle>& out) const
+{
+  CellRange range{this->cellsOf(rect)};
+  for (int y{range.min.y}; y <= range.max.y; ++y)
+  {
+    for (int x{range.min.x}; x <= range.max.x; ++x)
+    {
+      auto it{mCells.find(keyOf({x, y}))};
+      if (it == mCells.end())
+        continue;
+      for (std::uint32_t slot : it->second)
+      {
+        if (this->isFirstCell(slot, range, {x, y}) == false)
+          continue;
+        if (mProxies[slot].bounds.overlaps(rect))
+          out.push_back(mProxies[slot].userData);
+      }
+    }
+  }
+}
+
+void SpatialHash::queryRadius(const glm::vec2& center, float radius, std::vector<Handle>& out) const
+{
+  Aabb rect{center - glm::vec2{radius}, center + glm::vec2{radius}};
+  CellRange range{this->cellsOf(rect)};
+  float radiusSq{radius * radius};
+  for (int y{range.min.y}; y <= range.max.y; ++y)
+  {
+    for (int x{range.min.x}; x <= range.max.x; ++x)
+    {
+      auto it{mCells.find(keyOf({x, y}))};
+      if (it == mCells.end())
+        continue;
+      for (std::uint32_t slot : it->second)
+      {
+        if (this->isFirstCell(slot, range, {x, y}) == false)
+          continue;
+        // Distance from center to the closest point of the box.
+        const Aabb& bounds{mProxies[slot].bounds};
+        glm::vec2 closest{glm::clamp(center, bounds.min, bounds.max)};
+        glm::vec2 d{closest - center};
+        if (d.x * d.x + d.y * d.y <= radiusSq)
+          out.push_back(mProxies[slot].userData);
+      }
+    }
+  }
+}
+
+bool SpatialHash::raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, RayHit& hit) const
+{
+  float length{std::sqrt(direction.x * direction.x + direction.y * direction.y)};
+  if (length == 0.f or (maxDistance > 0.f) == false or mCells.empty())
+    return false;
+  glm::vec2 dir{direction / length};
+
+  constexpr float Inf{std::numeric_limits<float>::infinity()};
+  glm::ivec2 cell{this->cellOf(origin)};
+  glm::ivec2 step{dir.x > 0.f ? 1 : (dir.x < 0.f ? -1 : 0), dir.y > 0.f ? 1 : (dir.y < 0.f ? -1 : 0)};
+  // Distance along the ray to the next vertical and horizontal cell border, and between two of them.
+  glm::vec2 tDelta{dir.x != 0.f ? mCellSize / std::abs(dir.x) : Inf, dir.y != 0.f ? mCellSize / std::abs(dir.y) : Inf};
+  glm::vec2 border{static_cast<float>(cell.x + (step.x > 0 ? 1 : 0)) * mCellSize, static_cast<float>(cell.y + (step.y > 0 ? 1 : 0)) * mCellSize};
+  glm::vec2 tMax{dir.x != 0.f ? (border.x - origin.x) / dir.x : Inf, dir.y != 0.f ? (border.y - origin.y) / dir.y : Inf};
+
+  float best{maxDistance};
+  bool isHit{false};
+  float cellEntry{0.f};
+  while (cellEntry <= best)
+  {
+    // Past the occupied cells on an axis the ray doesn't move back along, nothing further can be hit.
+    // This also bounds walks with infinite or huge maxDistance, where cellEntry may stop growing.
+    if ((step.x >= 0 and cell.x > mOccupied.max.x) or (step.x <= 0 and cell.x < mOccupied.min.x) or (step.y >= 0 and cell.y > mOccupied.max.y) or (step.y <= 0 and cell.y < mOccupied.min.y))
+      break;
+
+    auto it{mCells.find(keyOf(cell))};
+    if (it != mCells.end())
+    {
+      for (std::uint32_t slot : it->second)
+      {
+        // Slab test. A proxy spanning several cells along the ray is tested again in each, which can't change the closest hit.
+        const Aabb& bounds{mProxies[slot].bounds};
+        float tNear{0.f};
+        float tFar{best};
+        bool isMissed{false};
+        for (int axis{}; axis < 2; ++axis)
+        {
+          if (dir[axis] == 0.f)
+          {
+            if (origin[axis] < bounds.min[axis] or origin[axis] > bounds.max[axis])
+              isMissed = true;
+            continue;
+          }
+          float t1{(bounds.min[axis] - origin[axis]) / dir[axis]};
+          float t2{(bounds.max[axis] - origin[axis]) / dir[axis]};
+          tNear = std::max(tNear, std::min(t1, t2));
+          tFar = std::min(tFar, std::max(t1, t2));
+        }
+        if (isMissed or tNear > tFar)
+          continue;
+
+        best = tNear;
+        hit = {mProxies[slot].userData, tNear};
+        isHit = true;
+      }
+    }
+
+    if (tMax.x < tMax.y)
+    {
+      cellEntry = tMax.x;
+      tMax.x += tDelta.x;
+      cell.x += step.x;
+    }
+    else
+    {
+      cellEntry = tMax.y;
+      tMax.y += tDelta.y;
+      cell.y += step.y;
+    }
+  }
+
+  return isHit;
+}
+
+void SpatialHash::queryPairs(std::vector<std::pair<Handle, Handle>>& out) const
+{
+  for (const auto& [key, slots] : mCells)
+  {
+    for (std::size_t i{}; i < slots.size(); ++i)
+    {
+      const Proxy& a{mProxies[slots[i]]};
+      for (std::size_t j{i + 1}; j < slots.size(); ++j)
+      {
+        const Proxy& b{mProxies[slots[j]]};
+        if (a.bounds.overlaps(b.bounds) == false)
+          continue;
+        // Boxes spanning several cells meet in several of them; only the cell holding the corner of their overlap reports the pair.
+        glm::vec2 corner{glm::max(a.bounds.min, b.bounds.min)};
+        if (keyOf(this->cellOf(corner)) != key)
+          continue;
+        out.emplace_back(a.userData, b.userData);
+      }
+    }
+  }
+}
+
+void SpatialHash::clear()
+{
+  for (std::size_t slot{}; slot < mProxies.size(); ++slot)
+  {
+    Proxy& proxy{mProxies[slot]};
+    if (proxy.isAlive == false)
+      continue;
+    proxy.isAlive = false;
+    ++proxy.generation;
+    proxy.nextFree = mFreeHead;
+    mFreeHead = static_cast<std::uint32_t>(slot);
+  }
+  mCells.clear();
+  mProxyCount = 0;
+}
+
+float SpatialHash::getCellSize() const
+{
+  return mCellSize;
+}
+
+SpatialHashStats SpatialHash::getStats() const
+{
+  return {mProxyCount, mCells.size(), mRebinned, mMoved};
+}
+
+void SpatialHash::resetStats()
+{
+  mRebinned = 0;
+  mMoved = 0;
+}
+
+bool SpatialHash::CellRange::contains(const glm::ivec2& cell) const
+{
+  return cell.x >= min.x and cell.x <= max.x and cell.y >= min.y and cell.y <= max.y;
+}
+
+SpatialHash::CellRange SpatialHash::cellsOf(const Aabb& bounds) const
+{
+  return {this->cellOf(bounds.min), this->cellOf(bounds.max)};
+}
+
+glm::ivec2 SpatialHash::cellOf(const glm::vec2& point) const
+{
+  return {static_cast<int>(std::floor(point.x * mInvCellSize)), static_cast<int>(std::floor(point.y * mInvCellSize))};
+}
+
+std::uint64_t SpatialHash::keyOf(const glm::ivec2& cell)
+{
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell.x)) << 32) | static_cast<std::uint32_t>(cell.y);
+}
+
+void SpatialHash::link(std::uint32_t slot, const CellRange& range, const CellRange* skip)
+{
+  if (mCells.empty())
+    mOccupied = range;
+  else
+    mOccupied = {glm::min(mOccupied.min, range.min), glm::max(mOccupied.max, range.max)};
+  for (int y{range.min.y}; y <= range.max.y; ++y)
+  {
+    for (int x{range.min.x}; x <= range.max.x; ++x)
+    {
+      if (skip != nullptr and skip->contains({x, y}))
+        continue;
+      mCells[keyOf({x, y})].push_back(slot);
+    }
+  }
+}
+
+void SpatialHash::unlink(std::uint32_t slot, const CellRange& range, const CellRange* skip)
+{
+  for (int y{range.min.y}; y <= range.max.y; ++y)
+  {
+    for (int x{range.min.x}; x <= range.max.x; ++x)
+    {
+      if (skip != nullptr and skip->contains({x, y}))
+        continue;
+      auto it{mCells.find(keyOf({x, y}))};
+      if (it == mCells.end())
+        continue;
+      std::vector<std::uint32_t>& slots{it->second};
+      auto found{std::find(slots.begin(), slots.end(), slot)};
+      if (found != slots.end())
+      {
+        *found = slots.back();
+        slots.pop_back();
+      }
+      if (slots.empty())
+        mCells.erase(it);
+    }
+  }
+}
+
+bool SpatialHash::isFirstCell(std::uint32_t slot, const CellRange& range, const glm::ivec2& cell) const
+{
+  // The cells a proxy shares with the range form a rectangle; its smallest corner is the one cell reporting the proxy.
+  return cell == glm::max(mProxies[slot].cells.min, range.min);
+}
+
+}
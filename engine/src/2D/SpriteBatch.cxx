@@ -0,0 +1,118 @@
+#include "RipsawEngine/2D/Render/SpriteBatch.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace RipsawEngine
+{
+
+void SpriteBatch::begin(SDL_Renderer* renderer)
+{
+  mRenderer = renderer;
+  mTexture = nullptr;
+  mVertices.clear();
+  mIndices.clear();
+  mDrawCalls = 0;
+  mQuads = 0;
+}
+
+void SpriteBatch::draw(SDL_Texture* texture, const SDL_FRect& src, const SDL_FRect& dst, double angle, SDL_FlipMode flip)
+{
+  if (texture == nullptr)
+    return;
+
+  // A new texture ends the current run. Blend mode is a texture property in SDL, so a run never mixes blend modes either.
+  if (texture != mTexture)
+  {
+    this->flush();
+    mTexture = texture;
+    SDL_GetTextureSize(mTexture, &mTexSize.x, &mTexSize.y);
+  }
+
+  float u0{src.x / mTexSize.x};
+  float v0{src.y / mTexSize.y};
+  float u1{(src.x + src.w) / mTexSize.x};
+  float v1{(src.y + src.h) / mTexSize.y};
+  if (flip == SDL_FLIP_HORIZONTAL)
+    std::swap(u0, u1);
+  if (flip == SDL_FLIP_VERTICAL)
+    std::swap(v0, v1);
+
+  float hw{dst.w / 2.f};
+  float hh{dst.h / 2.f};
+  float cx{dst.x + hw};
+  float cy{dst.y + hh};
+  float c{1.f};
+  float s{0.f};
+  if (angle != 0.0)
+  {
+    double radians{angle * std::numbers::pi / 180.0};
+    c = static_cast<float>(std::cos(radians));
+    s = static_cast<float>(std::sin(radians));
+  }
+
+  // Corners relative to center: top-left, top-right, bottom-right, bottom-left.
+  const float cornersX[4]{-hw, hw, hw, -hw};
+  const float cornersY[4]{-hh, -hh, hh, hh};
+  const float us[4]{u0, u1, u1, u0};
+  const float vs[4]{v0, v0, v1, v1};
+
+  int base{static_cast<int>(mVertices.size())};
+  for (int i{}; i < 4; ++i)
+  {
+    // Clockwise rotation in screen space where Y grows downwards.
+    float x{cornersX[i] * c - cornersY[i] * s};
+    float y{cornersX[i] * s + cornersY[i] * c};
+    mVertices.push_back(SDL_Vertex{{cx + x, cy + y}, {1.f, 1.f, 1.f, 1.f}, {us[i], vs[i]}});
+  }
+  for (int index : {0, 1, 2, 2, 3, 0})
+  {
+    mIndices.push_back(base + index);
+  }
+  ++mQuads;
+}
+
+void SpriteBatch::drawGeometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertexCount, const int* indices, int indexCount)
+{
+  this->flush();
+  mTexture = nullptr;
+  if (!SDL_RenderGeometry(mRenderer, texture, vertices, vertexCount, indices, indexCount))
+  {
+    RIPSAW_LOG_ERROR(Render, "SpriteBatch geometry submission failed: %s", SDL_GetError());
+  }
+  ++mDrawCalls;
+}
+
+void SpriteBatch::flush()
+{
+  if (mVertices.empty())
+    return;
+
+  if (!SDL_RenderGeometry(mRenderer, mTexture, mVertices.data(), static_cast<int>(mVertices.size()), mIndices.data(), static_cast<int>(mIndices.size())))
+  {
+    RIPSAW_LOG_ERROR(Render, "SpriteBatch flush failed: %s", SDL_GetError());
+  }
+  ++mDrawCalls;
+  mVertices.clear();
+  mIndices.clear();
+}
+
+void SpriteBatch::end()
+{
+  this->flush();
+  mTexture = nullptr;
+}
+
+std::size_t SpriteBatch::getDrawCalls() const
+{
+  return mDrawCalls;
+}
+
+std::size_t SpriteBatch::getQuads() const
+{
+  return mQuads;
+}
+
+}
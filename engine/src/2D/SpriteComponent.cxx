@@ -1,44 +1,73 @@
 #include "RipsawEngine/2D/Core/Core.hxx"
+#include "RipsawEngine/2D/Render/Camera.hxx"
+#include "RipsawEngine/2D/Render/RenderPacket.hxx"
+#include "RipsawEngine/2D/Render/RenderQueue.hxx"
 #include "RipsawEngine/2D/Scene/Actor.hxx"
 #include "RipsawEngine/2D/Scene/SpriteComponent.hxx"
 #include "RipsawEngine/2D/Scene/TransformComponent.hxx"
+#include "RipsawEngine/Common/Log.hxx"
 
+#include <bit>
+#include <chrono>
 #include <cmath>
+#include <cstdint>
 
 namespace RipsawEngine
 {
 
-SpriteComponent::SpriteComponent(Actor* actor, SDL_Renderer* renderer, const std::string& imgfile)
+namespace
+{
+
+/// Pool every SpriteComponent is allocated from.
+Pool<SpriteComponent>& spritePool()
+{
+  static Pool<SpriteComponent> pool{};
+  return pool;
+}
+
+}
+
+void* SpriteComponent::operator new(std::size_t size)
+{
+  return spritePool().allocate(size);
+}
+
+void SpriteComponent::operator delete(void* ptr, std::size_t size)
+{
+  spritePool().deallocate(ptr, size);
+}
+
+const PoolStats& SpriteComponent::getPoolStats()
+{
+  return spritePool().getStats();
+}
+
+SpriteComponent::SpriteComponent(Actor* actor, SDL_Renderer* renderer, const std::string& imgfile, bool loadAsync)
   : Component{actor},
     mRenderer{renderer},
     mImgFile{imgfile}
 {
-  mOwner->helperRegisterComponent("SpriteComponent");
+  mOwner->registerComponent(TypeId, this);
   mOwner->setSpriteComponent(this);
+  mOwner->getEngine()->insertActorSpritePair(std::make_pair(mOwner, this));
+  mIsTextureShared = true;
 
-  SDL_Surface* surface{IMG_Load(mImgFile.c_str())};
-  if (surface != nullptr)
-  {
-    mTexture = SDL_CreateTextureFromSurface(mRenderer, surface);
-  }
-  SDL_DestroySurface(surface);
-
-  if (mTexture != nullptr)
+  if (loadAsync)
   {
-    float w{}, h{};
-    SDL_GetTextureSize(mTexture, &w, &h);
-    mTexSize = {w, h};
+    mLoading = mOwner->getEngine()->getAssetLoader().loadTexture(mImgFile);
+    this->pollTexture();
   }
+  else
+    this->acquireTexture();
 
   if (this->isComponentValid())
   {
-    SDL_Log("[INFO] Component added: SpriteComponent: %p to Actor: %p", static_cast<void*>(this), static_cast<void*>(mOwner));
-    SDL_Log("\tTexture size: %.2f X %.2f", static_cast<double>(mTexSize.x), static_cast<double>(mTexSize.y));
+    RIPSAW_LOG_DEBUG(Scene, "Component added: SpriteComponent: %p to Actor: %p, texture size: %.2f X %.2f", static_cast<void*>(this), static_cast<void*>(mOwner), static_cast<double>(mTexSize.x), static_cast<double>(mTexSize.y));
     mOwner->getEngine()->addSprite(this);
   }
   else
   {
-    SDL_Log("[ERROR] SpriteComponent construction FAILED");
+    RIPSAW_LOG_ERROR(Scene, "SpriteComponent construction FAILED");
   }
 }
 
@@ -46,8 +75,9 @@ SpriteComponent::SpriteComponent(class Actor* actor, SDL_Renderer* renderer, con
   : Component{actor},
     mRenderer{renderer}
 {
-  mOwner->helperRegisterComponent("SpriteComponent");
+  mOwner->registerComponent(TypeId, this);
   mOwner->setSpriteComponent(this);
+  mOwner->getEngine()->insertActorSpritePair(std::make_pair(mOwner, this));
 
   SDL_Surface* surface{SDL_CreateSurface(static_cast<int>(size.x), static_cast<int>(size.y), SDL_PIXELFORMAT_RGBA8888)};
   Uint32 col{SDL_MapSurfaceRGBA(surface, std::get<0>(color), std::get<1>(color), std::get<2>(color), std::get<3>(color))};
@@ -56,6 +86,7 @@ SpriteComponent::SpriteComponent(class Actor* actor, SDL_Renderer* renderer, con
   {
     mTexture = SDL_CreateTextureFromSurface(mRenderer, surface);
   }
+  this->updateTextureKey();
   SDL_DestroySurface(surface);
   
   if (mTexture != nullptr)
@@ -63,24 +94,29 @@ SpriteComponent::SpriteComponent(class Actor* actor, SDL_Renderer* renderer, con
     float w{}, h{};
     SDL_GetTextureSize(mTexture, &w, &h);
     mTexSize = {w, h};
+    mTexRegion = {0, 0, w, h};
   }
 
   if (this->isComponentValid())
   {
-    SDL_Log("[INFO] Component added: SpriteComponent: %p to Actor: %p", static_cast<void*>(this), static_cast<void*>(mOwner));
-    SDL_Log("\tTexture size: %.2f X %.2f", static_cast<double>(mTexSize.x), static_cast<double>(mTexSize.y));
+    RIPSAW_LOG_DEBUG(Scene, "Component added: SpriteComponent: %p to Actor: %p, texture size: %.2f X %.2f", static_cast<void*>(this), static_cast<void*>(mOwner), static_cast<double>(mTexSize.x), static_cast<double>(mTexSize.y));
     mOwner->getEngine()->addSprite(this);
   }
   else
   {
-    SDL_Log("[ERROR] SpriteComponent construction FAILED");
+    RIPSAW_LOG_ERROR(Scene, "SpriteComponent construction FAILED");
   }
 }
 
 SpriteComponent::~SpriteComponent()
 {
-  mOwner->deregisterComponent("SpriteComponent");
-  SDL_DestroyTexture(mTexture);
+  mOwner->deregisterComponent(TypeId);
+  if (this->isLoading())
+    mOwner->getEngine()->getAssetLoader().releaseTexture(mImgFile);
+  if (mIsTextureShared and mTexture != nullptr)
+    mOwner->getEngine()->getTextureCache().release(mImgFile);
+  else
+    SDL_DestroyTexture(mTexture);
   mOwner->getEngine()->removeSprite(this);
 }
 
@@ -89,11 +125,67 @@ bool SpriteComponent::isComponentValid() const
   bool isValid{true};
   if (mRenderer == nullptr)
     isValid = false;
-  if (mTexture == nullptr)
+  if (mTexture == nullptr and !this->isLoading())
     isValid = false;
   return isValid;
 }
 
+bool SpriteComponent::isLoading() const
+{
+  return mLoading.valid();
+}
+
+std::size_t SpriteComponent::getSpriteIndex() const
+{
+  return mSpriteIndex;
+}
+
+void SpriteComponent::setSpriteIndex(std::size_t index)
+{
+  mSpriteIndex = index;
+}
+
+std::uint8_t SpriteComponent::getLayer() const
+{
+  return mLayer;
+}
+
+void SpriteComponent::setLayer(std::uint8_t layer)
+{
+  mLayer = layer;
+}
+
+float SpriteComponent::getDepth() const
+{
+  return mDepth;
+}
+
+void SpriteComponent::setDepth(float depth)
+{
+  mDepth = depth;
+}
+
+bool SpriteComponent::isYSorted() const
+{
+  return mIsYSorted;
+}
+
+void SpriteComponent::setYSorted(bool ySorted)
+{
+  mIsYSorted = ySorted;
+}
+
+std::uint64_t SpriteComponent::getSortKey() const
+{
+  float depth{mDepth};
+  if (mIsYSorted)
+  {
+    SDL_FRect dstrect{this->getDestRect()};
+    depth = dstrect.y + dstrect.h;
+  }
+  return makeSortKey(mLayer, depth) | mTextureKey;
+}
+
 SDL_Texture* SpriteComponent::getTexture() const
 {
   return mTexture;
@@ -104,22 +196,94 @@ glm::vec2 SpriteComponent::getTexSize() const
   return {mTexSize.x * mScale, mTexSize.y * mScale};
 }
 
+const SDL_FRect& SpriteComponent::getTexRegion() const
+{
+  return mTexRegion;
+}
+
 void SpriteComponent::draw(double dt)
+{
+  this->animate(dt);
+  if (!this->pollTexture())
+    return;
+
+  SDL_FRect srcrect{this->getSourceRect()};
+  srcrect.x += mTexRegion.x;
+  srcrect.y += mTexRegion.y;
+  double angle{};
+  SDL_FRect dstrect{this->getScreenRect(mOwner->getEngine()->getCamera(), angle)};
+  if (!SDL_RenderTextureRotated(mRenderer, mTexture, &srcrect, &dstrect, angle, nullptr, mFlipState))
+  {
+    RIPSAW_LOG_ERROR(Render, "Draw failed on SpriteComponent: %p", static_cast<void*>(this));
+  }
+}
+
+void SpriteComponent::animate(double dt)
 {
   mRotationAmount += mRotationSpeed * dt;
   this->normalizeDegrees(mRotationAmount);
+}
 
-  SDL_FRect rect
+SDL_FRect SpriteComponent::getSourceRect() const
+{
+  return {0, 0, mTexSize.x, mTexSize.y};
+}
+
+SDL_FRect SpriteComponent::getDestRect() const
+{
+  SDL_FRect srcrect{this->getSourceRect()};
+  glm::vec2 pos{mOwner->getTransformComponent()->getRenderPosition()};
+  return
   {
-    mOwner->getTransformComponent()->getPosition().x - mTexSize.x * mScale / 2.f,
-    mOwner->getTransformComponent()->getPosition().y - mTexSize.y * mScale / 2.f,
-    mTexSize.x * mScale,
-    mTexSize.y * mScale
+    pos.x - srcrect.w * mScale / 2.f,
+    pos.y - srcrect.h * mScale / 2.f,
+    srcrect.w * mScale,
+    srcrect.h * mScale
   };
-  if (!SDL_RenderTextureRotated(mRenderer, mTexture, nullptr, &rect, mRotationAmount, nullptr, mFlipState))
+}
+
+Aabb SpriteComponent::getBounds() const
+{
+  SDL_FRect dstrect{this->getDestRect()};
+  glm::vec2 center{dstrect.x + dstrect.w / 2.f, dstrect.y + dstrect.h / 2.f};
+  glm::vec2 half{dstrect.w / 2.f, dstrect.h / 2.f};
+  if (mRotationAmount != 0.0)
   {
-    SDL_Log("[ERROR] Draw failed on SpriteComponent: %p", static_cast<void*>(this));
+    // Rotation happens around the center; the rotated rectangle spans |w cos| + |h sin| horizontally and |w sin| + |h cos| vertically.
+    double radians{mRotationAmount * SDL_PI_D / 180.0};
+    float c{static_cast<float>(std::abs(std::cos(radians)))};
+    float s{static_cast<float>(std::abs(std::sin(radians)))};
+    half = {half.x * c + half.y * s, half.x * s + half.y * c};
   }
+  return {center - half, center + half};
+}
+
+bool SpriteComponent::isScreenSpace() const
+{
+  return mIsScreenSpace;
+}
+
+void SpriteComponent::setScreenSpace(bool screenSpace)
+{
+  mIsScreenSpace = screenSpace;
+}
+
+void SpriteComponent::snapshot(SpriteSnapshot& out) const
+{
+  out.texture = mTexture;
+  out.actor = mOwner->getHandle();
+  if (mTexture == nullptr)
+    return;
+
+  out.src = this->getSourceRect();
+  out.src.x += mTexRegion.x;
+  out.src.y += mTexRegion.y;
+  out.dst = this->getDestRect();
+  out.bounds = this->getBounds();
+  out.key = this->getSortKey();
+  out.rotation = mRotationAmount;
+  out.flip = mFlipState;
+  out.isScreenSpace = mIsScreenSpace;
 }
 
 float SpriteComponent::getScale() const
@@ -132,7 +296,7 @@ void SpriteComponent::setScale(float scale)
   mScale = scale;
   mTexSizeDynamic.x = mTexSize.x * scale;
   mTexSizeDynamic.y = mTexSize.y * scale;
-  SDL_Log("[INFO] SpriteComponent: %p scaled by %.2fx: %.2f X %.2f", static_cast<void*>(this), static_cast<double>(scale), static_cast<double>(mTexSizeDynamic.x), static_cast<double>(mTexSizeDynamic.y));
+  RIPSAW_LOG_DEBUG(Scene, "SpriteComponent: %p scaled by %.2fx: %.2f X %.2f", static_cast<void*>(this), static_cast<double>(scale), static_cast<double>(mTexSizeDynamic.x), static_cast<double>(mTexSizeDynamic.y));
 }
 
 double SpriteComponent::getRotationAmount() const
@@ -159,7 +323,7 @@ void SpriteComponent::rotateClockwiseAmount(double degrees)
 {
   if (degrees < 0)
   {
-    SDL_Log("[ERROR] Clockwise degree amount should be positive");
+    RIPSAW_LOG_ERROR(Scene, "Clockwise degree amount should be positive");
     return;
   }
 
@@ -172,7 +336,7 @@ void SpriteComponent::rotateAntiClockwiseAmount(double degrees)
 {
   if (degrees < 0)
   {
-    SDL_Log("[ERROR] Anti-Clockwise degree amount should be positive");
+    RIPSAW_LOG_ERROR(Scene, "Anti-Clockwise degree amount should be positive");
     return;
   }
 
@@ -185,7 +349,7 @@ void SpriteComponent::flipHorizontally()
 {
   if (mHasRotated == true)
   {
-    SDL_Log("[ERROR] Cannot flip after rotation");
+    RIPSAW_LOG_ERROR(Scene, "Cannot flip after rotation");
     return;
   }
 
@@ -196,7 +360,7 @@ void SpriteComponent::flipVertically()
 {
   if (mHasRotated == true)
   {
-    SDL_Log("[ERROR] Cannot flip after rotation");
+    RIPSAW_LOG_ERROR(Scene, "Cannot flip after rotation");
     return;
   }
 
@@ -207,7 +371,7 @@ void SpriteComponent::flipDefault()
 {
   if (mHasRotated == true)
   {
-    SDL_Log("[ERROR] Cannot flip after rotation");
+    RIPSAW_LOG_ERROR(Scene, "Cannot flip after rotation");
     return;
   }
 
@@ -232,9 +396,20 @@ SDL_FlipMode SpriteComponent::getFlipState() const
   return mFlipState;
 }
 
+glm::vec2 SpriteComponent::getSourceTexSize() const
+{
+  return mTexSize;
+}
+
+SDL_FRect SpriteComponent::getScreenRect(const Camera& camera, double& angle) const
+{
+  angle = mRotationAmount;
+  return camera.projectRect(this->getDestRect(), mIsScreenSpace, angle);
+}
+
 void SpriteComponent::fitByAspectRatio()
 {
-  SDL_Log("[INFO] SpriteComponent: %p fitting by aspect ratio", static_cast<void*>(this));
+  RIPSAW_LOG_DEBUG(Scene, "SpriteComponent: %p fitting by aspect ratio", static_cast<void*>(this));
   float sw{static_cast<float>(mOwner->getEngine()->getScreenSize().first)};
   float sh{static_cast<float>(mOwner->getEngine()->getScreenSize().second)};
   float ratw{sw / mTexSize.x};
@@ -243,6 +418,55 @@ void SpriteComponent::fitByAspectRatio()
   this->setScale(ratbig);
 }
 
+bool SpriteComponent::pollTexture()
+{
+  if (mTexture != nullptr)
+    return true;
+  if (!this->isLoading() or mLoading.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+    return false;
+
+  bool isLoaded{mLoading.get()};
+  // Acquire before dropping the claim, which is what keeps the texture from being evicted until now.
+  if (isLoaded)
+    this->acquireTexture();
+  mLoading = {};
+  mOwner->getEngine()->getAssetLoader().releaseTexture(mImgFile);
+  if (!isLoaded)
+  {
+    RIPSAW_LOG_ERROR(Scene, "SpriteComponent: %p failed to load %s", static_cast<void*>(this), mImgFile.c_str());
+    return false;
+  }
+
+  return mTexture != nullptr;
+}
+
+void SpriteComponent::acquireTexture()
+{
+  TextureRegion region{mOwner->getEngine()->getTextureCache().acquire(mImgFile)};
+  mTexture = region.texture;
+  mTexRegion = region.rect;
+  this->updateTextureKey();
+  mTexSize = {mTexRegion.w, mTexRegion.h};
+  mTexSizeDynamic = {mTexSize.x * mScale, mTexSize.y * mScale};
+}
+
+void SpriteComponent::updateTextureKey()
+{
+  if (mTexture == nullptr)
+  {
+    mTextureKey = 0;
+    return;
+  }
+
+  SDL_BlendMode blend{SDL_BLENDMODE_NONE};
+  SDL_GetTextureBlendMode(mTexture, &blend);
+  // Built-in blend modes are single bits; their position fits into 4 bits.
+  std::uint64_t blendBits{static_cast<std::uint64_t>(std::bit_width(blend)) & 0xF};
+  // Textures are told apart by address. Colliding ids only cost merges, never correctness.
+  std::uint64_t textureId{(reinterpret_cast<std::uintptr_t>(mTexture) >> 4) & 0xFFFF};
+  mTextureKey = (blendBits << 20) | (textureId << 4);
+}
+
 void SpriteComponent::normalizeDegrees(double& degrees)
 {
   degrees = fmod(degrees, 360.0);
@@ -2,73 +2,151 @@
 #include "RipsawEngine/2D/Scene/Actor.hxx"
 #include "RipsawEngine/2D/Scene/SpritesheetComponent.hxx"
 #include "RipsawEngine/2D/Scene/TransformComponent.hxx"
+#include "RipsawEngine/2D/Systems/AnimationSystem.hxx"
+#include "RipsawEngine/Common/Log.hxx"
 
 namespace RipsawEngine
 {
 
-SpritesheetComponent::SpritesheetComponent(Actor* actor, SDL_Renderer* renderer, const std::string& imgfile, const glm::ivec2& dims, const glm::ivec2& defaultCoord, bool doAnimate, float animFPS)
-  : SpriteComponent{actor, renderer, imgfile},
+namespace
+{
+
+/// Pool every SpritesheetComponent is allocated from.
+Pool<SpritesheetComponent>& spritesheetPool()
+{
+  static Pool<SpritesheetComponent> pool{};
+  return pool;
+}
+
+}
+
+void* SpritesheetComponent::operator new(std::size_t size)
+{
+  return spritesheetPool().allocate(size);
+}
+
+void SpritesheetComponent::operator delete(void* ptr, std::size_t size)
+{
+  spritesheetPool().deallocate(ptr, size);
+}
+
+const PoolStats& SpritesheetComponent::getPoolStats()
+{
+  return spritesheetPool().getStats();
+}
+
+SpritesheetComponent::SpritesheetComponent(Actor* actor, SDL_Renderer* renderer, const std::string& imgfile, const glm::ivec2& dims, const glm::ivec2& defaultCoord, bool doAnimate, float animFPS, bool loadAsync)
+  : SpriteComponent{actor, renderer, imgfile, loadAsync},
     mDims{dims},
     mDefaultCoord{defaultCoord},
-    mDoAnimate{doAnimate},
-    mAnimFPS{animFPS}
+    mAnimationSystem{&actor->getEngine()->getAnimationSystem()}
 {
+  mOwner->registerComponent(TypeId, this);
   if (defaultCoord.x > mDims.x or defaultCoord.x < 1 or defaultCoord.y > mDims.y or defaultCoord.y < 1)
   {
-    SDL_Log("[ERROR] Invalid spritesheet coordinate, defaulted to {1, 1}");
+    RIPSAW_LOG_WARN(Scene, "Invalid spritesheet coordinate, defaulted to {1, 1}");
     mDefaultCoord = {1, 1};
   }
+
+  if (doAnimate == false)
+    return;
+  if (animFPS <= 0.f)
+  {
+    RIPSAW_LOG_WARN(Scene, "Invalid spritesheet animation FPS, animation disabled");
+    return;
+  }
+  // Sheets of the same layout share one single-clip set looping the default row.
+  std::string setName{"row " + std::to_string(mDefaultCoord.y) + " of " + std::to_string(mDims.x) + " at " + std::to_string(animFPS) + " FPS"};
+  if (mAnimationSystem->hasSet(setName) == false)
+    mAnimationSystem->addSet(setName, {{AnimationClip::fromRow("row", mDefaultCoord.y, mDims.x, animFPS)}, {}, {}});
+  this->setAnimationSet(setName);
 }
 
-void SpritesheetComponent::draw(double dt)
+SpritesheetComponent::~SpritesheetComponent()
 {
-  double rotationAmount{SpriteComponent::getRotationAmount()};
-  double rotationSpeed{SpriteComponent::getRotationSpeed()};
-  rotationAmount += rotationSpeed * dt;
-  SpriteComponent::normalizeDegrees(rotationAmount);
-  SpriteComponent::setRotationAmount(rotationAmount);
-  SDL_Texture* texture{SpriteComponent::getTexture()};
-  glm::vec2 texSize{SpriteComponent::getTexSize()};
-  float scale{SpriteComponent::getScale()};
-  float texw{texSize.x / mDims.x * scale};
-  float texh{texSize.y / mDims.y * scale};
+  mOwner->deregisterComponent(TypeId);
+  mAnimationSystem->destroy(mAnimator);
+}
 
-  if (mDoAnimate == true)
-  {
-    mCurrentFrame += static_cast<double>(mAnimFPS) * dt;
-    int frame{static_cast<int>(mCurrentFrame)};
-    if (frame >= mDims.x)
-    {
-      mDefaultCoord.x = 1;
-      mCurrentFrame = 1;
-    }
-    else
-      mDefaultCoord.x = frame;
-  }
+SDL_FRect SpritesheetComponent::getSourceRect() const
+{
+  glm::vec2 texSize{SpriteComponent::getSourceTexSize()};
+  float texw{texSize.x / static_cast<float>(mDims.x)};
+  float texh{texSize.y / static_cast<float>(mDims.y)};
+  glm::ivec2 coord{mAnimator.isNull() ? mDefaultCoord : mAnimationSystem->getCoord(mAnimator)};
 
-  SDL_FRect srcrect
+  return
   {
-    texw * (mDefaultCoord.x - 1),
-    texh * (mDefaultCoord.y - 1),
+    texw * static_cast<float>(coord.x - 1),
+    texh * static_cast<float>(coord.y - 1),
     texw,
     texh
   };
-  SDL_FRect dstrect
+}
+
+void SpritesheetComponent::changeCoord(const glm::ivec2& coord)
+{
+  mDefaultCoord = coord;
+  mAnimationSystem->destroy(mAnimator);
+  mAnimator = {};
+}
+
+bool SpritesheetComponent::setAnimationSet(const std::string& name)
+{
+  Handle animator{mAnimationSystem->create(name, this)};
+  if (animator.isNull())
+    return false;
+
+  mAnimationSystem->destroy(mAnimator);
+  mAnimator = animator;
+  return true;
+}
+
+bool SpritesheetComponent::isAnimated() const
+{
+  return mAnimator.isNull() == false;
+}
+
+void SpritesheetComponent::playAnimation(const std::string& clip)
+{
+  if (mAnimator.isNull())
   {
-    mOwner->getTransformComponent()->getPosition().x - texw * scale / 2.f,
-    mOwner->getTransformComponent()->getPosition().y - texh * scale / 2.f,
-    texw,
-    texh
-  };
-  if (!SDL_RenderTextureRotated(SpriteComponent::getRenderer(), texture, &srcrect, &dstrect, rotationAmount, nullptr, SpriteComponent::getFlipState()))
+    RIPSAW_LOG_ERROR(Scene, "Can't play clip %s: SpritesheetComponent %p isn't animated", clip.c_str(), static_cast<const void*>(this));
+    return;
+  }
+  mAnimationSystem->play(mAnimator, clip);
+}
+
+void SpritesheetComponent::triggerAnimation(const std::string& trigger)
+{
+  if (mAnimator.isNull())
   {
-    SDL_Log("[ERROR] Draw failed on SpritesheetComponent: %p", static_cast<void*>(this));
+    RIPSAW_LOG_ERROR(Scene, "Can't fire trigger %s: SpritesheetComponent %p isn't animated", trigger.c_str(), static_cast<const void*>(this));
+    return;
   }
+  mAnimationSystem->trigger(mAnimator, trigger);
 }
 
-void SpritesheetComponent::changeCoord(const glm::ivec2& coord)
+std::string SpritesheetComponent::getAnimationState() const
 {
-  mDefaultCoord = coord;
+  return mAnimator.isNull() ? std::string{} : mAnimationSystem->getState(mAnimator);
+}
+
+bool SpritesheetComponent::isAnimationFinished() const
+{
+  return mAnimator.isNull() == false and mAnimationSystem->isFinished(mAnimator);
+}
+
+void SpritesheetComponent::setAnimationPaused(bool paused)
+{
+  if (mAnimator.isNull() == false)
+    mAnimationSystem->setPaused(mAnimator, paused);
+}
+
+void SpritesheetComponent::setAnimationSpeed(float speed)
+{
+  if (mAnimator.isNull() == false)
+    mAnimationSystem->setSpeed(mAnimator, speed);
 }
 
 }
@@ -0,0 +1,117 @@
+#include "RipsawEngine/2D/Systems/SystemScheduler.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace RipsawEngine
+{
+
+bool SystemScheduler::addSystem(const std::string& name, ComponentMask reads, ComponentMask writes, SystemFunction update)
+{
+  if (!update)
+  {
+    RIPSAW_LOG_ERROR(Systems, "System %s has no update function", name.c_str());
+    return false;
+  }
+  auto it{std::find_if(mSystems.begin(), mSystems.end(), [&name](const System& system) {
+      return system.name == name;
+  })};
+  if (it != mSystems.end())
+  {
+    RIPSAW_LOG_ERROR(Systems, "System already registered: %s", name.c_str());
+    return false;
+  }
+
+  mSystems.push_back({name, reads, writes, std::move(update)});
+  mIsDirty = true;
+  return true;
+}
+
+void SystemScheduler::removeSystem(const std::string& name)
+{
+  auto it{std::find_if(mSystems.begin(), mSystems.end(), [&name](const System& system) {
+      return system.name == name;
+  })};
+  if (it == mSystems.end())
+    return;
+
+  // Erase keeps registration order, which phases depend on.
+  mSystems.erase(it);
+  mIsDirty = true;
+}
+
+void SystemScheduler::run(double dt, JobSystem& jobs)
+{
+  if (mIsDirty)
+    this->buildPhases();
+
+  for (std::size_t phase{}; phase + 1 < mPhaseStarts.size(); ++phase)
+  {
+    std::size_t start{mPhaseStarts[phase]};
+    std::size_t count{mPhaseStarts[phase + 1] - start};
+    // One system per job; the job system runs a lone system inline.
+    jobs.parallelFor(count, [this, start, dt](std::size_t begin, std::size_t end) {
+        for (std::size_t i{begin}; i < end; ++i)
+        {
+          mSystems[mOrder[start + i]].update(dt);
+        }
+    }, 1);
+  }
+}
+
+std::size_t SystemScheduler::getSystemCount() const
+{
+  return mSystems.size();
+}
+
+std::size_t SystemScheduler::getPhaseCount()
+{
+  if (mIsDirty)
+    this->buildPhases();
+  return mPhaseStarts.empty() ? 0 : mPhaseStarts.size() - 1;
+}
+
+bool SystemScheduler::conflicts(const System& a, const System& b)
+{
+  return (a.writes & (b.reads | b.writes)) != 0 or (b.writes & a.reads) != 0;
+}
+
+void SystemScheduler::buildPhases()
+{
+  // Each system lands one phase after the latest earlier system it conflicts with. O(systems^2), and systems are few.
+  std::vector<std::size_t> phaseOf(mSystems.size());
+  std::size_t phases{};
+  for (std::size_t i{}; i < mSystems.size(); ++i)
+  {
+    for (std::size_t j{}; j < i; ++j)
+    {
+      if (conflicts(mSystems[i], mSystems[j]))
+        phaseOf[i] = std::max(phaseOf[i], phaseOf[j] + 1);
+    }
+    phases = std::max(phases, phaseOf[i] + 1);
+  }
+
+  mPhaseStarts.assign(phases + 1, 0);
+  for (std::size_t phase : phaseOf)
+  {
+    ++mPhaseStarts[phase + 1];
+  }
+  for (std::size_t phase{}; phase < phases; ++phase)
+  {
+    mPhaseStarts[phase + 1] += mPhaseStarts[phase];
+  }
+  mOrder.resize(mSystems.size());
+  std::vector<std::size_t> cursor{mPhaseStarts};
+  for (std::size_t i{}; i < mSystems.size(); ++i)
+  {
+    mOrder[cursor[phaseOf[i]]++] = i;
+  }
+  mIsDirty = false;
+
+  RIPSAW_LOG_INFO(Systems, "Scheduled %zu systems in %zu phases", mSystems.size(), phases);
+}
+
+}
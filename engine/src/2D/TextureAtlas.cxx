@@ -0,0 +1,419 @@
+#include "RipsawEngine/2D/Render/TextureAtlas.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <SDL3_image/SDL_image.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace RipsawEngine
+{
+
+namespace
+{
+
+/// Magic at the start of a baked atlas index.
+constexpr Uint32 AtlasMagic{0x54415352}; // "RSAT" little-endian
+/// Version of baked atlas index format.
+constexpr Uint32 AtlasVersion{1};
+/// Longest image key a baked atlas index may hold.
+constexpr Uint32 MaxKeyLength{4096};
+
+std::string indexPath(const std::string& dir)
+{
+  return dir + "/atlas.idx";
+}
+
+std::string pagePath(const std::string& dir, std::size_t page)
+{
+  return dir + "/atlas_" + std::to_string(page) + ".png";
+}
+
+/// Returns surface in RGBA32, converting if needed. Result must be freed if it differs from input.
+SDL_Surface* toRGBA32(SDL_Surface* surface)
+{
+  if (surface->format == SDL_PIXELFORMAT_RGBA32)
+    return surface;
+  return SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+}
+
+}
+
+SkylinePacker::SkylinePacker(int width, int height)
+  : mWidth{width},
+    mHeight{height}
+{
+  mSkyline.push_back({0, 0, mWidth});
+}
+
+bool SkylinePacker::insert(int w, int h, SDL_Rect& out)
+{
+  std::size_t bestIndex{mSkyline.size()};
+  int bestTop{INT_MAX};
+  int bestWidth{INT_MAX};
+  int bestY{};
+
+  // Bottom-left rule: lowest top edge wins, narrower segment breaks ties.
+  for (std::size_t i{}; i < mSkyline.size(); ++i)
+  {
+    int y{this->fit(i, w, h)};
+    if (y < 0)
+      continue;
+    if (y + h < bestTop or (y + h == bestTop and mSkyline[i].w < bestWidth))
+    {
+      bestIndex = i;
+      bestTop = y + h;
+      bestWidth = mSkyline[i].w;
+      bestY = y;
+    }
+  }
+
+  if (bestIndex == mSkyline.size())
+    return false;
+
+  out = {mSkyline[bestIndex].x, bestY, w, h};
+
+  // Raise the skyline over the new rectangle and trim segments it now covers.
+  mSkyline.insert(mSkyline.begin() + static_cast<std::ptrdiff_t>(bestIndex), Segment{out.x, bestY + h, w});
+  for (std::size_t i{bestIndex + 1}; i < mSkyline.size();)
+  {
+    const Segment& prev{mSkyline[i - 1]};
+    Segment& cur{mSkyline[i]};
+    int overlap{prev.x + prev.w - cur.x};
+    if (overlap <= 0)
+      break;
+    cur.x += overlap;
+    cur.w -= overlap;
+    if (cur.w > 0)
+      break;
+    mSkyline.erase(mSkyline.begin() + static_cast<std::ptrdiff_t>(i));
+  }
+
+  // Merge neighbours at the same height.
+  for (std::size_t i{}; i + 1 < mSkyline.size();)
+  {
+    if (mSkyline[i].y == mSkyline[i + 1].y)
+    {
+      mSkyline[i].w += mSkyline[i + 1].w;
+      mSkyline.erase(mSkyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+    }
+    else
+      ++i;
+  }
+
+  return true;
+}
+
+int SkylinePacker::fit(std::size_t index, int w, int h) const
+{
+  int x{mSkyline[index].x};
+  if (x + w > mWidth)
+    return -1;
+
+  int y{mSkyline[index].y};
+  int widthLeft{w};
+  for (std::size_t i{index}; widthLeft > 0; ++i)
+  {
+    y = std::max(y, mSkyline[i].y);
+    if (y + h > mHeight)
+      return -1;
+    widthLeft -= mSkyline[i].w;
+  }
+  return y;
+}
+
+TextureAtlas::~TextureAtlas()
+{
+  this->clear();
+}
+
+void TextureAtlas::setRenderer(SDL_Renderer* renderer)
+{
+  mRenderer = renderer;
+  Sint64 maxSize{SDL_GetNumberProperty(SDL_GetRendererProperties(mRenderer), SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0)};
+  if (maxSize > 0 and maxSize < mPageSize)
+  {
+    mPageSize = static_cast<int>(maxSize);
+  }
+}
+
+void TextureAtlas::setPageSize(int size)
+{
+  mPageSize = size;
+}
+
+bool TextureAtlas::accepts(int w, int h) const
+{
+  // Anything larger than a quarter page gets a texture of its own rather than crowding out small sprites.
+  int limit{mPageSize / 2};
+  return w + Padding <= limit and h + Padding <= limit;
+}
+
+bool TextureAtlas::insert(const std::string& key, SDL_Surface* surface, TextureRegion& out)
+{
+  if (surface == nullptr or this->accepts(surface->w, surface->h) == false)
+    return false;
+
+  SDL_Rect rect{};
+  std::size_t pageIndex{mPages.size()};
+  for (std::size_t i{}; i < mPages.size(); ++i)
+  {
+    if (mPages[i].isFull == false and mPages[i].packer.insert(surface->w + Padding, surface->h + Padding, rect))
+    {
+      pageIndex = i;
+      break;
+    }
+  }
+  // No room anywhere, open a new page which becomes pageIndex.
+  if (pageIndex == mPages.size())
+  {
+    if (this->addPage() == false or mPages.back().packer.insert(surface->w + Padding, surface->h + Padding, rect) == false)
+      return false;
+  }
+
+  rect.w = surface->w;
+  rect.h = surface->h;
+  SDL_Surface* rgba{toRGBA32(surface)};
+  if (rgba == nullptr)
+    return false;
+  bool uploaded{SDL_UpdateTexture(mPages[pageIndex].texture, &rect, rgba->pixels, rgba->pitch)};
+  if (rgba != surface)
+    SDL_DestroySurface(rgba);
+  if (uploaded == false)
+  {
+    RIPSAW_LOG_ERROR(Assets, "Atlas upload failed for %s: %s", key.c_str(), SDL_GetError());
+    return false;
+  }
+
+  mEntries[key] = {pageIndex, rect};
+  return this->find(key, out);
+}
+
+bool TextureAtlas::find(const std::string& key, TextureRegion& out) const
+{
+  auto it{mEntries.find(key)};
+  if (it == mEntries.end())
+    return false;
+
+  const SDL_Rect& rect{it->second.rect};
+  out.texture = mPages[it->second.page].texture;
+  out.rect = {static_cast<float>(rect.x), static_cast<float>(rect.y), static_cast<float>(rect.w), static_cast<float>(rect.h)};
+  return true;
+}
+
+bool TextureAtlas::load(const std::string& dir)
+{
+  SDL_IOStream* io{SDL_IOFromFile(indexPath(dir).c_str(), "rb")};
+  if (io == nullptr)
+  {
+    RIPSAW_LOG_ERROR(Assets, "Failed opening atlas index in %s: %s", dir.c_str(), SDL_GetError());
+    return false;
+  }
+
+  Uint32 magic{}, version{}, pageCount{}, entryCount{};
+  bool ok{SDL_ReadU32LE(io, &magic) and SDL_ReadU32LE(io, &version) and SDL_ReadU32LE(io, &pageCount) and SDL_ReadU32LE(io, &entryCount)};
+  if (ok == false or magic != AtlasMagic or version != AtlasVersion)
+  {
+    RIPSAW_LOG_ERROR(Assets, "Invalid atlas index in %s", dir.c_str());
+    SDL_CloseIO(io);
+    return false;
+  }
+
+  // Nothing reaches the atlas until the whole index checks out, pages loaded so far are dropped on failure.
+  std::size_t firstPage{mPages.size()};
+  auto rollback{[this, firstPage] {
+    for (std::size_t i{firstPage}; i < mPages.size(); ++i)
+    {
+      SDL_DestroyTexture(mPages[i].texture);
+    }
+    mPages.resize(firstPage);
+  }};
+
+  std::vector<SDL_Point> pageSizes{};
+  for (Uint32 i{}; i < pageCount; ++i)
+  {
+    SDL_Surface* surface{IMG_Load(pagePath(dir, i).c_str())};
+    SDL_Texture* texture{surface != nullptr ? SDL_CreateTextureFromSurface(mRenderer, surface) : nullptr};
+    if (texture != nullptr)
+      pageSizes.push_back({surface->w, surface->h});
+    SDL_DestroySurface(surface);
+    if (texture == nullptr)
+    {
+      RIPSAW_LOG_ERROR(Assets, "Failed loading atlas page %s", pagePath(dir, i).c_str());
+      SDL_CloseIO(io);
+      rollback();
+      return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    mPages.push_back({texture, SkylinePacker{}, true});
+  }
+
+  std::vector<std::pair<std::string, Entry>> entries{};
+  for (Uint32 i{}; i < entryCount and ok; ++i)
+  {
+    Uint32 page{}, x{}, y{}, w{}, h{}, keyLength{};
+    ok = SDL_ReadU32LE(io, &page) and SDL_ReadU32LE(io, &x) and SDL_ReadU32LE(io, &y) and SDL_ReadU32LE(io, &w) and SDL_ReadU32LE(io, &h) and SDL_ReadU32LE(io, &keyLength);
+    // Rectangles have to lie inside their page and keys be of sane length, a corrupt index mustn't turn into huge allocations.
+    ok = ok and page < pageCount and keyLength <= MaxKeyLength;
+    ok = ok and x <= static_cast<Uint32>(pageSizes[page].x) and w <= static_cast<Uint32>(pageSizes[page].x) - x;
+    ok = ok and y <= static_cast<Uint32>(pageSizes[page].y) and h <= static_cast<Uint32>(pageSizes[page].y) - y;
+    if (ok == false)
+      break;
+    std::string key(keyLength, '\0');
+    ok = SDL_ReadIO(io, key.data(), key.size()) == key.size();
+    if (ok == false)
+      break;
+    entries.emplace_back(std::move(key), Entry{firstPage + page, {static_cast<int>(x), static_cast<int>(y), static_cast<int>(w), static_cast<int>(h)}});
+  }
+  SDL_CloseIO(io);
+
+  if (ok == false)
+  {
+    RIPSAW_LOG_ERROR(Assets, "Truncated or corrupt atlas index in %s", dir.c_str());
+    rollback();
+    return false;
+  }
+  for (auto& [key, entry] : entries)
+  {
+    mEntries[key] = entry;
+  }
+  RIPSAW_LOG_INFO(Assets, "Loaded baked atlas %s: %u pages, %u images", dir.c_str(), pageCount, entryCount);
+  return true;
+}
+
+std::size_t TextureAtlas::getPageCount() const
+{
+  return mPages.size();
+}
+
+int TextureAtlas::getPageSize() const
+{
+  return mPageSize;
+}
+
+void TextureAtlas::clear()
+{
+  for (auto& page : mPages)
+  {
+    SDL_DestroyTexture(page.texture);
+  }
+  mPages.clear();
+  mEntries.clear();
+}
+
+bool TextureAtlas::addPage()
+{
+  SDL_Texture* texture{SDL_CreateTexture(mRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, mPageSize, mPageSize)};
+  if (texture == nullptr)
+  {
+    RIPSAW_LOG_ERROR(Assets, "Failed creating atlas page: %s", SDL_GetError());
+    return false;
+  }
+
+  // Texture contents start undefined, padding has to be transparent.
+  std::vector<Uint8> zeros(static_cast<std::size_t>(mPageSize) * static_cast<std::size_t>(mPageSize) * 4);
+  SDL_UpdateTexture(texture, nullptr, zeros.data(), mPageSize * 4);
+  SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+  mPages.push_back({texture, SkylinePacker{mPageSize, mPageSize}, false});
+  RIPSAW_LOG_DEBUG(Assets, "Atlas page %zu created: %d X %d", mPages.size() - 1, mPageSize, mPageSize);
+  return true;
+}
+
+bool TextureAtlas::bake(const std::vector<std::string>& paths, const std::string& dir, int pageSize)
+{
+  struct BakedEntry
+  {
+    std::string key{};
+    Uint32 page{};
+    SDL_Rect rect{};
+  };
+
+  std::vector<SDL_Surface*> pages{};
+  std::vector<SkylinePacker> packers{};
+  std::vector<BakedEntry> entries{};
+  bool ok{true};
+
+  for (const auto& path : paths)
+  {
+    SDL_Surface* loaded{IMG_Load(path.c_str())};
+    if (loaded == nullptr)
+    {
+      RIPSAW_LOG_WARN(Assets, "Bake skipped unreadable image: %s", path.c_str());
+      continue;
+    }
+    SDL_Surface* image{toRGBA32(loaded)};
+    if (image != loaded)
+      SDL_DestroySurface(loaded);
+    if (image == nullptr)
+      continue;
+
+    if (image->w + Padding > pageSize or image->h + Padding > pageSize)
+    {
+      RIPSAW_LOG_WARN(Assets, "Bake skipped image larger than page: %s", path.c_str());
+      SDL_DestroySurface(image);
+      continue;
+    }
+
+    SDL_Rect rect{};
+    std::size_t page{};
+    for (page = 0; page < packers.size(); ++page)
+    {
+      if (packers[page].insert(image->w + Padding, image->h + Padding, rect))
+        break;
+    }
+    if (page == packers.size())
+    {
+      SkylinePacker packer{pageSize, pageSize};
+      SDL_Surface* surface{SDL_CreateSurface(pageSize, pageSize, SDL_PIXELFORMAT_RGBA32)};
+      if (surface == nullptr or packer.insert(image->w + Padding, image->h + Padding, rect) == false)
+      {
+        RIPSAW_LOG_WARN(Assets, "Bake skipped image, no page for it: %s (%s)", path.c_str(), SDL_GetError());
+        SDL_DestroySurface(surface);
+        SDL_DestroySurface(image);
+        continue;
+      }
+      packers.push_back(std::move(packer));
+      pages.push_back(surface);
+    }
+
+    rect.w = image->w;
+    rect.h = image->h;
+    SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(image, nullptr, pages[page], &rect);
+    SDL_DestroySurface(image);
+    entries.push_back({path, static_cast<Uint32>(page), rect});
+  }
+
+  for (std::size_t i{}; i < pages.size(); ++i)
+  {
+    ok = ok and IMG_SavePNG(pages[i], pagePath(dir, i).c_str());
+    SDL_DestroySurface(pages[i]);
+  }
+
+  SDL_IOStream* io{SDL_IOFromFile(indexPath(dir).c_str(), "wb")};
+  if (io == nullptr)
+  {
+    RIPSAW_LOG_ERROR(Assets, "Failed writing atlas index in %s: %s", dir.c_str(), SDL_GetError());
+    return false;
+  }
+  ok = ok and SDL_WriteU32LE(io, AtlasMagic) and SDL_WriteU32LE(io, AtlasVersion);
+  ok = ok and SDL_WriteU32LE(io, static_cast<Uint32>(pages.size())) and SDL_WriteU32LE(io, static_cast<Uint32>(entries.size()));
+  for (const auto& entry : entries)
+  {
+    ok = ok and SDL_WriteU32LE(io, entry.page);
+    ok = ok and SDL_WriteU32LE(io, static_cast<Uint32>(entry.rect.x)) and SDL_WriteU32LE(io, static_cast<Uint32>(entry.rect.y));
+    ok = ok and SDL_WriteU32LE(io, static_cast<Uint32>(entry.rect.w)) and SDL_WriteU32LE(io, static_cast<Uint32>(entry.rect.h));
+    ok = ok and SDL_WriteU32LE(io, static_cast<Uint32>(entry.key.size()));
+    ok = ok and SDL_WriteIO(io, entry.key.data(), entry.key.size()) == entry.key.size();
+  }
+  ok = SDL_CloseIO(io) and ok;
+
+  RIPSAW_LOG_INFO(Assets, "Baked %zu images into %zu atlas pages in %s", entries.size(), pages.size(), dir.c_str());
+  return ok;
+}
+
+}
@@ -0,0 +1,223 @@
+#include "RipsawEngine/2D/Render/TextureCache.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <SDL3_image/SDL_image.h>
+
+namespace RipsawEngine
+{
+
+TextureCache::~TextureCache()
+{
+  this->clear();
+}
+
+void TextureCache::setRenderer(SDL_Renderer* renderer)
+{
+  mRenderer = renderer;
+  mAtlas.setRenderer(renderer);
+}
+
+TextureRegion TextureCache::acquire(const std::string& path)
+{
+  auto it{mEntries.find(path)};
+  if (it != mEntries.end())
+  {
+    Entry& entry{it->second};
+    if (entry.refs == 0 and entry.pins == 0 and entry.bytes != 0)
+    {
+      mUnused.erase(entry.unusedIt);
+    }
+    ++entry.refs;
+    ++mStats.hits;
+    return entry.region;
+  }
+
+  // Images baked offline are already in the atlas and never need decoding.
+  TextureRegion region{};
+  if (mAtlas.find(path, region))
+  {
+    mEntries.emplace(path, Entry{region, 0, 1, 0, mUnused.end()});
+    ++mStats.atlasHits;
+    return region;
+  }
+
+  ++mStats.misses;
+
+  SDL_Surface* surface{IMG_Load(path.c_str())};
+  if (surface == nullptr)
+  {
+    RIPSAW_LOG_ERROR(Assets, "Failed to load image: %s", path.c_str());
+    return {};
+  }
+
+  region = this->upload(path, surface, 1, 0);
+  SDL_DestroySurface(surface);
+  return region;
+}
+
+bool TextureCache::insert(const std::string& path, SDL_Surface* surface, std::size_t pins)
+{
+  auto it{mEntries.find(path)};
+  if (it != mEntries.end())
+  {
+    // Pin an unreferenced texture too, else it could be evicted before the claims acquire it.
+    Entry& entry{it->second};
+    if (pins != 0 and entry.refs == 0 and entry.pins == 0 and entry.bytes != 0)
+    {
+      mUnused.erase(entry.unusedIt);
+      entry.unusedIt = mUnused.end();
+    }
+    entry.pins += pins;
+    return true;
+  }
+  if (this->contains(path))
+    return true;
+  if (surface == nullptr)
+    return false;
+
+  return this->upload(path, surface, 0, pins).texture != nullptr;
+}
+
+bool TextureCache::contains(const std::string& path) const
+{
+  TextureRegion region{};
+  return mEntries.contains(path) or mAtlas.find(path, region);
+}
+
+void TextureCache::release(const std::string& path)
+{
+  auto it{mEntries.find(path)};
+  if (it == mEntries.end() or it->second.refs == 0)
+    return;
+
+  Entry& entry{it->second};
+  --entry.refs;
+  // Atlas images can't be evicted individually, only standalone textures go to the unused list.
+  if (entry.refs == 0 and entry.pins == 0 and entry.bytes != 0)
+  {
+    entry.unusedIt = mUnused.insert(mUnused.end(), path);
+    this->trim();
+  }
+}
+
+void TextureCache::pin(const std::string& path)
+{
+  auto it{mEntries.find(path)};
+  if (it == mEntries.end())
+    return;
+
+  Entry& entry{it->second};
+  if (entry.refs == 0 and entry.pins == 0 and entry.bytes != 0)
+  {
+    mUnused.erase(entry.unusedIt);
+    entry.unusedIt = mUnused.end();
+  }
+  ++entry.pins;
+}
+
+void TextureCache::unpin(const std::string& path)
+{
+  auto it{mEntries.find(path)};
+  if (it == mEntries.end() or it->second.pins == 0)
+    return;
+
+  Entry& entry{it->second};
+  --entry.pins;
+  if (entry.refs == 0 and entry.pins == 0 and entry.bytes != 0)
+  {
+    entry.unusedIt = mUnused.insert(mUnused.end(), path);
+    this->trim();
+  }
+}
+
+void TextureCache::setAtlasEnabled(bool enabled)
+{
+  mIsAtlasEnabled = enabled;
+}
+
+bool TextureCache::loadAtlas(const std::string& dir)
+{
+  bool loaded{mAtlas.load(dir)};
+  mStats.atlasPages = mAtlas.getPageCount();
+  return loaded;
+}
+
+TextureAtlas& TextureCache::getAtlas()
+{
+  return mAtlas;
+}
+
+void TextureCache::setBudget(std::size_t bytes)
+{
+  mStats.budget = bytes;
+  this->trim();
+}
+
+const TextureCacheStats& TextureCache::getStats() const
+{
+  return mStats;
+}
+
+void TextureCache::clear()
+{
+  for (auto& [path, entry] : mEntries)
+  {
+    if (entry.bytes != 0)
+      SDL_DestroyTexture(entry.region.texture);
+  }
+  mEntries.clear();
+  mUnused.clear();
+  mAtlas.clear();
+  mStats.textures = 0;
+  mStats.bytes = 0;
+  mStats.atlasPages = 0;
+}
+
+TextureRegion TextureCache::upload(const std::string& path, SDL_Surface* surface, std::size_t refs, std::size_t pins)
+{
+  Entry entry{{}, 0, refs, pins, mUnused.end()};
+  if (mIsAtlasEnabled and mAtlas.insert(path, surface, entry.region))
+  {
+    mEntries.emplace(path, entry);
+    mStats.atlasPages = mAtlas.getPageCount();
+    RIPSAW_LOG_DEBUG(Assets, "Texture cached in atlas: %s", path.c_str());
+    return entry.region;
+  }
+
+  SDL_Texture* texture{SDL_CreateTextureFromSurface(mRenderer, surface)};
+  if (texture == nullptr)
+  {
+    RIPSAW_LOG_ERROR(Assets, "Failed to create texture: %s", path.c_str());
+    return {};
+  }
+
+  entry.bytes = static_cast<std::size_t>(surface->w) * static_cast<std::size_t>(surface->h) * 4;
+  entry.region = {texture, {0, 0, static_cast<float>(surface->w), static_cast<float>(surface->h)}};
+  if (refs == 0 and pins == 0)
+    entry.unusedIt = mUnused.insert(mUnused.end(), path);
+  mEntries.emplace(path, entry);
+  ++mStats.textures;
+  mStats.bytes += entry.bytes;
+  RIPSAW_LOG_DEBUG(Assets, "Texture cached: %s (%zu bytes, %zu bytes resident)", path.c_str(), entry.bytes, mStats.bytes);
+
+  this->trim();
+  return entry.region;
+}
+
+void TextureCache::trim()
+{
+  while (mStats.bytes > mStats.budget and !mUnused.empty())
+  {
+    auto it{mEntries.find(mUnused.front())};
+    mUnused.pop_front();
+
+    RIPSAW_LOG_DEBUG(Assets, "Texture evicted: %s (%zu bytes)", it->first.c_str(), it->second.bytes);
+    mStats.bytes -= it->second.bytes;
+    --mStats.textures;
+    ++mStats.evictions;
+    SDL_DestroyTexture(it->second.region.texture);
+    mEntries.erase(it);
+  }
+}
+
+}
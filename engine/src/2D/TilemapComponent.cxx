@@ -0,0 +1,72 @@
+#include "RipsawEngine/2D/Core/Engine.hxx"
+#include "RipsawEngine/2D/Scene/Actor.hxx"
+#include "RipsawEngine/2D/Scene/TilemapComponent.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+namespace RipsawEngine
+{
+
+TilemapComponent::TilemapComponent(Actor* actor, const TilemapConfig& config)
+  : Component{actor},
+    mTilemapSystem{&actor->getEngine()->getTilemapSystem()},
+    mImgFile{config.imgfile}
+{
+  mOwner->registerComponent(TypeId, this);
+
+  TextureRegion region{};
+  if (mImgFile.empty() == false)
+  {
+    region = mOwner->getEngine()->getTextureCache().acquire(mImgFile);
+    mIsTextureAcquired = region.texture != nullptr;
+    if (mIsTextureAcquired == false)
+      RIPSAW_LOG_WARN(Scene, "Tileset %s couldn't be loaded, tiles are drawn as squares", mImgFile.c_str());
+  }
+  mTilemap = mTilemapSystem->create(config, region, mOwner);
+
+  RIPSAW_LOG_DEBUG(Scene, "Component added: TilemapComponent: %p to Actor: %p, %d x %d tiles", static_cast<void*>(this), static_cast<void*>(mOwner), config.mapSize.x, config.mapSize.y);
+}
+
+TilemapComponent::~TilemapComponent()
+{
+  mOwner->deregisterComponent(TypeId);
+  mTilemapSystem->destroy(mTilemap);
+  if (mIsTextureAcquired)
+    mOwner->getEngine()->getTextureCache().release(mImgFile);
+}
+
+bool TilemapComponent::isComponentValid() const
+{
+  return mTilemapSystem->isValid(mTilemap);
+}
+
+bool TilemapComponent::setTile(const glm::ivec2& cell, TileId tile)
+{
+  return mTilemapSystem->setTile(mTilemap, cell, tile);
+}
+
+TileId TilemapComponent::getTile(const glm::ivec2& cell) const
+{
+  return mTilemapSystem->getTile(mTilemap, cell);
+}
+
+bool TilemapComponent::fill(TileId tile)
+{
+  return mTilemapSystem->fill(mTilemap, tile);
+}
+
+glm::ivec2 TilemapComponent::getMapSize() const
+{
+  return mTilemapSystem->getMapSize(mTilemap);
+}
+
+glm::vec2 TilemapComponent::getTileSize() const
+{
+  return mTilemapSystem->getTileSize(mTilemap);
+}
+
+glm::ivec2 TilemapComponent::worldToCell(const glm::vec2& pos) const
+{
+  return mTilemapSystem->worldToCell(mTilemap, pos);
+}
+
+}
@@ -0,0 +1,297 @@
+#include "RipsawEngine/2D/Render/RenderQueue.hxx"
+#include "RipsawEngine/2D/Scene/Actor.hxx"
+#include "RipsawEngine/2D/Scene/TransformComponent.hxx"
+#include "RipsawEngine/2D/Systems/TilemapSystem.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace RipsawEngine
+{
+
+namespace
+{
+
+/// Returns top left corner of tilemap owned by actor, in world coordinates.
+/// @param actor Actor owning the tilemap.
+glm::vec2 originOf(const Actor* actor)
+{
+  const TransformComponent* transform{actor->getTransformComponent()};
+  return transform != nullptr ? transform->getPosition() : glm::vec2{};
+}
+
+/// Returns range of chunk indices along one axis overlapping [lo, hi], empty if first > last.
+/// @param lo Lower end relative to the map origin.
+/// @param hi Upper end relative to the map origin.
+/// @param extent Chunk extent in world units.
+/// @param count Number of chunks.
+std::pair<int, int> chunkRange(float lo, float hi, float extent, int count)
+{
+  float last{static_cast<float>(count - 1)};
+  if (count == 0 or hi < 0.f or lo > static_cast<float>(count) * extent)
+    return {1, 0};
+  // Clamped as floats first, since unbounded views make infinite bounds.
+  return {static_cast<int>(std::clamp(std::floor(lo / extent), 0.f, last)), static_cast<int>(std::clamp(std::floor(hi / extent), 0.f, last))};
+}
+
+}
+
+Handle TilemapSystem::create(const TilemapConfig& config, const TextureRegion& region, const Actor* actor)
+{
+  Handle handle{mTable.allocate()};
+  Tilemap map{};
+  map.config = config;
+  map.config.tileSize = glm::max(config.tileSize, glm::ivec2{1});
+  map.config.mapSize = glm::max(config.mapSize, glm::ivec2{0});
+  map.config.chunkSize = std::max(config.chunkSize, 1);
+  map.actor = actor;
+  map.texture = region.texture;
+  map.src = region.rect;
+  if (map.texture != nullptr)
+  {
+    SDL_GetTextureSize(map.texture, &map.textureSize.x, &map.textureSize.y);
+    map.columns = static_cast<int>(map.src.w) / map.config.tileSize.x;
+    map.tileCount = map.columns * (static_cast<int>(map.src.h) / map.config.tileSize.y);
+    if (map.tileCount == 0)
+      RIPSAW_LOG_WARN(Systems, "Tileset %s is smaller than one tile", config.imgfile.c_str());
+  }
+  else
+  {
+    // Untextured tiles all look alike, so every id is accepted.
+    map.columns = 1;
+    map.tileCount = std::numeric_limits<TileId>::max();
+  }
+  map.key = makeSortKey(config.layer, config.depth);
+
+  int size{map.config.chunkSize};
+  map.chunkCount = (map.config.mapSize + size - 1) / size;
+  std::size_t chunks{static_cast<std::size_t>(map.chunkCount.x) * static_cast<std::size_t>(map.chunkCount.y)};
+  map.cells.assign(chunks * static_cast<std::size_t>(size * size), EmptyTile);
+  map.chunks.resize(chunks);
+  mTilemaps.push_back(std::move(map));
+  return handle;
+}
+
+void TilemapSystem::destroy(Handle handle)
+{
+  if (mTable.isValid(handle) == false)
+    return;
+
+  HandleTable::Removal removal{mTable.release(handle)};
+  if (removal.index != removal.last)
+    mTilemaps[removal.index] = std::move(mTilemaps[removal.last]);
+  mTilemaps.pop_back();
+}
+
+bool TilemapSystem::isValid(Handle handle) const
+{
+  return mTable.isValid(handle);
+}
+
+bool TilemapSystem::setTile(Handle handle, const glm::ivec2& cell, TileId tile)
+{
+  Tilemap& map{mTilemaps[mTable.indexOf(handle)]};
+  const glm::ivec2& size{map.config.mapSize};
+  if (cell.x < 0 or cell.y < 0 or cell.x >= size.x or cell.y >= size.y)
+    return false;
+  if (tile > map.tileCount)
+  {
+    RIPSAW_LOG_ERROR(Systems, "Tile %d is not in tileset %s of %d tiles", static_cast<int>(tile), map.config.imgfile.c_str(), map.tileCount);
+    return false;
+  }
+
+  TileId& current{map.cells[indexOf(map, cell)]};
+  if (current == tile)
+    return true;
+  current = tile;
+  int chunkSize{map.config.chunkSize};
+  map.chunks[static_cast<std::size_t>((cell.y / chunkSize) * map.chunkCount.x + cell.x / chunkSize)].isDirty = true;
+  return true;
+}
+
+TileId TilemapSystem::getTile(Handle handle, const glm::ivec2& cell) const
+{
+  const Tilemap& map{mTilemaps[mTable.indexOf(handle)]};
+  const glm::ivec2& size{map.config.mapSize};
+  if (cell.x < 0 or cell.y < 0 or cell.x >= size.x or cell.y >= size.y)
+    return EmptyTile;
+  return map.cells[indexOf(map, cell)];
+}
+
+bool TilemapSystem::fill(Handle handle, TileId tile)
+{
+  Tilemap& map{mTilemaps[mTable.indexOf(handle)]};
+  if (tile > map.tileCount)
+  {
+    RIPSAW_LOG_ERROR(Systems, "Tile %d is not in tileset %s of %d tiles", static_cast<int>(tile), map.config.imgfile.c_str(), map.tileCount);
+    return false;
+  }
+
+  // Cells of edge chunks beyond the map stay empty.
+  for (int y{}; y < map.config.mapSize.y; ++y)
+  {
+    for (int x{}; x < map.config.mapSize.x; ++x)
+    {
+      map.cells[indexOf(map, {x, y})] = tile;
+    }
+  }
+  for (auto& chunk : map.chunks)
+  {
+    chunk.isDirty = true;
+  }
+  return true;
+}
+
+glm::ivec2 TilemapSystem::getMapSize(Handle handle) const
+{
+  return mTilemaps[mTable.indexOf(handle)].config.mapSize;
+}
+
+glm::vec2 TilemapSystem::getTileSize(Handle handle) const
+{
+  const TilemapConfig& config{mTilemaps[mTable.indexOf(handle)].config};
+  return glm::vec2{config.tileSize} * config.scale;
+}
+
+glm::ivec2 TilemapSystem::worldToCell(Handle handle, const glm::vec2& pos) const
+{
+  const Tilemap& map{mTilemaps[mTable.indexOf(handle)]};
+  glm::vec2 cell{glm::floor((pos - originOf(map.actor)) / (glm::vec2{map.config.tileSize} * map.config.scale))};
+  return glm::ivec2{cell};
+}
+
+void TilemapSystem::extract(RenderPacket& packet, JobSystem& jobs)
+{
+  ++mExtraction;
+  mPicked.clear();
+  mDirty.clear();
+  for (std::size_t index{}; index < mTilemaps.size(); ++index)
+  {
+    glm::vec2 origin{originOf(mTilemaps[index].actor)};
+    if (packet.isCulling == false)
+    {
+      float inf{std::numeric_limits<float>::infinity()};
+      this->pick(index, {{-inf, -inf}, {inf, inf}});
+      continue;
+    }
+    for (const auto& camera : packet.cameras)
+    {
+      Aabb view{camera.getViewBounds()};
+      this->pick(index, {view.min - origin, view.max - origin});
+    }
+  }
+
+  // Chunks come into view a few at a time, except on the first frame or after fill().
+  jobs.parallelFor(mDirty.size(), [this](std::size_t begin, std::size_t end) {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        build(mTilemaps[mDirty[i].first], mDirty[i].second);
+      }
+  }, 1);
+  mRebuilds += mDirty.size();
+
+  for (const auto& [index, chunkIndex] : mPicked)
+  {
+    const Tilemap& map{mTilemaps[index]};
+    const std::vector<SDL_Vertex>& vertices{map.chunks[chunkIndex].vertices};
+    if (vertices.empty())
+      continue;
+
+    glm::vec2 origin{originOf(map.actor)};
+    glm::vec2 extent{glm::vec2{map.config.tileSize} * map.config.scale * static_cast<float>(map.config.chunkSize)};
+    glm::vec2 corner{origin + extent * glm::vec2{static_cast<float>(chunkIndex % static_cast<std::size_t>(map.chunkCount.x)), static_cast<float>(chunkIndex / static_cast<std::size_t>(map.chunkCount.x))}};
+    packet.tileBatches.push_back({map.texture, map.actor->getHandle(), {corner, corner + extent}, origin, map.key, packet.tileVertices.size(), vertices.size() / 4});
+    packet.tileVertices.insert(packet.tileVertices.end(), vertices.begin(), vertices.end());
+  }
+  // Ties go by position in the packet, so drawing order is stable.
+  std::sort(packet.tileBatches.begin(), packet.tileBatches.end(), [](const TileBatch& a, const TileBatch& b) {
+      return a.key != b.key ? a.key < b.key : a.first < b.first;
+  });
+}
+
+std::size_t TilemapSystem::getRebuildCount() const
+{
+  return mRebuilds;
+}
+
+std::size_t TilemapSystem::size() const
+{
+  return mTilemaps.size();
+}
+
+std::size_t TilemapSystem::indexOf(const Tilemap& map, const glm::ivec2& cell)
+{
+  int size{map.config.chunkSize};
+  std::size_t chunk{static_cast<std::size_t>((cell.y / size) * map.chunkCount.x + cell.x / size)};
+  return chunk * static_cast<std::size_t>(size * size) + static_cast<std::size_t>((cell.y % size) * size + cell.x % size);
+}
+
+void TilemapSystem::pick(std::size_t map, const Aabb& view)
+{
+  Tilemap& tilemap{mTilemaps[map]};
+  glm::vec2 extent{glm::vec2{tilemap.config.tileSize} * tilemap.config.scale * static_cast<float>(tilemap.config.chunkSize)};
+  auto [x0, x1]{chunkRange(view.min.x, view.max.x, extent.x, tilemap.chunkCount.x)};
+  auto [y0, y1]{chunkRange(view.min.y, view.max.y, extent.y, tilemap.chunkCount.y)};
+  for (int y{y0}; y <= y1; ++y)
+  {
+    for (int x{x0}; x <= x1; ++x)
+    {
+      std::size_t index{static_cast<std::size_t>(y * tilemap.chunkCount.x + x)};
+      Chunk& chunk{tilemap.chunks[index]};
+      if (chunk.extraction == mExtraction)
+        continue;
+      chunk.extraction = mExtraction;
+      mPicked.push_back({map, index});
+      if (chunk.isDirty)
+        mDirty.push_back({map, index});
+    }
+  }
+}
+
+void TilemapSystem::build(Tilemap& map, std::size_t index)
+{
+  Chunk& chunk{map.chunks[index]};
+  chunk.vertices.clear();
+  chunk.isDirty = false;
+
+  const TilemapConfig& config{map.config};
+  int size{config.chunkSize};
+  glm::vec2 tile{glm::vec2{config.tileSize} * config.scale};
+  glm::ivec2 firstCell{static_cast<int>(index % static_cast<std::size_t>(map.chunkCount.x)) * size, static_cast<int>(index / static_cast<std::size_t>(map.chunkCount.x)) * size};
+  const TileId* cells{map.cells.data() + index * static_cast<std::size_t>(size * size)};
+  SDL_FColor white{1.f, 1.f, 1.f, 1.f};
+  for (int y{}; y < size; ++y)
+  {
+    for (int x{}; x < size; ++x)
+    {
+      TileId id{cells[y * size + x]};
+      if (id == EmptyTile)
+        continue;
+
+      float u0{}, v0{}, u1{}, v1{};
+      if (map.texture != nullptr)
+      {
+        int cell{id - 1};
+        float left{map.src.x + static_cast<float>(cell % map.columns * config.tileSize.x)};
+        float top{map.src.y + static_cast<float>(cell / map.columns * config.tileSize.y)};
+        u0 = left / map.textureSize.x;
+        v0 = top / map.textureSize.y;
+        u1 = (left + static_cast<float>(config.tileSize.x)) / map.textureSize.x;
+        v1 = (top + static_cast<float>(config.tileSize.y)) / map.textureSize.y;
+      }
+      // Neighbours compute shared corners from the same cell coordinates, so they meet without seams.
+      float x0{static_cast<float>(firstCell.x + x) * tile.x};
+      float y0{static_cast<float>(firstCell.y + y) * tile.y};
+      float x1{static_cast<float>(firstCell.x + x + 1) * tile.x};
+      float y1{static_cast<float>(firstCell.y + y + 1) * tile.y};
+      chunk.vertices.push_back({{x0, y0}, white, {u0, v0}});
+      chunk.vertices.push_back({{x1, y0}, white, {u1, v0}});
+      chunk.vertices.push_back({{x1, y1}, white, {u1, v1}});
+      chunk.vertices.push_back({{x0, y1}, white, {u0, v1}});
+    }
+  }
+}
+
+}
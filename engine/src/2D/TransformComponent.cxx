@@ -1,33 +1,64 @@
+#include "RipsawEngine/2D/Core/Engine.hxx"
 #include "RipsawEngine/2D/Scene/Actor.hxx"
 #include "RipsawEngine/2D/Scene/TransformComponent.hxx"
+#include "RipsawEngine/2D/Systems/TransformSystem.hxx"
+#include "RipsawEngine/Common/Log.hxx"
 
 #include <stdexcept>
 
 namespace RipsawEngine
 {
 
+namespace
+{
+
+/// Pool every TransformComponent is allocated from.
+Pool<TransformComponent>& transformPool()
+{
+  static Pool<TransformComponent> pool{};
+  return pool;
+}
+
+}
+
+void* TransformComponent::operator new(std::size_t size)
+{
+  return transformPool().allocate(size);
+}
+
+void TransformComponent::operator delete(void* ptr, std::size_t size)
+{
+  transformPool().deallocate(ptr, size);
+}
+
+const PoolStats& TransformComponent::getPoolStats()
+{
+  return transformPool().getStats();
+}
+
 TransformComponent::TransformComponent(Actor* actor, const glm::vec2& pos, const glm::vec2& vel)
   : Component{actor},
-    mPos{pos},
-    mVel{vel}
+    mSystem{&actor->getEngine()->getTransformSystem()}
 {
-  mOwner->helperRegisterComponent("TransformComponent");
+  mOwner->registerComponent(TypeId, this);
+  mHandle = mSystem->create(pos, vel);
 
   mOwner->setTransformComponent(this);
 
   if (this->isComponentValid())
   {
-    SDL_Log("[INFO] Component added: TransformComponent: %p to Actor: %p", static_cast<void*>(this), static_cast<void*>(mOwner));
+    RIPSAW_LOG_DEBUG(Scene, "Component added: TransformComponent: %p to Actor: %p", static_cast<void*>(this), static_cast<void*>(mOwner));
   }
   else
   {
-    SDL_Log("[ERROR] TransformComponent construction FAILED");
+    RIPSAW_LOG_ERROR(Scene, "TransformComponent construction FAILED");
   }
 }
 
 TransformComponent::~TransformComponent()
 {
-  mOwner->deregisterComponent("TransformComponent");
+  mOwner->deregisterComponent(TypeId);
+  mSystem->destroy(mHandle);
 }
 
 bool TransformComponent::isComponentValid() const
@@ -35,30 +66,44 @@ bool TransformComponent::isComponentValid() const
   return true;
 }
 
-void TransformComponent::update(double dt)
+glm::vec2 TransformComponent::getPosition() const
 {
-  mPos.x += mVel.x * static_cast<float>(dt);
-  mPos.y += mVel.y * static_cast<float>(dt);
+  return mSystem->getPosition(mHandle);
 }
 
-glm::vec2 TransformComponent::getPosition() const
+void TransformComponent::setPosition(const glm::vec2& pos)
 {
-  return mPos;
+  mSystem->setPosition(mHandle, pos);
 }
 
-void TransformComponent::setPosition(const glm::vec2& pos)
+void TransformComponent::teleport(const glm::vec2& pos)
+{
+  mSystem->teleport(mHandle, pos);
+}
+
+glm::vec2 TransformComponent::getRenderPosition() const
 {
-  mPos = pos;
+  return mSystem->getRenderPosition(mHandle);
 }
 
 glm::vec2 TransformComponent::getVelocity() const
 {
-  return mVel;
+  return mSystem->getVelocity(mHandle);
 }
 
 void TransformComponent::setVelocity(const glm::vec2& vel)
 {
-  mVel = vel;
+  mSystem->setVelocity(mHandle, vel);
+}
+
+void TransformComponent::setBounds(const glm::vec2& size)
+{
+  mSystem->setBounds(mHandle, size, mOwner->getHandle());
+}
+
+void TransformComponent::clearBounds()
+{
+  mSystem->clearBounds(mHandle);
 }
 
 }
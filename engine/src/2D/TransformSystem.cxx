@@ -0,0 +1,246 @@
+#include "RipsawEngine/2D/Core/Simd.hxx"
+#include "RipsawEngine/2D/Systems/TransformSystem.hxx"
+
+#include <algorithm>
+
+namespace RipsawEngine
+{
+
+namespace
+{
+
+/// Entry is listed in mMovers.
+constexpr std::uint8_t FlagMover{1};
+/// Entry is listed in mDirty.
+constexpr std::uint8_t FlagDirty{2};
+
+}
+
+Handle TransformSystem::create(const glm::vec2& pos, const glm::vec2& vel)
+{
+  Handle handle{mTable.allocate()};
+  mPosX.push_back(pos.x);
+  mPosY.push_back(pos.y);
+  mVelX.push_back(vel.x);
+  mVelY.push_back(vel.y);
+  mPrevX.push_back(pos.x);
+  mPrevY.push_back(pos.y);
+  mHalfW.push_back(0.f);
+  mHalfH.push_back(0.f);
+  mProxies.emplace_back();
+  mFlags.push_back(0);
+  return handle;
+}
+
+void TransformSystem::destroy(Handle handle)
+{
+  if (mTable.isValid(handle) == false)
+    return;
+
+  if (mSpatialHash != nullptr)
+    mSpatialHash->remove(mProxies[mTable.indexOf(handle)]);
+
+  // Stale handles left in mMovers and mDirty are dropped by the next sync.
+  HandleTable::Removal removal{mTable.release(handle)};
+  for (auto* buffer : {&mPosX, &mPosY, &mVelX, &mVelY, &mPrevX, &mPrevY, &mHalfW, &mHalfH})
+  {
+    (*buffer)[removal.index] = (*buffer)[removal.last];
+    buffer->pop_back();
+  }
+  mProxies[removal.index] = mProxies[removal.last];
+  mProxies.pop_back();
+  mFlags[removal.index] = mFlags[removal.last];
+  mFlags.pop_back();
+}
+
+bool TransformSystem::isValid(Handle handle) const
+{
+  return mTable.isValid(handle);
+}
+
+glm::vec2 TransformSystem::getPosition(Handle handle) const
+{
+  std::size_t i{mTable.indexOf(handle)};
+  return {mPosX[i], mPosY[i]};
+}
+
+void TransformSystem::setPosition(Handle handle, const glm::vec2& pos)
+{
+  std::size_t i{mTable.indexOf(handle)};
+  mPosX[i] = pos.x;
+  mPosY[i] = pos.y;
+  if (mProxies[i].isNull() == false and (mFlags[i] & FlagDirty) == 0)
+    this->track(mDirty, i, handle, FlagDirty);
+}
+
+void TransformSystem::teleport(Handle handle, const glm::vec2& pos)
+{
+  std::size_t i{mTable.indexOf(handle)};
+  mPosX[i] = mPrevX[i] = pos.x;
+  mPosY[i] = mPrevY[i] = pos.y;
+  if (mProxies[i].isNull() == false and (mFlags[i] & FlagDirty) == 0)
+    this->track(mDirty, i, handle, FlagDirty);
+}
+
+glm::vec2 TransformSystem::getRenderPosition(Handle handle) const
+{
+  std::size_t i{mTable.indexOf(handle)};
+  if (mAlpha >= 1.f)
+    return {mPosX[i], mPosY[i]};
+  return
+  {
+    mPrevX[i] + (mPosX[i] - mPrevX[i]) * mAlpha,
+    mPrevY[i] + (mPosY[i] - mPrevY[i]) * mAlpha
+  };
+}
+
+glm::vec2 TransformSystem::getVelocity(Handle handle) const
+{
+  std::size_t i{mTable.indexOf(handle)};
+  return {mVelX[i], mVelY[i]};
+}
+
+void TransformSystem::setVelocity(Handle handle, const glm::vec2& vel)
+{
+  std::size_t i{mTable.indexOf(handle)};
+  mVelX[i] = vel.x;
+  mVelY[i] = vel.y;
+  if (mProxies[i].isNull() == false and (mFlags[i] & FlagMover) == 0 and (vel.x != 0.f or vel.y != 0.f))
+    this->track(mMovers, i, handle, FlagMover);
+}
+
+void TransformSystem::integrate(float dt)
+{
+  Simd::mulAdd(mPosX.data(), mVelX.data(), dt, mPosX.size());
+  Simd::mulAdd(mPosY.data(), mVelY.data(), dt, mPosY.size());
+}
+
+void TransformSystem::integrateScalar(float dt)
+{
+  Simd::mulAddScalar(mPosX.data(), mVelX.data(), dt, mPosX.size());
+  Simd::mulAddScalar(mPosY.data(), mVelY.data(), dt, mPosY.size());
+}
+
+void TransformSystem::setSpatialHash(SpatialHash* hash)
+{
+  mSpatialHash = hash;
+}
+
+void TransformSystem::setBounds(Handle handle, const glm::vec2& size, Handle userData)
+{
+  if (mSpatialHash == nullptr or mTable.isValid(handle) == false)
+    return;
+
+  std::size_t i{mTable.indexOf(handle)};
+  mHalfW[i] = size.x / 2.f;
+  mHalfH[i] = size.y / 2.f;
+  if (mProxies[i].isNull())
+    mProxies[i] = mSpatialHash->insert({{mPosX[i] - mHalfW[i], mPosY[i] - mHalfH[i]}, {mPosX[i] + mHalfW[i], mPosY[i] + mHalfH[i]}}, userData);
+  else
+    this->updateProxy(i);
+
+  if ((mFlags[i] & FlagMover) == 0 and (mVelX[i] != 0.f or mVelY[i] != 0.f))
+  {
+    mFlags[i] |= FlagMover;
+    mMovers.push_back(handle);
+  }
+}
+
+void TransformSystem::clearBounds(Handle handle)
+{
+  if (mSpatialHash == nullptr or mTable.isValid(handle) == false)
+    return;
+
+  std::size_t i{mTable.indexOf(handle)};
+  mSpatialHash->remove(mProxies[i]);
+  mProxies[i] = {};
+}
+
+void TransformSystem::syncSpatialHash()
+{
+  if (mSpatialHash == nullptr)
+    return;
+
+  for (std::size_t k{}; k < mMovers.size();)
+  {
+    Handle handle{mMovers[k]};
+    bool isValid{mTable.isValid(handle)};
+    std::size_t i{isValid ? mTable.indexOf(handle) : 0};
+    if (isValid == false or mProxies[i].isNull() or (mVelX[i] == 0.f and mVelY[i] == 0.f))
+    {
+      // Stopped, lost its bounds, or gone: stop tracking it.
+      if (isValid)
+        mFlags[i] &= static_cast<std::uint8_t>(~FlagMover);
+      mMovers[k] = mMovers.back();
+      mMovers.pop_back();
+      continue;
+    }
+    this->updateProxy(i);
+    ++k;
+  }
+
+  this->syncDirtyBounds();
+}
+
+void TransformSystem::syncDirtyBounds()
+{
+  if (mSpatialHash == nullptr)
+    return;
+
+  for (Handle handle : mDirty)
+  {
+    if (mTable.isValid(handle) == false)
+      continue;
+    std::size_t i{mTable.indexOf(handle)};
+    mFlags[i] &= static_cast<std::uint8_t>(~FlagDirty);
+    if (mProxies[i].isNull() == false)
+      this->updateProxy(i);
+  }
+  mDirty.clear();
+}
+
+void TransformSystem::track(std::vector<Handle>& list, std::size_t index, Handle handle, std::uint8_t flag)
+{
+  // Actors updated in parallel move their own entries only, so flags don't race, but the lists are shared.
+  std::scoped_lock lock{mTrackingMutex};
+  mFlags[index] |= flag;
+  list.push_back(handle);
+}
+
+void TransformSystem::updateProxy(std::size_t index)
+{
+  mSpatialHash->update(mProxies[index], {{mPosX[index] - mHalfW[index], mPosY[index] - mHalfH[index]}, {mPosX[index] + mHalfW[index], mPosY[index] + mHalfH[index]}});
+}
+
+void TransformSystem::snapshot()
+{
+  std::copy(mPosX.begin(), mPosX.end(), mPrevX.begin());
+  std::copy(mPosY.begin(), mPosY.end(), mPrevY.begin());
+}
+
+void TransformSystem::setInterpolation(float alpha)
+{
+  mAlpha = alpha;
+}
+
+std::size_t TransformSystem::size() const
+{
+  return mPosX.size();
+}
+
+void TransformSystem::reserve(std::size_t capacity)
+{
+  mTable.reserve(capacity);
+  mPosX.reserve(capacity);
+  mPosY.reserve(capacity);
+  mVelX.reserve(capacity);
+  mVelY.reserve(capacity);
+  mPrevX.reserve(capacity);
+  mPrevY.reserve(capacity);
+  mHalfW.reserve(capacity);
+  mHalfH.reserve(capacity);
+  mProxies.reserve(capacity);
+  mFlags.reserve(capacity);
+}
+
+}
@@ -1,10 +1,12 @@
 #include "RipsawEngine/2D/Core/Engine.hxx"
+#include "RipsawEngine/2D/Core/Profiler.hxx"
 
 namespace RipsawEngine
 {
 
 void Engine::processInput()
 {
+  RIPSAW_PROFILE_ZONE("processInput");
   SDL_Event event;
   SDL_zero(event);
 
@@ -20,6 +22,19 @@ void Engine::processInput()
         mIsRunning = false;
       if (event.key.key == SDLK_P)
         enginePauseResumeToggle();
+#if defined(RIPSAW_ENGINE_PROFILER)
+      // F9 starts a profiler capture and writes it out when pressed again.
+      if (event.key.key == SDLK_F9 and event.key.repeat == false)
+      {
+        if (Profiler::get().isCapturing())
+        {
+          Profiler::get().stopCapture();
+          Profiler::get().writeChromeTrace(ProfilerTracePath);
+        }
+        else
+          Profiler::get().startCapture();
+      }
+#endif
     }
   }
 }
@@ -1,21 +1,263 @@
 #include "RipsawEngine/2D/Core/Engine.hxx"
+#include "RipsawEngine/2D/Core/Profiler.hxx"
+#include "RipsawEngine/2D/Managers/Managers.hxx"
 #include "RipsawEngine/2D/Scene/Scene.hxx"
 
 namespace RipsawEngine
 {
 
+namespace
+{
+
+/// Minimum number of sprites per job of parallel render loops; smaller scenes stay on the main thread.
+constexpr std::size_t SpriteGrain{1024};
+/// Minimum number of particles per job of building particle vertices.
+constexpr std::size_t ParticleGrain{4096};
+/// Minimum number of tile vertices per job of projecting tile batches.
+constexpr std::size_t TileVertexGrain{8192};
+
+}
+
 void Engine::renderEngine()
 {
+  RIPSAW_PROFILE_ZONE("renderEngine");
+  this->prepareSprites();
+  RenderPacket& packet{mRenderPackets[mFrontPacket]};
+  this->extractRenderPacket(packet);
+  mRenderStats = this->drawRenderPacket(packet);
+}
+
+void Engine::prepareSprites()
+{
+  RIPSAW_PROFILE_ZONE("prepareSprites");
+  // Textures decoded in the background become visible this frame, as far as the upload budget allows.
+  mAssetLoader.pumpUploads();
+
+  this->compactSprites();
+  for (const auto& sprite : mSprites)
+  {
+    sprite->pollTexture();
+  }
+}
+
+void Engine::extractRenderPacket(RenderPacket& packet)
+{
+  RIPSAW_PROFILE_ZONE("extractRenderPacket");
+  // Off-screen sprites keep animating so they come back into view in the right state.
+  for (const auto& sprite : mSprites)
+  {
+    sprite->animate(mDt);
+  }
+  for (const auto& manager : mManagers)
+  {
+    std::visit([this](auto* ptr) {
+        ptr->animate(mDt);
+    }, manager);
+  }
+
+  packet.cameras = mCameras;
+  packet.isCulling = mIsViewportCulling;
+  // Snapshots only read sprites, so they can be taken in parallel.
+  packet.sprites.resize(mSprites.size());
+  mJobSystem.parallelFor(mSprites.size(), [this, &packet](std::size_t begin, std::size_t end) {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        mSprites[i]->snapshot(packet.sprites[i]);
+      }
+  }, SpriteGrain);
+
+  packet.quads.clear();
+  for (std::size_t camera{}; camera < packet.cameras.size(); ++camera)
+  {
+    for (const auto& manager : mManagers)
+    {
+      std::visit([&packet, camera](auto* ptr) {
+          ptr->submit(packet, camera);
+      }, manager);
+    }
+  }
+
+  packet.particles.clear();
+  packet.particleBatches.clear();
+  mParticleSystem.extract(packet, mJobSystem);
+
+  packet.tileVertices.clear();
+  packet.tileBatches.clear();
+  mTilemapSystem.extract(packet, mJobSystem);
+}
+
+RenderStats Engine::drawRenderPacket(const RenderPacket& packet)
+{
+  RIPSAW_PROFILE_ZONE("drawRenderPacket");
   SDL_SetRenderDrawColor(mRenderer, 40, 40, 40, 255);
   SDL_RenderClear(mRenderer);
 
-  for (const auto& sprite : mSprites)
+  const std::vector<SpriteSnapshot>& sprites{packet.sprites};
+  // Visibility is recomputed per camera and dropped with the frame, so it lives in the frame arena.
+  std::uint8_t* isVisible{mFrameArena.allocateArray<std::uint8_t>(sprites.size())};
+
+  std::size_t culled{};
+  std::size_t particles{};
+  std::size_t tiles{};
+  mSpriteBatch.begin(mRenderer);
+  for (std::size_t index{}; index < packet.cameras.size(); ++index)
   {
-    sprite->draw(mDt);
+    const Camera& camera{packet.cameras[index]};
+    // Quads of the previous camera must reach the renderer before the clip rectangle changes.
+    mSpriteBatch.flush();
+    SDL_FRect viewport{camera.getViewportRect()};
+    SDL_Rect clip{static_cast<int>(viewport.x), static_cast<int>(viewport.y), static_cast<int>(viewport.w), static_cast<int>(viewport.h)};
+    SDL_SetRenderClipRect(mRenderer, &clip);
+
+    // Backgrounds go behind every sprite.
+    for (const auto& quad : packet.quads)
+    {
+      if (quad.camera == index)
+        mSpriteBatch.draw(quad.texture, quad.src, quad.dst);
+    }
+
+    Aabb worldView{camera.getViewBounds()};
+    Aabb screenView{{0.f, 0.f}, {viewport.w, viewport.h}};
+    mJobSystem.parallelFor(sprites.size(), [&sprites, &packet, isVisible, &worldView, &screenView](std::size_t begin, std::size_t end) {
+        for (std::size_t i{begin}; i < end; ++i)
+        {
+          const SpriteSnapshot& sprite{sprites[i]};
+          isVisible[i] = packet.isCulling == false or sprite.bounds.overlaps(sprite.isScreenSpace ? screenView : worldView);
+        }
+    }, SpriteGrain);
+
+    mRenderQueue.clear();
+    for (std::size_t i{}; i < sprites.size(); ++i)
+    {
+      if (sprites[i].texture == nullptr)
+        continue;
+      if (isVisible[i] == 0)
+      {
+        ++culled;
+        continue;
+      }
+      mRenderQueue.push(sprites[i].key, &sprites[i]);
+    }
+
+    mRenderQueue.sort();
+    // Tile and particle batches are sorted too; merged in, each goes before the sprites of equal or greater key.
+    std::size_t tileBatch{};
+    std::size_t particleBatch{};
+    auto drawBatches{[&](std::uint64_t limit) {
+        for (;;)
+        {
+          bool hasTiles{tileBatch < packet.tileBatches.size() and packet.tileBatches[tileBatch].key <= limit};
+          bool hasParticles{particleBatch < packet.particleBatches.size() and packet.particleBatches[particleBatch].key <= limit};
+          if (hasTiles == false and hasParticles == false)
+            return;
+          // At equal keys tiles go first, as the ground under whatever moves on it.
+          if (hasTiles and (hasParticles == false or packet.tileBatches[tileBatch].key <= packet.particleBatches[particleBatch].key))
+            tiles += this->drawTileBatch(packet, packet.tileBatches[tileBatch++], camera);
+          else
+            particles += this->drawParticleBatch(packet, packet.particleBatches[particleBatch++], camera);
+        }
+    }};
+    for (const auto& item : mRenderQueue.getItems())
+    {
+      drawBatches(item.key);
+      const SpriteSnapshot& sprite{*item.sprite};
+      double angle{sprite.rotation};
+      SDL_FRect dst{camera.projectRect(sprite.dst, sprite.isScreenSpace, angle)};
+      mSpriteBatch.draw(sprite.texture, sprite.src, dst, angle, sprite.flip);
+    }
+    drawBatches(UINT64_MAX);
   }
+  mSpriteBatch.end();
+  SDL_SetRenderClipRect(mRenderer, nullptr);
 
+  RenderStats stats{mSpriteBatch.getDrawCalls(), mSpriteBatch.getQuads(), culled, particles, tiles};
+
+  RIPSAW_PROFILE_ZONE("SDL_RenderPresent");
   SDL_RenderPresent(mRenderer);
+  return stats;
 }
 
+std::size_t Engine::drawParticleBatch(const RenderPacket& packet, const ParticleBatch& batch, const Camera& camera)
+{
+  if (packet.isCulling and batch.bounds.overlaps(camera.getViewBounds()) == false)
+    return 0;
+
+  // Projection is affine, so three projected points give it for every particle. Quads stay upright on screen.
+  glm::vec2 origin{camera.worldToScreen({0.f, 0.f})};
+  glm::vec2 axisX{camera.worldToScreen({1.f, 0.f}) - origin};
+  glm::vec2 axisY{camera.worldToScreen({0.f, 1.f}) - origin};
+  float zoom{camera.getZoom()};
+
+  float u0{}, v0{}, u1{}, v1{};
+  if (batch.texture != nullptr)
+  {
+    float w{}, h{};
+    SDL_GetTextureSize(batch.texture, &w, &h);
+    u0 = batch.src.x / w;
+    v0 = batch.src.y / h;
+    u1 = (batch.src.x + batch.src.w) / w;
+    v1 = (batch.src.y + batch.src.h) / h;
+  }
+
+  mBatchVertices.resize(batch.count * 4);
+  SDL_Vertex* vertices{mBatchVertices.data()};
+  const PacketParticle* source{packet.particles.data() + batch.first};
+  mJobSystem.parallelFor(batch.count, [=](std::size_t begin, std::size_t end) {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        const PacketParticle& particle{source[i]};
+        glm::vec2 center{origin + axisX * particle.x + axisY * particle.y};
+        float half{particle.size * zoom / 2.f};
+        SDL_Vertex* quad{vertices + i * 4};
+        quad[0] = {{center.x - half, center.y - half}, particle.color, {u0, v0}};
+        quad[1] = {{center.x + half, center.y - half}, particle.color, {u1, v0}};
+        quad[2] = {{center.x + half, center.y + half}, particle.color, {u1, v1}};
+        quad[3] = {{center.x - half, center.y + half}, particle.color, {u0, v1}};
+      }
+  }, ParticleGrain);
+
+  mSpriteBatch.drawGeometry(batch.texture, vertices, static_cast<int>(batch.count * 4), this->getQuadIndices(batch.count), static_cast<int>(batch.count * 6));
+  return batch.count;
+}
+
+std::size_t Engine::drawTileBatch(const RenderPacket& packet, const TileBatch& batch, const Camera& camera)
+{
+  if (packet.isCulling and batch.bounds.overlaps(camera.getViewBounds()) == false)
+    return 0;
+
+  // Cached vertices are relative to the map origin; projecting them is one affine transform, rotation included.
+  glm::vec2 origin{camera.worldToScreen(batch.origin)};
+  glm::vec2 axisX{camera.worldToScreen(batch.origin + glm::vec2{1.f, 0.f}) - origin};
+  glm::vec2 axisY{camera.worldToScreen(batch.origin + glm::vec2{0.f, 1.f}) - origin};
+
+  std::size_t count{batch.count * 4};
+  mBatchVertices.resize(count);
+  SDL_Vertex* vertices{mBatchVertices.data()};
+  const SDL_Vertex* source{packet.tileVertices.data() + batch.first};
+  mJobSystem.parallelFor(count, [=](std::size_t begin, std::size_t end) {
+      for (std::size_t i{begin}; i < end; ++i)
+      {
+        glm::vec2 pos{origin + axisX * source[i].position.x + axisY * source[i].position.y};
+        vertices[i] = {{pos.x, pos.y}, source[i].color, source[i].tex_coord};
+      }
+  }, TileVertexGrain);
+
+  mSpriteBatch.drawGeometry(batch.texture, vertices, static_cast<int>(count), this->getQuadIndices(batch.count), static_cast<int>(batch.count * 6));
+  return batch.count;
 }
 
+const int* Engine::getQuadIndices(std::size_t quads)
+{
+  // Every quad has the same index pattern, so indices only ever need appending.
+  for (std::size_t quad{mQuadIndices.size() / 6}; quad < quads; ++quad)
+  {
+    int base{static_cast<int>(quad * 4)};
+    for (int index : {0, 1, 2, 2, 3, 0})
+    {
+      mQuadIndices.push_back(base + index);
+    }
+  }
+  return mQuadIndices.data();
+}
+
+}
@@ -1,11 +1,27 @@
 #include "RipsawEngine/2D/Core/Engine.hxx"
+#include "RipsawEngine/2D/Core/Game.hxx"
+#include "RipsawEngine/2D/Core/Profiler.hxx"
 #include "RipsawEngine/2D/Scene/Actor.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <cmath>
+#include <utility>
 
 namespace RipsawEngine
 {
 
+namespace
+{
+
+/// Minimum number of actors per job of parallel actor update.
+constexpr std::size_t ActorGrain{256};
+
+}
+
 void Engine::updateEngine()
 {
+  RIPSAW_PROFILE_ZONE("updateEngine");
+
   // Frame locking code would go here.
   // But the preferred philosophy is to let the loop
   // run as fast as possible depending on the hardware.
@@ -35,7 +51,7 @@ void Engine::updateEngine()
   // If dt accumulation becomes 1 second, print number of passed frames and reset both to 0.
   if (mFrameTime >= 1.0)
   {
-    SDL_Log("[INFO] Rendering at: %d FPS", mFrames);
+    RIPSAW_LOG_INFO(Core, "Rendering at: %d FPS (%zu sprites in %zu draw calls per frame)", mFrames, mRenderStats.sprites, mRenderStats.drawCalls);
     mFrameTime = 0;
     mFrames = 0;
 
@@ -47,19 +63,101 @@ void Engine::updateEngine()
     }
   }
 
-  for (auto& actor : mActorsToBeKilled)
+  if (mIsFixedTimestep == false)
+  {
+    this->simulate(dt);
+    return;
+  }
+
+  // Fixed timestep consumes the real frame time, unclamped; the substep cap below is what keeps it bounded.
+  mAccumulator += mDt;
+  int steps{};
+  while (mAccumulator >= mFixedDt and steps < mMaxSubsteps)
   {
-    this->destroyActor(actor);
+    mTransformSystem.snapshot();
+    this->simulate(mFixedDt);
+    mAccumulator -= mFixedDt;
+    ++steps;
   }
-  mActorsToBeKilled.clear();
 
-  mActorsBeingUpdated = true;
-  for (const auto& actor : mActors)
+  // Couldn't keep up: drop the backlog instead of spiralling into ever more ticks per frame.
+  if (mAccumulator >= mFixedDt)
+    mAccumulator = std::fmod(mAccumulator, mFixedDt);
+
+  mInterpolationAlpha = mAccumulator / mFixedDt;
+  mTransformSystem.setInterpolation(static_cast<float>(mInterpolationAlpha));
+}
+
+void Engine::simulate(double dt)
+{
+  RIPSAW_PROFILE_ZONE("simulate");
+
+  {
+    RIPSAW_PROFILE_ZONE("TransformSystem::integrate");
+    // Integrate all transforms at once before actors get to see them.
+    mTransformSystem.integrate(static_cast<float>(dt));
+  }
+
+  {
+    RIPSAW_PROFILE_ZONE("TransformSystem::syncSpatialHash");
+    mTransformSystem.syncSpatialHash();
+  }
+
+  {
+    RIPSAW_PROFILE_ZONE("Actor::update");
+    mActorsBeingUpdated = true;
+    if (mIsParallelUpdate)
+    {
+      // Restored rather than cleared: a pipelined simulation stays in parallel mode for the whole step.
+      bool wasUpdatingInParallel{std::exchange(mIsUpdatingInParallel, true)};
+      mJobSystem.parallelFor(mActors.size(), [this, dt](std::size_t begin, std::size_t end) {
+          for (std::size_t i{begin}; i < end; ++i)
+          {
+            mActors[i]->update(dt);
+          }
+      }, ActorGrain);
+      mIsUpdatingInParallel = wasUpdatingInParallel;
+    }
+    else
+    {
+      for (const auto& actor : mActors)
+      {
+        // All actor update occurs as a function of dt.
+        actor->update(dt);
+      }
+    }
+    mActorsBeingUpdated = false;
+  }
+
+  {
+    RIPSAW_PROFILE_ZONE("SystemScheduler::run");
+    bool wasUpdatingInParallel{std::exchange(mIsUpdatingInParallel, true)};
+    mSystemScheduler.run(dt, mJobSystem);
+    mIsUpdatingInParallel = wasUpdatingInParallel;
+  }
+
+  {
+    RIPSAW_PROFILE_ZONE("Game::updateGame");
+    mGame->updateGame(dt);
+  }
+
+  {
+    RIPSAW_PROFILE_ZONE("AnimationSystem::update");
+    mAnimationSystem.update(dt, mCameras, mJobSystem);
+  }
+
+  {
+    RIPSAW_PROFILE_ZONE("ParticleSystem::update");
+    mParticleSystem.update(dt, mJobSystem);
+  }
+  // Sync point: structural changes recorded by actors, systems, and the game take effect here. A pipelined simulation leaves them to the main thread, see finishSimulation().
+  if (mIsUpdatingInParallel == false)
   {
-    // All actor update occurs as a function of dt.
-    actor->update(dt);
+    this->applyCommands();
+    this->flushDestroyedActors();
   }
-  mActorsBeingUpdated = false;
+  // Pick up positions set by actors and the game during this step.
+  mTransformSystem.syncDirtyBounds();
 }
 
 }
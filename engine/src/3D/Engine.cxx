@@ -5,16 +5,16 @@ namespace RipsawEngine::_3D
 
 Engine::Engine()
 {
-  SDL_Log("[START] RipsawEngine::_3D subsystem");
+  RIPSAW_LOG_INFO(Core, "Started RipsawEngine::_3D subsystem");
 #if defined(RIPSAW_ENGINE_TARGET_LINUX) && defined(RIPSAW_ENGINE_BACKEND_GLCORE43)
-  SDL_Log("[INFO] Selected target: Linux");
-  SDL_Log("[INFO] Selected backend: gl_core_43");
+  RIPSAW_LOG_INFO(Core, "Selected target: Linux");
+  RIPSAW_LOG_INFO(Core, "Selected backend: gl_core_43");
 #elif defined(RIPSAW_ENGINE_TARGET_LINUX) && defined(RIPSAW_ENGINE_BACKEND_GLES2CORE32)
-  SDL_Log("[INFO] Selected target: Linux");
-  SDL_Log("[INFO] Selected backend: gles2_core_32");
+  RIPSAW_LOG_INFO(Core, "Selected target: Linux");
+  RIPSAW_LOG_INFO(Core, "Selected backend: gles2_core_32");
 #elif defined(RIPSAW_ENGINE_TARGET_ANDROID)
-  SDL_Log("[INFO] Selected target: Android");
-  SDL_Log("[INFO] Selected backend: gles2_core_32");
+  RIPSAW_LOG_INFO(Core, "Selected target: Android");
+  RIPSAW_LOG_INFO(Core, "Selected backend: gles2_core_32");
 #endif
 }
 
@@ -22,10 +22,11 @@ Engine::~Engine()
 {
   glDeleteProgram(mProgram);
   SDL_GL_DestroyContext(mContext);
-  SDL_Log("[INFO] Destroyed OpenGL context");
+  RIPSAW_LOG_INFO(Render, "Destroyed OpenGL context");
   SDL_DestroyWindow(mWindow);
-  SDL_Log("[INFO] Destroyed window");
-  SDL_Log("[STOP] RipsawEngine::_3D subsystem");
+  RIPSAW_LOG_INFO(Core, "Destroyed window");
+  RIPSAW_LOG_INFO(Core, "Stopped RipsawEngine::_3D subsystem");
+  Log::get().flush();
 }
 
 void Engine::init()
@@ -48,7 +49,7 @@ void Engine::initDisplay()
   mHeight = dm->h;
   if (mWidth <= 0 or mHeight <= 0)
     throw std::runtime_error{"[ERROR] Invalid display dimension"};
-  SDL_Log("[INFO] Detected display dimension: %d X %d", mWidth, mHeight);
+  RIPSAW_LOG_INFO(Core, "Detected display dimension: %d X %d", mWidth, mHeight);
 }
 
 void Engine::initGL()
@@ -62,38 +63,38 @@ void Engine::initGL()
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 2);
     SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_ES);
 #endif
-  SDL_Log("[INFO] GL attributes set up");
+  RIPSAW_LOG_INFO(Render, "GL attributes set up");
 
   mWindow = SDL_CreateWindow("RipsawEngine3D", mWidth, mHeight, SDL_WINDOW_OPENGL | SDL_WINDOW_FULLSCREEN);
   if (mWindow == nullptr)
     throw std::runtime_error{"[ERROR] %s" + std::string{SDL_GetError()}};
-  SDL_Log("[INFO] Created window: %d X %d", mWidth, mHeight);
+  RIPSAW_LOG_INFO(Core, "Created window: %d X %d", mWidth, mHeight);
 
 #if defined(RIPSAW_ENGINE_BACKEND_GLCORE43)
   mContext = SDL_GL_CreateContext(mWindow);
-  SDL_Log("[INFO] Created OpenGL context");
+  RIPSAW_LOG_INFO(Render, "Created OpenGL context");
   int gladinit = gladLoadGLLoader(reinterpret_cast<GLADloadproc>(SDL_GL_GetProcAddress));
   if (gladinit == 0)
     throw std::runtime_error{"[ERROR] GLAD init failed"};
-  SDL_Log("[INFO] GLAD initialized");
-  SDL_Log("\tGL Vendor:\t%s", glGetString(GL_VENDOR));
-  SDL_Log("\tGL Renderer:\t%s", glGetString(GL_RENDERER));
-  SDL_Log("\tGL Version:\t%s", glGetString(GL_VERSION));
-  SDL_Log("\tGLSL Version:\t%s", glGetString(GL_SHADING_LANGUAGE_VERSION));
+  RIPSAW_LOG_INFO(Render, "GLAD initialized");
+  RIPSAW_LOG_INFO(Render, "GL Vendor: %s", reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+  RIPSAW_LOG_INFO(Render, "GL Renderer: %s", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+  RIPSAW_LOG_INFO(Render, "GL Version: %s", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+  RIPSAW_LOG_INFO(Render, "GLSL Version: %s", reinterpret_cast<const char*>(glGetString(GL_SHADING_LANGUAGE_VERSION)));
 #elif defined(RIPSAW_ENGINE_BACKEND_GLES2CORE32)
   mContext = SDL_GL_CreateContext(mWindow);
-  SDL_Log("[INFO] Created OpenGL context");
+  RIPSAW_LOG_INFO(Render, "Created OpenGL context");
   int gladinit = gladLoadGLES2Loader(reinterpret_cast<GLADloadproc>(SDL_GL_GetProcAddress));
   if (gladinit == 0)
     throw std::runtime_error{"[ERROR] GLAD init failed"};
-  SDL_Log("[INFO] GLAD initialized");
-  SDL_Log("\tGL Vendor:\t%s", glGetString(GL_VENDOR));
-  SDL_Log("\tGL Renderer:\t%s", glGetString(GL_RENDERER));
-  SDL_Log("\tGL Version:\t%s", glGetString(GL_VERSION));
-  SDL_Log("\tGLSL Version:\t%s", glGetString(GL_SHADING_LANGUAGE_VERSION));
+  RIPSAW_LOG_INFO(Render, "GLAD initialized");
+  RIPSAW_LOG_INFO(Render, "GL Vendor: %s", reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+  RIPSAW_LOG_INFO(Render, "GL Renderer: %s", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+  RIPSAW_LOG_INFO(Render, "GL Version: %s", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+  RIPSAW_LOG_INFO(Render, "GLSL Version: %s", reinterpret_cast<const char*>(glGetString(GL_SHADING_LANGUAGE_VERSION)));
 #endif
   glViewport(0, 0, mWidth, mHeight);
-  SDL_Log("[INFO] Viewport created: %d X %d", mWidth, mHeight);
+  RIPSAW_LOG_INFO(Render, "Viewport created: %d X %d", mWidth, mHeight);
 }
 
 void Engine::initGeom()
@@ -163,7 +164,7 @@ void Engine::initShaders()
     glGetShaderInfoLog(mVertexShader, sizeof(mInfolog), nullptr, mInfolog);
     throw std::runtime_error{"[ERROR] Failed compiling vertex shader: " + std::string{mInfolog}};
   }
-  SDL_Log("[INFO] Compiled vertex shader: %d", mVertexShader);
+  RIPSAW_LOG_INFO(Render, "Compiled vertex shader: %d", mVertexShader);
   mCompStat = 0;
   
   glShaderSource(mFragmentShader, 1, &fragmentCstr, nullptr);
@@ -174,7 +175,7 @@ void Engine::initShaders()
     glGetShaderInfoLog(mFragmentShader, sizeof(mInfolog), nullptr, mInfolog);
     throw std::runtime_error{"[ERROR] Failed compiling fragment shader: " + std::string{mInfolog}};
   }
-  SDL_Log("[INFO] Compiled fragment shader: %d", mFragmentShader);
+  RIPSAW_LOG_INFO(Render, "Compiled fragment shader: %d", mFragmentShader);
   mCompStat = 0;
 
   mProgram = glCreateProgram();
@@ -187,7 +188,7 @@ void Engine::initShaders()
     glGetProgramInfoLog(mProgram, sizeof(mInfolog), nullptr, mInfolog);
     throw std::runtime_error{"[ERROR] Failed linking program: " + std::string{mInfolog}};
   }
-  SDL_Log("[INFO] Linked program: %d", mProgram);
+  RIPSAW_LOG_INFO(Render, "Linked program: %d", mProgram);
   mCompStat = 0;
 
   glDeleteShader(mFragmentShader);
@@ -0,0 +1,240 @@
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace RipsawEngine
+{
+
+namespace
+{
+
+static_assert((LogRing::Capacity & (LogRing::Capacity - 1)) == 0, "Log ring capacity must be a power of two");
+
+/// Name of each category in written messages.
+constexpr std::array<const char*, static_cast<std::size_t>(LogCategory::Count)> CategoryNames{"Core", "Scene", "Render", "Assets", "Systems", "Game"};
+
+/// Returns current time in milliseconds.
+Uint64 nowMs()
+{
+  return SDL_GetTicksNS() / 1'000'000;
+}
+
+}
+
+LogRing::LogRing()
+  : mCells{std::make_unique<Cell[]>(Capacity)}
+{
+  for (std::size_t i{}; i < Capacity; ++i)
+  {
+    mCells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool LogRing::push(LogCategory category, LogLevel level, const char* fmt, std::va_list args)
+{
+  std::size_t position{mHead.load(std::memory_order_relaxed)};
+  Cell* cell{nullptr};
+  while (true)
+  {
+    cell = &mCells[position & (Capacity - 1)];
+    std::size_t sequence{cell->sequence.load(std::memory_order_acquire)};
+    if (sequence == position)
+    {
+      // Cell is free for this position; claim it unless another producer was faster.
+      if (mHead.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+        break;
+    }
+    else if (sequence < position)
+      // Cell still holds a record from one lap ago that hasn't been popped.
+      return false;
+    else
+      position = mHead.load(std::memory_order_relaxed);
+  }
+
+  cell->record.category = category;
+  cell->record.level = level;
+  std::vsnprintf(cell->record.text.data(), cell->record.text.size(), fmt, args);
+  cell->sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+bool LogRing::pop(LogRecord& out)
+{
+  Cell& cell{mCells[mTail & (Capacity - 1)]};
+  if (cell.sequence.load(std::memory_order_acquire) != mTail + 1)
+    return false;
+
+  out = cell.record;
+  // Frees the cell for the producer one lap ahead.
+  cell.sequence.store(mTail + Capacity, std::memory_order_release);
+  ++mTail;
+  return true;
+}
+
+Log& Log::get()
+{
+  static Log log{};
+  return log;
+}
+
+Log::Log()
+{
+  this->setLevel(LogLevel::Info);
+  mThread = std::thread{&Log::drainLoop, this};
+}
+
+Log::~Log()
+{
+  mIsStopping.store(true, std::memory_order_release);
+  if (mThread.joinable())
+    mThread.join();
+}
+
+void Log::setLevel(LogCategory category, LogLevel level)
+{
+  mLevels[static_cast<std::size_t>(category)].store(level, std::memory_order_relaxed);
+}
+
+void Log::setLevel(LogLevel level)
+{
+  for (auto& categoryLevel : mLevels)
+  {
+    categoryLevel.store(level, std::memory_order_relaxed);
+  }
+}
+
+LogLevel Log::getLevel(LogCategory category) const
+{
+  return mLevels[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+}
+
+void Log::write(LogCategory category, LogLevel level, const char* fmt, ...)
+{
+  std::va_list args;
+  va_start(args, fmt);
+  bool isPushed{mRing.push(category, level, fmt, args)};
+  va_end(args);
+  if (isPushed)
+  {
+    mPushed.fetch_add(1, std::memory_order_release);
+    return;
+  }
+
+  // Full ring: errors are too important to lose, everything else is counted and reported later.
+  if (level < LogLevel::Error)
+  {
+    mDropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  std::array<char, LogRecord::MessageSize> text{};
+  va_start(args, fmt);
+  std::vsnprintf(text.data(), text.size(), fmt, args);
+  va_end(args);
+  output(category, level, text.data());
+}
+
+void Log::flush()
+{
+  std::size_t target{mPushed.load(std::memory_order_acquire)};
+  while (mDrained.load(std::memory_order_acquire) < target and mThread.joinable())
+  {
+    std::this_thread::yield();
+  }
+}
+
+std::size_t Log::getDropped() const
+{
+  return mDropped.load(std::memory_order_relaxed);
+}
+
+void Log::drainLoop()
+{
+  while (mIsStopping.load(std::memory_order_acquire) == false)
+  {
+    if (this->drain() == false)
+      std::this_thread::sleep_for(std::chrono::milliseconds{DrainIntervalMs});
+    if (mRepeats > 0 and nowMs() - mLastReport >= RepeatReportMs)
+      this->reportRepeats();
+  }
+  // Messages queued right before stopping still go out.
+  this->drain();
+  this->reportRepeats();
+}
+
+bool Log::drain()
+{
+  bool isDrained{false};
+  LogRecord record{};
+  while (mRing.pop(record))
+  {
+    this->emit(record);
+    mDrained.fetch_add(1, std::memory_order_release);
+    isDrained = true;
+  }
+
+  std::size_t dropped{mDropped.load(std::memory_order_relaxed)};
+  if (dropped != mReportedDropped)
+  {
+    std::array<char, LogRecord::MessageSize> text{};
+    std::snprintf(text.data(), text.size(), "Log ring full, %zu messages dropped", dropped - mReportedDropped);
+    output(LogCategory::Core, LogLevel::Warn, text.data());
+    mReportedDropped = dropped;
+  }
+  return isDrained;
+}
+
+void Log::emit(const LogRecord& record)
+{
+  if (record.category == mLast.category and record.level == mLast.level and std::strcmp(record.text.data(), mLast.text.data()) == 0)
+  {
+    ++mRepeats;
+    return;
+  }
+
+  this->reportRepeats();
+  output(record.category, record.level, record.text.data());
+  mLast = record;
+  mLastReport = nowMs();
+}
+
+void Log::reportRepeats()
+{
+  if (mRepeats == 0)
+    return;
+
+  std::array<char, LogRecord::MessageSize> text{};
+  std::snprintf(text.data(), text.size(), "Previous message repeated %zu times", mRepeats);
+  output(mLast.category, mLast.level, text.data());
+  mRepeats = 0;
+  mLastReport = nowMs();
+}
+
+void Log::output(LogCategory category, LogLevel level, const char* text)
+{
+  const char* name{CategoryNames[static_cast<std::size_t>(category)]};
+  // Trace and debug go out at SDL's info priority, which SDL shows by default; filtering them is the job of runtime levels.
+  switch (level)
+  {
+    case LogLevel::Trace:
+      SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "[TRACE] [%s] %s", name, text);
+      break;
+    case LogLevel::Debug:
+      SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "[DEBUG] [%s] %s", name, text);
+      break;
+    case LogLevel::Info:
+      SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO, "[INFO] [%s] %s", name, text);
+      break;
+    case LogLevel::Warn:
+      SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN, "[WARN] [%s] %s", name, text);
+      break;
+    case LogLevel::Error:
+      SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_ERROR, "[ERROR] [%s] %s", name, text);
+      break;
+    case LogLevel::Off:
+      break;
+  }
+}
+
+}
@@ -0,0 +1,33 @@
+#ifndef SANDBOX_BENCH_BENCH_HXX
+#define SANDBOX_BENCH_BENCH_HXX
+
+#include <cstddef>
+
+namespace Bench
+{
+
+/// Compares per-component virtual transform updates against @ref RipsawEngine::TransformSystem.
+/// @return Process exit code.
+int transform();
+/// Compares heap allocation against @ref RipsawEngine::Pool for spawning and despawning engine objects.
+/// @return Process exit code.
+int pool();
+/// Runs the real engine loop headlessly over parameterized scenes and prints results as JSON.
+/// @param frames Number of measured frames per scene.
+/// @return Process exit code.
+int engine(std::size_t frames);
+/// Measures incremental @ref RipsawEngine::SpatialHash maintenance against a full rebuild at 50k moving bodies, and query costs.
+/// @return Process exit code.
+int spatial();
+/// Measures @ref RipsawEngine::JobSystem scaling of a compute-bound parallel loop over thread counts, and per-task overhead.
+/// @return Process exit code.
+int jobs();
+/// Starts or stops counting heap allocations of the whole process.
+/// @param enabled Boolean flag to count allocations.
+void setAllocationCounting(bool enabled);
+/// Returns number of heap allocations counted so far.
+std::size_t getAllocationCount();
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+#include "Bench.hxx"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replacing the global allocation functions here counts every heap allocation in the process, engine library included.
+
+namespace
+{
+
+/// True while allocations are counted.
+std::atomic<bool> gIsCounting{false};
+/// Number of allocations counted.
+std::atomic<std::size_t> gAllocations{};
+
+}
+
+void* operator new(std::size_t size)
+{
+  if (gIsCounting.load(std::memory_order_relaxed))
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+
+  void* ptr{std::malloc(size == 0 ? 1 : size)};
+  if (ptr == nullptr)
+    throw std::bad_alloc{};
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, [[maybe_unused]] std::size_t size) noexcept
+{
+  std::free(ptr);
+}
+
+namespace Bench
+{
+
+void setAllocationCounting(bool enabled)
+{
+  gIsCounting.store(enabled, std::memory_order_relaxed);
+}
+
+std::size_t getAllocationCount()
+{
+  return gAllocations.load(std::memory_order_relaxed);
+}
+
+}
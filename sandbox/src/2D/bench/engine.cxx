@@ -0,0 +1,414 @@
+#include "Bench.hxx"
+#include "RipsawEngine/2D/Core/Core.hxx"
+#include "RipsawEngine/2D/Managers/BGManager.hxx"
+#include "RipsawEngine/2D/Scene/Scene.hxx"
+#include "RipsawEngine/Common/Log.hxx"
+
+#include <SDL3/SDL.h>
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr int ScreenWidth{1280};
+constexpr int ScreenHeight{720};
+constexpr float ScreenW{ScreenWidth};
+constexpr float ScreenH{ScreenHeight};
+/// Frames run before measuring, so texture loading and pool growth don't count.
+constexpr std::size_t WarmupFrames{30};
+/// Iterations of busy work per actor and frame in the heavy simulation scene.
+constexpr int SimulationWork{400};
+/// Particles per emitter in the particle scene.
+constexpr std::size_t ParticlesPerEmitter{10000};
+/// Tiles of the tilemap scene changed per frame, all on screen.
+constexpr int TileEditsPerFrame{16};
+/// Camera speed of the tilemap scene in pixels per second.
+constexpr float ScrollSpeed{300.f};
+/// Tiles of the tileset, 32 pixel tiles of a 512 x 640 image.
+constexpr int TilesetTiles{16 * 20};
+
+const std::string StaticImage{"sandbox/assets/ships1.png"};
+const std::string ChurnImage{"sandbox/assets/ships2.png"};
+const std::string SheetImage{"sandbox/assets/man.png"};
+const std::string TilesetImage{"sandbox/assets/ships2.png"};
+const std::vector<std::string> LayerImages{"sandbox/assets/bglayer1.png", "sandbox/assets/bglayer2.png"};
+
+enum class SceneKind
+{
+  StaticSprites,
+  LargeLevel,
+  MovingSpritesheets,
+  YSorted,
+  Parallax,
+  Churn,
+  HeavySimulation,
+  Particles,
+  Tilemap,
+};
+
+/// One benchmark scene.
+struct SceneConfig
+{
+  /// Scene name in the output.
+  const char* name{};
+  /// What the scene does.
+  SceneKind kind{};
+  /// Number of actors, of layers for parallax, of actors replaced per frame for churn, of live particles, or of tiles per map side.
+  std::size_t count{};
+  /// True to pipeline simulation and rendering, see Engine::setPipelined().
+  bool isPipelined{false};
+};
+
+/// Measurements of one scene.
+struct SceneResult
+{
+  /// Durations of measured frames in nanoseconds.
+  std::vector<Uint64> frameTimes{};
+  /// Heap allocations during measured frames.
+  std::size_t allocations{};
+  /// Draw calls summed over measured frames.
+  std::size_t drawCalls{};
+  /// Drawn sprites summed over measured frames.
+  std::size_t sprites{};
+  /// Culled sprites summed over measured frames.
+  std::size_t culled{};
+  /// Drawn particles summed over measured frames.
+  std::size_t particles{};
+  /// Drawn tiles summed over measured frames.
+  std::size_t tiles{};
+};
+
+class BenchGame : public RipsawEngine::Game
+{
+public:
+  BenchGame(const SceneConfig& scene, std::size_t frames)
+    : mScene{scene},
+      mFrames{frames}
+  {}
+
+  void initGame() override
+  {
+    // Info logs of scene setup would show up in the measurement; warnings and errors still matter.
+    RipsawEngine::Log::get().setLevel(RipsawEngine::LogLevel::Warn);
+
+    switch (mScene.kind)
+    {
+      case SceneKind::StaticSprites:
+        for (std::size_t i{}; i < mScene.count; ++i)
+        {
+          this->spawn(StaticImage, {});
+        }
+        break;
+      case SceneKind::LargeLevel:
+      {
+        // Level eight screens wide and eight high; only about one sprite in 64 is on screen.
+        std::uniform_real_distribution<float> x{-3.5f * ScreenW, 4.5f * ScreenW};
+        std::uniform_real_distribution<float> y{-3.5f * ScreenH, 4.5f * ScreenH};
+        for (std::size_t i{}; i < mScene.count; ++i)
+        {
+          RipsawEngine::Actor* actor{mEngine->createActor()};
+          actor->createTransformComponent({x(mRng), y(mRng)}, {});
+          actor->createSpriteComponent(StaticImage);
+          actor->getSpriteComponent()->setScale(0.25f);
+        }
+        break;
+      }
+      case SceneKind::MovingSpritesheets:
+      case SceneKind::YSorted:
+      case SceneKind::HeavySimulation:
+        for (std::size_t i{}; i < mScene.count; ++i)
+        {
+          RipsawEngine::Actor* actor{mEngine->createActor()};
+          actor->createTransformComponent(this->randomPosition(), this->randomVelocity());
+          actor->createSpritesheetComponent(SheetImage, {6, 1}, {1, 1}, true, 12.f);
+          actor->getSpriteComponent()->setScale(0.5f);
+          actor->getSpriteComponent()->setYSorted(mScene.kind == SceneKind::YSorted);
+          mActors.push_back(actor);
+        }
+        break;
+      case SceneKind::Parallax:
+      {
+        std::vector<std::string> layers{};
+        std::vector<float> speeds{};
+        for (std::size_t i{}; i < mScene.count; ++i)
+        {
+          layers.push_back(LayerImages[i % LayerImages.size()]);
+          speeds.push_back(-20.f * static_cast<float>(i + 1));
+        }
+        mBGManager = mEngine->createBGManager(layers, speeds);
+        break;
+      }
+      case SceneKind::Churn:
+        for (std::size_t i{}; i < mScene.count; ++i)
+        {
+          mHandles.push_back(this->spawn(ChurnImage, this->randomVelocity()));
+        }
+        break;
+      case SceneKind::Particles:
+      {
+        // Emitters at full capacity after one lifetime, replacing as many particles per second as die.
+        RipsawEngine::ParticleEmitterConfig config{};
+        config.maxParticles = ParticlesPerEmitter;
+        config.lifetime = {1.f, 1.f};
+        config.rate = static_cast<float>(ParticlesPerEmitter);
+        config.speed = {20.f, 120.f};
+        config.gravity = {0.f, 60.f};
+        config.size = {2.f, 4.f};
+        config.endColor = {1.f, 0.5f, 0.f, 0.f};
+        for (std::size_t i{}; i < mScene.count / ParticlesPerEmitter; ++i)
+        {
+          RipsawEngine::Actor* actor{mEngine->createActor()};
+          actor->createTransformComponent(this->randomPosition(), {});
+          actor->createParticleEmitterComponent(config);
+        }
+        break;
+      }
+      case SceneKind::Tilemap:
+      {
+        RipsawEngine::TilemapConfig config{};
+        config.imgfile = TilesetImage;
+        config.mapSize = {static_cast<int>(mScene.count), static_cast<int>(mScene.count)};
+        RipsawEngine::Actor* actor{mEngine->createActor()};
+        actor->createTilemapComponent(config);
+        mTilemap = actor->getComponent<RipsawEngine::TilemapComponent>();
+        std::uniform_int_distribution<int> tile{1, TilesetTiles};
+        glm::ivec2 size{mTilemap->getMapSize()};
+        for (int y{}; y < size.y; ++y)
+        {
+          for (int x{}; x < size.x; ++x)
+          {
+            mTilemap->setTile({x, y}, static_cast<RipsawEngine::TileId>(tile(mRng)));
+          }
+        }
+        break;
+      }
+    }
+  }
+
+  void updateGame(double dt) override
+  {
+    switch (mScene.kind)
+    {
+      case SceneKind::StaticSprites:
+      case SceneKind::LargeLevel:
+      case SceneKind::Particles:
+        break;
+      case SceneKind::Tilemap:
+      {
+        // Diagonal scroll brings new chunks into view every few frames; edits rebuild only the chunks they hit.
+        RipsawEngine::Camera& camera{mEngine->getCamera()};
+        camera.move(glm::vec2{ScrollSpeed, ScrollSpeed * ScreenH / ScreenW} * static_cast<float>(dt));
+        std::uniform_real_distribution<float> x{-ScreenW / 2.f, ScreenW / 2.f};
+        std::uniform_real_distribution<float> y{-ScreenH / 2.f, ScreenH / 2.f};
+        std::uniform_int_distribution<int> tile{1, TilesetTiles};
+        for (int i{}; i < TileEditsPerFrame; ++i)
+        {
+          glm::ivec2 cell{mTilemap->worldToCell(camera.getPosition() + glm::vec2{x(mRng), y(mRng)})};
+          mTilemap->setTile(cell, static_cast<RipsawEngine::TileId>(tile(mRng)));
+        }
+        break;
+      }
+      case SceneKind::MovingSpritesheets:
+      case SceneKind::YSorted:
+        // Wrap around the screen so the number of visible actors stays constant.
+        for (auto* actor : mActors)
+        {
+          glm::vec2 pos{actor->getPosition()};
+          if (pos.x < 0 or pos.x > ScreenW or pos.y < 0 or pos.y > ScreenH)
+          {
+            actor->teleport({
+              pos.x < 0 ? ScreenW : (pos.x > ScreenW ? 0.f : pos.x),
+              pos.y < 0 ? ScreenH : (pos.y > ScreenH ? 0.f : pos.y)
+            });
+          }
+        }
+        break;
+      case SceneKind::HeavySimulation:
+        // Stands in for game logic costly enough to matter next to rendering, e.g. AI or physics.
+        for (auto* actor : mActors)
+        {
+          glm::vec2 pos{actor->getPosition()};
+          float sum{};
+          for (int i{}; i < SimulationWork; ++i)
+          {
+            sum += std::sin(pos.x + static_cast<float>(i)) * std::sqrt(pos.y + static_cast<float>(i));
+          }
+          mSink += sum;
+          if (pos.x < 0 or pos.x > ScreenW or pos.y < 0 or pos.y > ScreenH)
+            actor->teleport({ScreenW / 2.f, ScreenH / 2.f});
+        }
+        break;
+      case SceneKind::Parallax:
+        mBGManager->update();
+        break;
+      case SceneKind::Churn:
+        for (auto& handle : mHandles)
+        {
+          mEngine->destroyActor(handle);
+          handle = this->spawn(ChurnImage, this->randomVelocity());
+        }
+        break;
+    }
+  }
+
+  void renderGame() override
+  {
+    Uint64 now{SDL_GetTicksNS()};
+    ++mFrame;
+
+    if (mFrame == WarmupFrames)
+    {
+      mAllocationsAtStart = Bench::getAllocationCount();
+      Bench::setAllocationCounting(true);
+    }
+    else if (mFrame > WarmupFrames)
+    {
+      mResult.frameTimes.push_back(now - mLastFrame);
+      mResult.drawCalls += mEngine->getRenderStats().drawCalls;
+      mResult.sprites += mEngine->getRenderStats().sprites;
+      mResult.culled += mEngine->getRenderStats().culled;
+      mResult.particles += mEngine->getRenderStats().particles;
+      mResult.tiles += mEngine->getRenderStats().tiles;
+    }
+    mLastFrame = now;
+
+    if (mFrame == WarmupFrames + mFrames)
+    {
+      Bench::setAllocationCounting(false);
+      mResult.allocations = Bench::getAllocationCount() - mAllocationsAtStart;
+      mEngine->quit();
+    }
+  }
+
+  const SceneResult& getResult() const
+  {
+    return mResult;
+  }
+
+private:
+  RipsawEngine::ActorHandle spawn(const std::string& image, const glm::vec2& vel)
+  {
+    RipsawEngine::Actor* actor{mEngine->createActor()};
+    actor->createTransformComponent(this->randomPosition(), vel);
+    actor->createSpriteComponent(image);
+    actor->getSpriteComponent()->setScale(0.25f);
+    return actor->getHandle();
+  }
+
+  glm::vec2 randomPosition()
+  {
+    std::uniform_real_distribution<float> x{0.f, ScreenW};
+    std::uniform_real_distribution<float> y{0.f, ScreenH};
+    return {x(mRng), y(mRng)};
+  }
+
+  glm::vec2 randomVelocity()
+  {
+    std::uniform_real_distribution<float> v{-200.f, 200.f};
+    return {v(mRng), v(mRng)};
+  }
+
+private:
+  SceneConfig mScene{};
+  std::size_t mFrames{};
+  std::size_t mFrame{};
+  Uint64 mLastFrame{};
+  std::size_t mAllocationsAtStart{};
+  SceneResult mResult{};
+  std::mt19937 mRng{42};
+  std::vector<RipsawEngine::Actor*> mActors{};
+  std::vector<RipsawEngine::ActorHandle> mHandles{};
+  RipsawEngine::BGManager* mBGManager{nullptr};
+  RipsawEngine::TilemapComponent* mTilemap{nullptr};
+  /// Result of the busy work, kept so it isn't optimized away.
+  float mSink{};
+};
+
+/// Returns percentile p of sorted frame times in milliseconds.
+double percentile(const std::vector<Uint64>& sorted, double p)
+{
+  std::size_t index{static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1))};
+  return static_cast<double>(sorted[index]) / 1e6;
+}
+
+bool runScene(const SceneConfig& scene, std::size_t frames, bool isFirst)
+{
+  BenchGame game{scene, frames};
+  {
+    RipsawEngine::Engine engine{&game, "bench2D", ScreenWidth, ScreenHeight};
+    engine.setHeadless(true);
+    engine.setVsync(false);
+    engine.setPipelined(scene.isPipelined);
+    if (engine.init() == false)
+    {
+      std::fprintf(stderr, "Failed to initialize engine for scene %s\n", scene.name);
+      return false;
+    }
+    engine.run();
+    engine.shutdown();
+  }
+
+  const SceneResult& result{game.getResult()};
+  std::vector<Uint64> sorted{result.frameTimes};
+  std::sort(sorted.begin(), sorted.end());
+  double total{};
+  for (Uint64 t : sorted)
+  {
+    total += static_cast<double>(t);
+  }
+  double n{static_cast<double>(sorted.size())};
+
+  std::printf("%s\n    {\"name\": \"%s\", \"count\": %zu, \"pipelined\": %s, \"frames\": %zu, ", isFirst ? "" : ",", scene.name, scene.count, scene.isPipelined ? "true" : "false", sorted.size());
+  std::printf("\"frame_ms\": {\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}, ", total / n / 1e6, percentile(sorted, 0.50), percentile(sorted, 0.95), percentile(sorted, 0.99), static_cast<double>(sorted.back()) / 1e6);
+  std::printf("\"allocations_per_frame\": %.2f, \"draw_calls\": %.2f, \"sprites\": %.2f, \"culled\": %.2f, \"particles\": %.2f, \"tiles\": %.2f}", static_cast<double>(result.allocations) / n, static_cast<double>(result.drawCalls) / n, static_cast<double>(result.sprites) / n, static_cast<double>(result.culled) / n, static_cast<double>(result.particles) / n, static_cast<double>(result.tiles) / n);
+  std::fflush(stdout);
+  return true;
+}
+
+}
+
+namespace Bench
+{
+
+int engine(std::size_t frames)
+{
+  const std::vector<SceneConfig> scenes
+  {
+    {"static_sprites", SceneKind::StaticSprites, 1000},
+    {"static_sprites", SceneKind::StaticSprites, 10000},
+    {"large_level", SceneKind::LargeLevel, 50000},
+    {"moving_spritesheets", SceneKind::MovingSpritesheets, 1000},
+    {"moving_spritesheets", SceneKind::MovingSpritesheets, 10000},
+    {"y_sorted", SceneKind::YSorted, 10000},
+    {"parallax", SceneKind::Parallax, 3},
+    {"parallax", SceneKind::Parallax, 8},
+    {"spawn_destroy", SceneKind::Churn, 1000},
+    {"heavy_simulation", SceneKind::HeavySimulation, 2000, false},
+    {"heavy_simulation", SceneKind::HeavySimulation, 2000, true},
+    {"particles", SceneKind::Particles, 200000},
+    {"tilemap", SceneKind::Tilemap, 1000},
+  };
+
+  std::printf("{\n  \"renderer\": \"software\",\n  \"simd\": \"%s\",\n  \"scenes\": [", RipsawEngine::Simd::getInstructionSet());
+  bool isFirst{true};
+  for (const auto& scene : scenes)
+  {
+    if (runScene(scene, frames, isFirst) == false)
+      return EXIT_FAILURE;
+    isFirst = false;
+  }
+  std::printf("\n  ]\n}\n");
+
+  return EXIT_SUCCESS;
+}
+
+}
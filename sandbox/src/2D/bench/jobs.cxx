@@ -0,0 +1,112 @@
+#include "Bench.hxx"
+#include "RipsawEngine/2D/Core/JobSystem.hxx"
+#include "RipsawEngine/2D/Core/Timer.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t Elements{1 << 22};
+constexpr std::size_t Repeats{10};
+constexpr std::size_t Tasks{100000};
+constexpr std::size_t MaxThreads{16};
+
+/// Per-element work heavy enough that the loop is compute bound rather than memory bound.
+float work(float x)
+{
+  float y{x};
+  for (int i{}; i < 8; ++i)
+  {
+    y = std::sqrt(y * y + 1.f) + std::sin(y) * 0.5f;
+  }
+  return y;
+}
+
+/// Runs the element loop on threads threads and returns milliseconds per pass.
+double runLoop(std::size_t threads, const std::vector<float>& in, std::vector<float>& out)
+{
+  RipsawEngine::JobSystem jobs{};
+  // Without start() everything runs on the calling thread, which is the serial baseline.
+  if (threads > 1)
+    jobs.start(threads - 1);
+
+  Timer timer{};
+  timer.start();
+  for (std::size_t r{}; r < Repeats; ++r)
+  {
+    jobs.parallelFor(in.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i{begin}; i < end; ++i)
+        {
+          out[i] = work(in[i]);
+        }
+    });
+  }
+  return static_cast<double>(timer.elapsedNS()) / 1e6 / static_cast<double>(Repeats);
+}
+
+/// Queues many tiny tasks and returns nanoseconds per task, the scheduling overhead.
+double runTasks(std::size_t threads)
+{
+  RipsawEngine::JobSystem jobs{};
+  if (threads > 1)
+    jobs.start(threads - 1);
+
+  std::vector<std::size_t> results(Tasks);
+  Timer timer{};
+  timer.start();
+  RipsawEngine::JobCounter counter{};
+  for (std::size_t i{}; i < Tasks; ++i)
+  {
+    jobs.run([&results, i]() {
+        results[i] = i * i;
+    }, counter);
+  }
+  jobs.wait(counter);
+  return static_cast<double>(timer.elapsedNS()) / static_cast<double>(Tasks);
+}
+
+}
+
+namespace Bench
+{
+
+int jobs()
+{
+  std::vector<float> in(Elements);
+  std::vector<float> out(Elements);
+  for (std::size_t i{}; i < Elements; ++i)
+  {
+    in[i] = static_cast<float>(i % 1000) * 0.01f;
+  }
+
+  std::size_t cores{std::max(std::thread::hardware_concurrency(), 1u)};
+  std::printf("Job system, parallelFor over %zu elements, %zu hardware threads\n", Elements, cores);
+  std::printf("%8s %12s %10s %14s\n", "threads", "pass(ms)", "speedup", "task(ns)");
+  double serialMS{};
+  for (std::size_t threads{1}; threads <= MaxThreads and threads <= cores; threads *= 2)
+  {
+    double loopMS{runLoop(threads, in, out)};
+    if (threads == 1)
+      serialMS = loopMS;
+    std::printf("%8zu %12.3f %9.2fx %14.1f\n", threads, loopMS, serialMS / loopMS, runTasks(threads));
+  }
+
+  // Keeps the compiler from dropping the loop.
+  double sum{};
+  for (float value : out)
+  {
+    sum += static_cast<double>(value);
+  }
+  std::printf("checksum %.3f\n", sum);
+
+  return EXIT_SUCCESS;
+}
+
+}
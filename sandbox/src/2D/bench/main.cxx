@@ -0,0 +1,62 @@
+#include "Bench.hxx"
+
+#include <SDL3/SDL.h>
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+
+void usage()
+{
+  SDL_Log("Usage: bench2D <benchmark>");
+  SDL_Log("Benchmarks:");
+  SDL_Log("\ttransform\tTransform integration at 1k/10k/100k/1M actors");
+  SDL_Log("\tpool\t\tSpawn/despawn throughput at 100k objects");
+  SDL_Log("\tspatial\t\tSpatial hash update and queries at 50k moving bodies");
+  SDL_Log("\tjobs\t\tJob system parallel loop scaling and task overhead");
+  SDL_Log("\tengine [frames]\tHeadless engine loop over benchmark scenes, JSON output");
+}
+
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  std::string name{argv[1]};
+  if (name == "transform")
+  {
+    return Bench::transform();
+  }
+  if (name == "pool")
+  {
+    return Bench::pool();
+  }
+  if (name == "spatial")
+  {
+    return Bench::spatial();
+  }
+  if (name == "jobs")
+  {
+    return Bench::jobs();
+  }
+  if (name == "engine")
+  {
+    std::size_t frames{argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 300};
+    if (frames == 0)
+    {
+      usage();
+      return EXIT_FAILURE;
+    }
+    return Bench::engine(frames);
+  }
+
+  usage();
+  return EXIT_FAILURE;
+}
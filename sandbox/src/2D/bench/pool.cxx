@@ -0,0 +1,102 @@
+#include "Bench.hxx"
+#include "RipsawEngine/2D/Core/Pool.hxx"
+#include "RipsawEngine/2D/Core/Timer.hxx"
+#include "RipsawEngine/2D/Scene/Actor.hxx"
+#include "RipsawEngine/2D/Scene/SpriteComponent.hxx"
+#include "RipsawEngine/2D/Scene/SpritesheetComponent.hxx"
+#include "RipsawEngine/2D/Scene/TransformComponent.hxx"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+/// Stand-in with the size and alignment of an engine class, so the allocators can be measured without an engine instance.
+template<std::size_t Size, std::size_t Align>
+struct alignas(Align) Blob
+{
+  std::byte bytes[Size];
+};
+
+constexpr std::size_t Count{100000};
+constexpr std::size_t Rounds{20};
+
+/// Spawns and despawns Count objects per round, despawning in random order the way actors die in a game, and returns objects per second.
+template<typename Alloc, typename Free>
+double measure(Alloc&& alloc, Free&& free)
+{
+  std::vector<void*> objects(Count);
+  std::vector<std::size_t> order(Count);
+  for (std::size_t i{}; i < Count; ++i)
+  {
+    order[i] = i;
+  }
+  std::mt19937 rng{42};
+
+  Uint64 total{};
+  for (std::size_t round{}; round <= Rounds; ++round)
+  {
+    std::shuffle(order.begin(), order.end(), rng);
+
+    Timer timer{};
+    timer.start();
+    for (std::size_t i{}; i < Count; ++i)
+    {
+      objects[i] = alloc();
+    }
+    for (std::size_t i : order)
+    {
+      free(objects[i]);
+    }
+    // First round only warms up the allocator.
+    if (round > 0)
+      total += timer.elapsedNS();
+  }
+
+  return static_cast<double>(Count * Rounds) / (static_cast<double>(total) / 1e9);
+}
+
+template<typename T>
+void run(const char* name)
+{
+  using Object = Blob<sizeof(T), alignof(T)>;
+
+  double heap{measure(
+    []() -> void* { return new Object; },
+    [](void* ptr) { delete static_cast<Object*>(ptr); }
+  )};
+
+  RipsawEngine::Pool<Object> pool{};
+  double pooled{measure(
+    [&]() -> void* { return pool.allocate(); },
+    [&](void* ptr) { pool.deallocate(ptr); }
+  )};
+
+  const RipsawEngine::PoolStats& stats{pool.getStats()};
+  std::printf("%22s %8zu %14.2f %14.2f %9.1fx %8zu\n", name, sizeof(T), heap / 1e6, pooled / 1e6, pooled / heap, stats.slabs);
+}
+
+}
+
+namespace Bench
+{
+
+int pool()
+{
+  std::printf("Spawn + despawn of %zu objects, %zu rounds\n", Count, Rounds);
+  std::printf("%22s %8s %14s %14s %10s %8s\n", "type", "bytes", "heap(M/s)", "pool(M/s)", "speedup", "slabs");
+
+  run<RipsawEngine::Actor>("Actor");
+  run<RipsawEngine::TransformComponent>("TransformComponent");
+  run<RipsawEngine::SpriteComponent>("SpriteComponent");
+  run<RipsawEngine::SpritesheetComponent>("SpritesheetComponent");
+
+  return EXIT_SUCCESS;
+}
+
+}
@@ -0,0 +1,172 @@
+#include "Bench.hxx"
+#include "RipsawEngine/2D/Core/Timer.hxx"
+#include "RipsawEngine/2D/Systems/SpatialHash.hxx"
+#include "RipsawEngine/2D/Systems/TransformSystem.hxx"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+constexpr std::size_t Bodies{50000};
+constexpr std::size_t Frames{120};
+constexpr float WorldSize{8000.f};
+constexpr float BodySize{16.f};
+constexpr float CellSize{64.f};
+constexpr float Dt{1.f / 60.f};
+
+/// Returns bounding box of a body at pos.
+RipsawEngine::Aabb boundsAt(const glm::vec2& pos)
+{
+  return {pos - glm::vec2{BodySize / 2.f}, pos + glm::vec2{BodySize / 2.f}};
+}
+
+/// Runs fn repeatedly and returns nanoseconds per iteration.
+template<typename Fn>
+double measure(std::size_t iterations, Fn&& fn)
+{
+  Timer timer{};
+  timer.start();
+  for (std::size_t i{}; i < iterations; ++i)
+  {
+    fn();
+  }
+  return static_cast<double>(timer.elapsedNS()) / static_cast<double>(iterations);
+}
+
+/// Compares incremental spatial hash maintenance against a full rebuild with the given share of bodies moving.
+void runMoving(double movingShare)
+{
+  std::mt19937 rng{7};
+  std::uniform_real_distribution<float> position{0.f, WorldSize};
+  std::uniform_real_distribution<float> velocity{-120.f, 120.f};
+  std::uniform_real_distribution<double> chance{0.0, 1.0};
+
+  RipsawEngine::TransformSystem system{};
+  RipsawEngine::SpatialHash hash{CellSize};
+  system.setSpatialHash(&hash);
+  system.reserve(Bodies);
+  std::vector<RipsawEngine::Handle> handles{};
+  handles.reserve(Bodies);
+  for (std::size_t i{}; i < Bodies; ++i)
+  {
+    glm::vec2 vel{chance(rng) < movingShare ? glm::vec2{velocity(rng), velocity(rng)} : glm::vec2{}};
+    RipsawEngine::Handle handle{system.create({position(rng), position(rng)}, vel)};
+    system.setBounds(handle, {BodySize, BodySize}, handle);
+    handles.push_back(handle);
+  }
+
+  hash.resetStats();
+  double incrementalNS{measure(Frames, [&]() {
+    system.integrate(Dt);
+    system.syncSpatialHash();
+  })};
+  RipsawEngine::SpatialHashStats stats{hash.getStats()};
+
+  RipsawEngine::SpatialHash rebuilt{CellSize};
+  double rebuildNS{measure(Frames, [&]() {
+    system.integrate(Dt);
+    rebuilt.clear();
+    for (auto handle : handles)
+    {
+      rebuilt.insert(boundsAt(system.getPosition(handle)), handle);
+    }
+  })};
+
+  std::printf("%8.0f%% %14.3f %14.3f %9.1fx %12.1f%%\n",
+      movingShare * 100.0,
+      incrementalNS / 1e6,
+      rebuildNS / 1e6,
+      rebuildNS / incrementalNS,
+      stats.rebinned + stats.moved == 0 ? 0.0 : 100.0 * static_cast<double>(stats.rebinned) / static_cast<double>(stats.rebinned + stats.moved));
+}
+
+/// Times queries against a spatial hash of every body.
+void runQueries()
+{
+  std::mt19937 rng{11};
+  std::uniform_real_distribution<float> position{0.f, WorldSize};
+  std::uniform_real_distribution<float> direction{-1.f, 1.f};
+
+  RipsawEngine::SpatialHash hash{CellSize};
+  std::vector<glm::vec2> positions{};
+  for (std::uint32_t i{}; i < Bodies; ++i)
+  {
+    glm::vec2 pos{position(rng), position(rng)};
+    positions.push_back(pos);
+    hash.insert(boundsAt(pos), {i, 0});
+  }
+
+  constexpr std::size_t Queries{1000};
+  std::vector<glm::vec2> centers{};
+  std::vector<glm::vec2> directions{};
+  for (std::size_t i{}; i < Queries; ++i)
+  {
+    centers.push_back({position(rng), position(rng)});
+    directions.push_back({direction(rng), direction(rng)});
+  }
+
+  std::vector<RipsawEngine::Handle> found{};
+  std::size_t rectHits{};
+  double rectNS{measure(Queries, [&, i = 0uz]() mutable {
+    found.clear();
+    glm::vec2 center{centers[i++ % Queries]};
+    hash.queryRect({center - glm::vec2{640.f, 360.f}, center + glm::vec2{640.f, 360.f}}, found);
+    rectHits += found.size();
+  })};
+
+  std::size_t radiusHits{};
+  double radiusNS{measure(Queries, [&, i = 0uz]() mutable {
+    found.clear();
+    hash.queryRadius(centers[i++ % Queries], 200.f, found);
+    radiusHits += found.size();
+  })};
+
+  std::size_t rayHits{};
+  double rayNS{measure(Queries, [&, i = 0uz]() mutable {
+    RipsawEngine::RayHit hit{};
+    if (hash.raycast(centers[i % Queries], directions[i % Queries], 2000.f, hit))
+      ++rayHits;
+    ++i;
+  })};
+
+  std::vector<std::pair<RipsawEngine::Handle, RipsawEngine::Handle>> pairs{};
+  double pairsNS{measure(10, [&]() {
+    pairs.clear();
+    hash.queryPairs(pairs);
+  })};
+
+  std::printf("%-22s %12.2f us %10.1f results\n", "rect 1280x720", rectNS / 1e3, static_cast<double>(rectHits) / Queries);
+  std::printf("%-22s %12.2f us %10.1f results\n", "radius 200", radiusNS / 1e3, static_cast<double>(radiusHits) / Queries);
+  std::printf("%-22s %12.2f us %10.1f%% hit\n", "raycast 2000", rayNS / 1e3, 100.0 * static_cast<double>(rayHits) / Queries);
+  std::printf("%-22s %12.2f us %10zu pairs\n", "pairs (broad phase)", pairsNS / 1e3, pairs.size());
+}
+
+}
+
+namespace Bench
+{
+
+int spatial()
+{
+  std::printf("Spatial hash, %zu bodies of %.0fx%.0f in a %.0fx%.0f world, cell size %.0f\n", Bodies, static_cast<double>(BodySize), static_cast<double>(BodySize), static_cast<double>(WorldSize), static_cast<double>(WorldSize), static_cast<double>(CellSize));
+  std::printf("%9s %14s %14s %10s %13s\n", "moving", "update(ms)", "rebuild(ms)", "speedup", "rebinned");
+  for (double share : {0.1, 0.5, 1.0})
+  {
+    runMoving(share);
+  }
+
+  std::printf("\n");
+  runQueries();
+
+  return EXIT_SUCCESS;
+}
+
+}
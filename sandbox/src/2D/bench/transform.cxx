@@ -0,0 +1,114 @@
+#include "Bench.hxx"
+#include "RipsawEngine/2D/Core/Simd.hxx"
+#include "RipsawEngine/2D/Core/Timer.hxx"
+#include "RipsawEngine/2D/Systems/TransformSystem.hxx"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+/// Mirror of the old per-component path: one heap object per transform, updated through a virtual call.
+class LegacyComponent
+{
+public:
+  virtual ~LegacyComponent() = default;
+  virtual void update(double dt) = 0;
+};
+
+class LegacyTransform : public LegacyComponent
+{
+public:
+  LegacyTransform(const glm::vec2& pos, const glm::vec2& vel)
+    : mPos{pos},
+      mVel{vel}
+  {}
+
+  void update(double dt) override
+  {
+    mPos.x += mVel.x * static_cast<float>(dt);
+    mPos.y += mVel.y * static_cast<float>(dt);
+  }
+
+private:
+  glm::vec2 mPos{};
+  glm::vec2 mVel{};
+};
+
+constexpr double Dt{1.0 / 60.0};
+
+/// Runs fn repeatedly and returns nanoseconds per iteration.
+template<typename Fn>
+double measure(std::size_t iterations, Fn&& fn)
+{
+  // Warm up caches and branch predictors once.
+  fn();
+
+  Timer timer{};
+  timer.start();
+  for (std::size_t i{}; i < iterations; ++i)
+  {
+    fn();
+  }
+  return static_cast<double>(timer.elapsedNS()) / static_cast<double>(iterations);
+}
+
+glm::vec2 randomVec()
+{
+  return {static_cast<float>(std::rand() % 2000) - 1000.f, static_cast<float>(std::rand() % 2000) - 1000.f};
+}
+
+}
+
+namespace Bench
+{
+
+int transform()
+{
+  std::printf("Transform integration, SIMD path: %s\n", RipsawEngine::Simd::getInstructionSet());
+  std::printf("%10s %14s %14s %14s %10s\n", "actors", "virtual(ns)", "scalar(ns)", "simd(ns)", "speedup");
+
+  for (std::size_t count : {1000uz, 10000uz, 100000uz, 1000000uz})
+  {
+    std::size_t iterations{count >= 1000000 ? 20uz : 2000000uz / count};
+
+    // Interleave other allocations the way actors and their components used to be, so the legacy objects end up scattered over the heap.
+    std::vector<std::unique_ptr<LegacyComponent>> legacy{};
+    std::vector<std::unique_ptr<char[]>> padding{};
+    legacy.reserve(count);
+    padding.reserve(count);
+
+    RipsawEngine::TransformSystem system{};
+    system.reserve(count);
+
+    for (std::size_t i{}; i < count; ++i)
+    {
+      glm::vec2 pos{randomVec()};
+      glm::vec2 vel{randomVec()};
+      padding.emplace_back(std::make_unique<char[]>(96 + static_cast<std::size_t>(std::rand() % 64)));
+      legacy.emplace_back(std::make_unique<LegacyTransform>(pos, vel));
+      system.create(pos, vel);
+    }
+
+    double virtualNS{measure(iterations, [&]() {
+      for (const auto& comp : legacy)
+      {
+        comp->update(Dt);
+      }
+    })};
+    double scalarNS{measure(iterations, [&]() { system.integrateScalar(static_cast<float>(Dt)); })};
+    double simdNS{measure(iterations, [&]() { system.integrate(static_cast<float>(Dt)); })};
+
+    std::printf("%10zu %14.0f %14.0f %14.0f %9.1fx\n", count, virtualNS, scalarNS, simdNS, virtualNS / simdNS);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+}
@@ -47,6 +47,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char** argv)
   Sandbox sandbox;
   RipsawEngine::Engine engine{&sandbox};
   engine.setRendererBackend("opengl");
+  engine.setFixedTimestep(true, 60.0);
 
   if (engine.init() == false)
   {